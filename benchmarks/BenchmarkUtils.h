@@ -0,0 +1,102 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "env/Environment.h"
+#include "env/Force.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace md::bench {
+    constexpr double SIGMA = 1.0;           ///< Lennard-Jones sigma of all benchmark particles.
+    constexpr double EPSILON = 5.0;         ///< Lennard-Jones epsilon of all benchmark particles.
+    constexpr double CUTOFF = 2.5 * SIGMA;  ///< Cutoff radius, also used as grid constant.
+
+    /**
+     * @brief Sets the number of OpenMP threads used by the benchmarked code. Has no effect without OpenMP.
+     * @param threads The number of threads.
+     */
+    inline void set_threads(const int64_t threads) {
+#ifdef _OPENMP
+        omp_set_num_threads(static_cast<int>(threads));
+#else
+        (void)threads;
+#endif
+    }
+
+    /**
+     * @brief Builds an environment with particles on a jittered cubic lattice.
+     * @param environment The environment to fill, must not be built yet.
+     * @param n_particles The number of particles.
+     * @param density Number of particles per unit volume.
+     * @param rule The boundary rule of all faces.
+     * @param build_blocks Build the blocks required by the spatial decomposition strategy.
+     */
+    inline void build_lattice(env::Environment& environment, const int64_t n_particles, const double density,
+                              const env::BoundaryRule rule = env::BoundaryRule::PERIODIC,
+                              const bool build_blocks = false) {
+        const double side = std::cbrt(static_cast<double>(n_particles) / density);
+        const auto per_axis = static_cast<int64_t>(std::ceil(std::cbrt(static_cast<double>(n_particles))));
+        const double spacing = side / static_cast<double>(per_axis);
+
+        env::Boundary boundary;
+        boundary.extent = {side, side, side};
+        boundary.origin = {0, 0, 0};
+        boundary.set_boundary_rule(rule);
+        if (rule == env::BoundaryRule::REPULSIVE_FORCE) {
+            boundary.set_boundary_force(env::Boundary::LennardJonesForce(EPSILON, SIGMA));
+        }
+        environment.set_boundary(boundary);
+
+        std::mt19937 rng(42);  // NOLINT(*-msc51-cpp), fixed seed for reproducible runs
+        std::uniform_real_distribution jitter(-0.1 * spacing, 0.1 * spacing);
+        std::normal_distribution velocity(0.0, 0.5);
+
+        for (int64_t i = 0; i < n_particles; ++i) {
+            const int64_t x = i % per_axis;
+            const int64_t y = i / per_axis % per_axis;
+            const int64_t z = i / (per_axis * per_axis);
+            const vec3 position = {(static_cast<double>(x) + 0.5) * spacing + jitter(rng),
+                                   (static_cast<double>(y) + 0.5) * spacing + jitter(rng),
+                                   (static_cast<double>(z) + 0.5) * spacing + jitter(rng)};
+            environment.add_particle(position, {velocity(rng), velocity(rng), velocity(rng)}, 1.0, 0);
+        }
+
+        environment.set_grid_constant(CUTOFF);
+        environment.set_force(env::LennardJones(EPSILON, SIGMA, CUTOFF), 0);
+        environment.build(build_blocks);
+    }
+
+    /**
+     * @brief Returns the thread counts the benchmarks are run with, only a single thread without OpenMP.
+     * @return The thread counts.
+     */
+    inline std::vector<int64_t> thread_counts() {
+#ifdef _OPENMP
+        return {1, 2, 4, 8};
+#else
+        return {1};
+#endif
+    }
+
+    /**
+     * @brief Adds the particle count and the thread count as arguments to a benchmark.
+     * @param benchmark The benchmark.
+     */
+    inline void particles_and_threads(benchmark::internal::Benchmark* benchmark) {
+        benchmark->ArgNames({"particles", "threads"});
+        for (const int64_t particles : {1000, 8000, 27000, 64000}) {
+            for (const int64_t threads : thread_counts()) {
+                benchmark->Args({particles, threads});
+            }
+        }
+        benchmark->UseRealTime();
+    }
+}  // namespace md::bench
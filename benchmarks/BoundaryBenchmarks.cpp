@@ -0,0 +1,22 @@
+#include <benchmark/benchmark.h>
+
+#include "BenchmarkUtils.h"
+
+using namespace md;
+
+// Boundary pass over the boundary cells and the particles outside the domain, as done once per step. The boundary
+// conditions are applied sequentially, hence the benchmark is parameterized over the particle count and the rule.
+static void BM_ApplyBoundary(benchmark::State& state) {
+    env::Environment environment;
+    bench::build_lattice(environment, state.range(0), 0.8, static_cast<env::BoundaryRule>(state.range(1)));
+
+    for (auto _ : state) {
+        environment.apply_boundary();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ApplyBoundary)
+    ->ArgNames({"particles", "rule"})
+    ->ArgsProduct({{1000, 8000, 64000},
+                   {env::BoundaryRule::PERIODIC, env::BoundaryRule::REPULSIVE_FORCE,
+                    env::BoundaryRule::VELOCITY_REFLECTION}});
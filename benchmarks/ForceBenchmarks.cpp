@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+
+using namespace md;
+
+namespace {
+    /**
+     * @brief Creates random distance vectors, most of them within the cutoff radius.
+     */
+    std::vector<vec3> random_distances(const int64_t n) {
+        std::mt19937 rng(7);  // NOLINT(*-msc51-cpp)
+        std::uniform_real_distribution component(-bench::CUTOFF / 1.5, bench::CUTOFF / 1.5);
+        std::vector<vec3> distances(n);
+        for (auto& diff : distances) {
+            diff = {component(rng), component(rng), component(rng)};
+        }
+        return distances;
+    }
+}  // namespace
+
+// Lennard-Jones kernel evaluated on precomputed distance vectors
+static void BM_LennardJonesForce(benchmark::State& state) {
+    bench::set_threads(state.range(1));
+    const auto distances = random_distances(state.range(0));
+    const env::Force force = env::LennardJonesForce(bench::EPSILON, bench::SIGMA, bench::CUTOFF);
+
+    env::Environment environment;
+    bench::build_lattice(environment, 2, 1.0);
+    const env::Particle& p1 = environment[0];
+    const env::Particle& p2 = environment[1];
+
+    for (auto _ : state) {
+        double sum = 0;
+#pragma omp parallel for reduction(+ : sum)
+        for (size_t i = 0; i < distances.size(); ++i) {
+            sum += force(distances[i], p1, p2)[0];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LennardJonesForce)->Apply(bench::particles_and_threads);
+
+// Force lookup by particle types and evaluation, with two types mixed by the Lorentz-Berthelot rule
+static void BM_ForceManagerEvaluate(benchmark::State& state) {
+    bench::set_threads(state.range(1));
+    const auto distances = random_distances(state.range(0));
+
+    env::Environment environment;
+    bench::build_lattice(environment, 2, 1.0);
+    env::Particle p1 = environment[0];
+    env::Particle p2 = environment[1];
+    p2.type = 1;
+
+    env::ForceManager forces;
+    forces.add_force(env::LennardJones(bench::EPSILON, bench::SIGMA, bench::CUTOFF), 0);
+    forces.add_force(env::LennardJones(2 * bench::EPSILON, 1.2 * bench::SIGMA, bench::CUTOFF), 1);
+    forces.init();
+
+    for (auto _ : state) {
+        double sum = 0;
+#pragma omp parallel for reduction(+ : sum)
+        for (size_t i = 0; i < distances.size(); ++i) {
+            sum += forces.evaluate(distances[i], p1, i % 2 ? p2 : p1)[0];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ForceManagerEvaluate)->Apply(bench::particles_and_threads);
@@ -0,0 +1,110 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+
+using namespace md;
+
+// Mapping of positions to cell indices
+static void BM_WhatCell(benchmark::State& state) {
+    bench::set_threads(state.range(1));
+    const double side = std::cbrt(static_cast<double>(state.range(0)));
+
+    env::Boundary boundary;
+    boundary.extent = {side, side, side};
+    boundary.origin = {0, 0, 0};
+    std::vector<env::Particle> no_particles;
+    env::ParticleGrid grid;
+    grid.build(boundary, bench::CUTOFF, no_particles);
+
+    std::mt19937 rng(3);  // NOLINT(*-msc51-cpp)
+    std::uniform_real_distribution component(0.0, side);
+    std::vector<vec3> positions(state.range(0));
+    for (auto& position : positions) {
+        position = {component(rng), component(rng), component(rng)};
+    }
+
+    for (auto _ : state) {
+        INT_T sum = 0;
+#pragma omp parallel for reduction(+ : sum)
+        for (size_t i = 0; i < positions.size(); ++i) {
+            sum += grid.what_cell(positions[i])[0];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_WhatCell)->Apply(bench::particles_and_threads);
+
+// Cell migration of all particles after a small displacement, alternating back and forth. The grid update is not
+// thread safe, hence the benchmark is only parameterized over the particle count.
+static void BM_UpdateCells(benchmark::State& state) {
+    env::Environment environment;
+    bench::build_lattice(environment, state.range(0), 0.8);
+
+    std::mt19937 rng(5);  // NOLINT(*-msc51-cpp)
+    std::uniform_real_distribution component(-0.25, 0.25);
+    std::vector<vec3> displacements(state.range(0));
+    for (auto& dx : displacements) {
+        dx = {component(rng), component(rng), component(rng)};
+    }
+
+    double direction = 1;
+    for (auto _ : state) {
+        for (auto& p : environment.particles()) {
+            p.update_position(direction * displacements[p.id]);
+            p.update_grid();
+        }
+        direction = -direction;
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_UpdateCells)->ArgName("particles")->RangeMultiplier(8)->Range(1000, 64000);
+
+// Pair force computation over all linked cells as done by the cell lock strategy, at varying densities
+static void BM_CellPairTraversal(benchmark::State& state) {
+    bench::set_threads(state.range(2));
+    env::Environment environment;
+    bench::build_lattice(environment, state.range(0), static_cast<double>(state.range(1)) / 100.0);
+
+    size_t pairs = 0;
+    for (auto _ : state) {
+        const auto& linked_cells = environment.linked_cells();
+#pragma omp parallel for reduction(+ : pairs)
+        for (size_t i = 0; i < linked_cells.size(); ++i) {
+            auto& cell_pair = linked_cells[i];
+            cell_pair.cell1.lock_cell();
+            if (cell_pair.cell1.id == cell_pair.cell2.id) {
+                auto& particles = cell_pair.cell1.particles;
+                for (auto it1 = particles.begin(); it1 != particles.end(); ++it1) {
+                    for (auto it2 = std::next(it1); it2 != particles.end(); ++it2) {
+                        const vec3 new_F = environment.force(**it1, **it2, cell_pair);
+                        (*it2)->force = (*it2)->force + new_F;
+                        (*it1)->force = (*it1)->force - new_F;
+                        pairs++;
+                    }
+                }
+            } else {
+                cell_pair.cell2.lock_cell();
+                for (auto* p1 : cell_pair.cell1.particles) {
+                    for (auto* p2 : cell_pair.cell2.particles) {
+                        const vec3 new_F = environment.force(*p1, *p2, cell_pair);
+                        p2->force = p2->force + new_F;
+                        p1->force = p1->force - new_F;
+                        pairs++;
+                    }
+                }
+                cell_pair.cell2.unlock_cell();
+            }
+            cell_pair.cell1.unlock_cell();
+        }
+    }
+    state.counters["pairs/s"] = benchmark::Counter(static_cast<double>(pairs), benchmark::Counter::kIsRate);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CellPairTraversal)
+    ->ArgNames({"particles", "density%", "threads"})
+    ->ArgsProduct({{8000, 27000, 64000}, {20, 50, 80}, bench::thread_counts()})
+    ->UseRealTime();
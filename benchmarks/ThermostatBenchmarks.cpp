@@ -0,0 +1,35 @@
+#include <benchmark/benchmark.h>
+
+#include "BenchmarkUtils.h"
+#include "effects/Thermostat.h"
+
+using namespace md;
+
+// Reductions over all particles used by the thermostat
+static void BM_Temperature(benchmark::State& state) {
+    env::Environment environment;
+    bench::build_lattice(environment, state.range(0), 0.8);
+
+    for (auto _ : state) {
+        const vec3 avg_velocity = environment.average_velocity();
+        benchmark::DoNotOptimize(environment.temperature(avg_velocity));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Temperature)->ArgName("particles")->RangeMultiplier(8)->Range(1000, 64000);
+
+// Full temperature adjustment, alternating between two target temperatures so that every call rescales
+static void BM_AdjustTemperature(benchmark::State& state) {
+    env::Environment environment;
+    bench::build_lattice(environment, state.range(0), 0.8);
+    const env::Thermostat heat(env::Thermostat::NO_TEMP, 2.0, 0.1);
+    const env::Thermostat cool(env::Thermostat::NO_TEMP, 0.1, 0.1);
+
+    bool heating = true;
+    for (auto _ : state) {
+        (heating ? heat : cool).adjust_temperature(environment);
+        heating = !heating;
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AdjustTemperature)->ArgName("particles")->RangeMultiplier(8)->Range(1000, 64000);
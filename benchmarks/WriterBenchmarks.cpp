@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include "BenchmarkUtils.h"
+#include "core/Statistics.h"
+#include "io/IOStrategy.h"
+
+using namespace md;
+
+namespace {
+    /**
+     * @brief Moves all particles a little, so that consecutive frames differ as in a real simulation.
+     */
+    void advance(env::Environment& environment) {
+        for (auto& p : environment.particles()) {
+            p.update_position(1e-3 * p.velocity);
+        }
+    }
+}  // namespace
+
+// One frame of each output format. Output is written to the output folder of the working directory, which is
+// cleared before.
+static void BM_PlotParticles(benchmark::State& state) {
+    env::Environment environment;
+    bench::build_lattice(environment, state.range(0), 0.8);
+    const auto format = static_cast<io::OutputFormat>(state.range(1));
+    const auto writer = io::create_writer("benchmark", format, true);
+    state.SetLabel(io::output_format_name(format));
+
+    int iteration = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        advance(environment);
+        state.ResumeTiming();
+        writer->plot_particles(environment, format == io::OutputFormat::XYZ ? 0 : iteration++);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PlotParticles)
+    ->ArgNames({"particles", "format"})
+    ->ArgsProduct({{1000, 8000, 64000},
+                   {static_cast<int64_t>(io::OutputFormat::VTK), static_cast<int64_t>(io::OutputFormat::XYZ),
+                    static_cast<int64_t>(io::OutputFormat::XYZ_MULTI), static_cast<int64_t>(io::OutputFormat::TRJ)}})
+    ->Unit(benchmark::kMillisecond);
+
+// Checkpoint of the whole simulation state
+static void BM_WriteCheckpoint(benchmark::State& state) {
+    env::Environment environment;
+    bench::build_lattice(environment, state.range(0), 0.8);
+    io::CheckpointWriter writer("benchmark");
+
+    for (auto _ : state) {
+        writer.write_checkpoint_file(environment, 0);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_WriteCheckpoint)->ArgName("particles")->RangeMultiplier(8)->Range(1000, 64000)->Unit(benchmark::kMillisecond);
+
+// Computation of the nano-scale flow statistics and the CSV output
+static void BM_NanoFlowStatistics(benchmark::State& state) {
+    env::Environment environment;
+    bench::build_lattice(environment, state.range(0), 0.8);
+    core::NanoFlowStatistics statistics(1, 50, "benchmark_statistics.csv");
+
+    double time = 0;
+    for (auto _ : state) {
+        statistics.compute(environment, time++);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_NanoFlowStatistics)->ArgName("particles")->RangeMultiplier(8)->Range(1000, 64000);
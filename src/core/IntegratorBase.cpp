@@ -1,8 +1,10 @@
 #include <chrono>
+#include <cmath>
 #include <iomanip>
 #include <iostream>
 
 #include "IntegratorBase.h"
+#include "utils/ArrayUtils.h"
 #include "io/Logger/Logger.h"
 
 #if SPDLOG_ACTIVE_LEVEL == SPDLOG_LEVEL_INFO
@@ -58,6 +60,7 @@ namespace md::Integrator {
  void IntegratorBase::simulate(const double start_time, const double end_time, const double dt,
                                     const unsigned int write_freq, const unsigned int temp_adj_freq) {
         temp_adjust_freq = temp_adj_freq;
+        begin_live_metrics(start_time, end_time, dt);
         int step = 0;
         const int total_steps = static_cast<int>((end_time - start_time) / dt);
         if(stats){
@@ -65,12 +68,15 @@ namespace md::Integrator {
             simulation_step(step, dt);
 
             if (step % stats->compute_freq == 0) {
+                TRACE_SCOPE("statistics");
                 stats->compute(env,t);
             }
 
             if (writer && step % write_freq == 0) {
                 SPDLOG_DEBUG("Plotting particles @ iteration {}, time {}", step, t);
+                TRACE_SCOPE("write_output");
                 writer->plot_particles(env, step);
+                env.log_memory_usage(fmt::format("at output step {}", step));
             }
             SHOW_PROGRESS(step, total_steps);
         }
@@ -80,38 +86,383 @@ namespace md::Integrator {
 
             if (writer && step % write_freq == 0) {
                 SPDLOG_DEBUG("Plotting particles @ iteration {}, time {}", step, t);
+                TRACE_SCOPE("write_output");
                 writer->plot_particles(env, step);
+                env.log_memory_usage(fmt::format("at output step {}", step));
             }
             SHOW_PROGRESS(step, total_steps);
         }
         }
 
+        publish_live_metrics(step, true);
+
         if (checkpoint_writer) {
+            TRACE_SCOPE("write_checkpoint");
             checkpoint_writer->write_checkpoint_file(env, 1);
         }
         SPDLOG_INFO("Simulation ended");
     }
 
-    void IntegratorBase::benchmark(const double start_time, const double end_time, const double dt, const unsigned int temp_adj_freq) {
+    void IntegratorBase::benchmark(const double start_time, const double end_time, const double dt,
+                                   const unsigned int temp_adj_freq, const unsigned int warmup_steps,
+                                   const std::string& report, const bool hardware_counters) {
+        core::StepProfiler step_profiler(warmup_steps);
+        if (hardware_counters && !step_profiler.enable_counters()) {
+            std::cerr << "Hardware counters are not available, continuing without them" << std::endl;
+        }
+        profiled_run(start_time, end_time, dt, temp_adj_freq, step_profiler);
+
+        std::cout << "Number of particles: " << env.size(env::Particle::STATIONARY | env::Particle::ALIVE) << std::endl;
+        step_profiler.print();
+
+        if (!report.empty()) {
+            step_profiler.write_json(report + ".json");
+            step_profiler.write_csv(report + ".csv");
+            step_profiler.write_counters_csv(report + "_counters.csv");
+            step_profiler.write_pairs_csv(report + "_pairs.csv");
+            std::cout << "Benchmark report written to " << report << ".json and " << report << ".csv" << std::endl;
+        }
+
+        if (load_monitor) {
+            std::cout << "Load of the last window: " << load_monitor->summary() << std::endl;
+            if (!report.empty()) load_monitor->write_csv(report + "_threads.csv");
+        }
+    }
+
+    double IntegratorBase::timed_run(const double start_time, const double end_time, const double dt,
+                                     const unsigned int temp_adj_freq) {
         temp_adjust_freq = temp_adj_freq;
+        begin_live_metrics(start_time, end_time, dt);
 
-        unsigned long long total_micros = 0;
-        size_t modifications = 0;
         int step = 0;
+        const auto start = std::chrono::steady_clock::now();
         for (double t = start_time; t < end_time; t += dt, step++) {
-            modifications += env.size(env::Particle::ALIVE);
-            auto start = std::chrono::high_resolution_clock::now();
             simulation_step(step, dt);
-            auto end = std::chrono::high_resolution_clock::now();
-            total_micros += std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
         }
-        const double avg_step_time = static_cast<double>(total_micros) / static_cast<double>(step+1);
+        const auto end = std::chrono::steady_clock::now();
+        publish_live_metrics(step, true);
+        return std::chrono::duration<double>(end - start).count();
+    }
 
-        // Using std::cout instead of logging, as logging should be disabled during benchmarking.
-        std::cout << "Total execution time: " << total_micros/1000.0 << " ms" << std::endl;
-        std::cout << "Average execution time per step: " << avg_step_time/1000.0 << " ms" << std::endl;
-        std::cout << "Number of particles: " << env.size(env::Particle::STATIONARY | env::Particle::ALIVE) << std::endl;
-        std::cout << "Particle modifications: " << modifications << std::endl;
-        std::cout << "MUPS/s: " << modifications/(total_micros/1000/1000) << std::endl;
+    void IntegratorBase::profiled_run(const double start_time, const double end_time, const double dt,
+                                      const unsigned int temp_adj_freq, core::StepProfiler& step_profiler) {
+        temp_adjust_freq = temp_adj_freq;
+        profiler = &step_profiler;
+        begin_live_metrics(start_time, end_time, dt);
+
+        int step = 0;
+        for (double t = start_time; t < end_time; t += dt, step++) {
+            const size_t updates = env.size(env::Particle::ALIVE);
+            const auto start = core::StepProfiler::clock::now();
+            simulation_step(step, dt);
+            const auto end = core::StepProfiler::clock::now();
+            step_profiler.end_step(end - start, updates, count_pair_candidates());
+        }
+        profiler = nullptr;
+        publish_live_metrics(step, true);
+    }
+
+    void IntegratorBase::monitor_load(const unsigned int report_freq) {
+        load_monitor = std::make_unique<core::LoadMonitor>();
+        load_report_freq = report_freq;
+    }
+
+    void IntegratorBase::compact_storage(const unsigned int freq, const bool cell_order) {
+        compact_freq = freq;
+        compact_cell_order = cell_order;
+    }
+
+    void IntegratorBase::add_inflow(const env::InflowSource& source) {
+        inflow_sources.push_back(source);
+    }
+
+    void IntegratorBase::multiple_time_step(const unsigned int substeps) {
+        respa_substeps = std::max(1u, substeps);
+    }
+
+    void IntegratorBase::direct_sum(const bool parallel) {
+        use_direct_sum = true;
+        direct_sum_parallel = parallel;
+    }
+
+    bool IntegratorBase::enable_live_metrics(const std::string& name) {
+        std::array<const char*, core::N_PHASES> phase_names{};
+        for (size_t i = 0; i < core::N_PHASES; ++i) {
+            phase_names[i] = core::phase_name(static_cast<core::Phase>(i));
+        }
+        live_metrics = std::make_unique<core::LiveMetrics>(name, phase_names);
+        if (!live_metrics->is_open()) {
+            live_metrics.reset();
+            return false;
+        }
+        return true;
+    }
+
+    double* IntegratorBase::last_phase_ms(const core::Phase phase) {
+        // the phase times of the last step are only kept if they are published
+        return live_metrics ? &live_data.phase_ms[static_cast<size_t>(phase)] : nullptr;
+    }
+
+    void IntegratorBase::simulation_step(const unsigned step, const double dt) {
+        if (respa_substeps > 1) {
+            respa_step(step, dt);
+        } else {
+            {
+                core::PhaseTimer timer(profiler, core::Phase::DRIFT, last_phase_ms(core::Phase::DRIFT));
+                drift(dt);
+            }
+            {
+                core::PhaseTimer timer(profiler, core::Phase::MIGRATION, last_phase_ms(core::Phase::MIGRATION));
+                migrate();
+            }
+            {
+                core::PhaseTimer timer(profiler, core::Phase::BOUNDARY, last_phase_ms(core::Phase::BOUNDARY));
+                apply_boundary();
+            }
+            {
+                core::PhaseTimer timer(profiler, core::Phase::PAIR_FORCES, last_phase_ms(core::Phase::PAIR_FORCES));
+                pair_forces();
+            }
+            {
+                core::PhaseTimer timer(profiler, core::Phase::BONDED_FORCES, last_phase_ms(core::Phase::BONDED_FORCES));
+                compute_bonded_forces(env::BondList::HARMONIC | env::BondList::EXCLUDED);
+            }
+            {
+                core::PhaseTimer timer(profiler, core::Phase::EXTERNAL_FORCES,
+                                       last_phase_ms(core::Phase::EXTERNAL_FORCES));
+                apply_external_forces(step, dt);
+            }
+            {
+                core::PhaseTimer timer(profiler, core::Phase::KICK, last_phase_ms(core::Phase::KICK));
+                kick(dt);
+            }
+        }
+        {
+            core::PhaseTimer timer(profiler, core::Phase::THERMOSTAT, last_phase_ms(core::Phase::THERMOSTAT));
+            apply_thermostat(step);
+        }
+
+        if (!inflow_sources.empty()) {
+            insert_particles(step, dt);
+        }
+
+        if (compact_freq > 0 && (step + 1) % compact_freq == 0) {
+            compact();
+        }
+
+        if (live_metrics && live_metrics->due()) {
+            publish_live_metrics(step + 1);
+        }
+
+        if (load_monitor && (step + 1) % load_report_freq == 0) {
+            SPDLOG_INFO("Load of steps {}-{}: {}", step + 1 - load_report_freq, step, load_monitor->summary());
+            load_monitor->reset();
+        }
+    }
+
+    void IntegratorBase::respa_step(const unsigned step, const double dt) {
+        // inserted particles start without slow forces
+        if (respa_slow_forces.size() < env.id_count()) respa_slow_forces.resize(env.id_count());
+
+        if (step == 0) {
+            for (auto& p : env.particles()) p.force = {0, 0, 0};
+            apply_boundary();
+            compute_bonded_forces(env::BondList::HARMONIC);
+            exchange_slow_forces(step, dt);
+        }
+
+        const double sub_dt = dt / respa_substeps;
+        {
+            core::PhaseTimer timer(profiler, core::Phase::KICK, last_phase_ms(core::Phase::KICK));
+            slow_kick(dt);
+        }
+        for (unsigned int s = 0; s < respa_substeps; ++s) {
+            {
+                // drift and kick of the plain scheme form a Störmer-Verlet step of the fast forces
+                core::PhaseTimer timer(profiler, core::Phase::DRIFT, last_phase_ms(core::Phase::DRIFT));
+                drift(sub_dt);
+            }
+            {
+                core::PhaseTimer timer(profiler, core::Phase::MIGRATION, last_phase_ms(core::Phase::MIGRATION));
+                migrate();
+            }
+            {
+                core::PhaseTimer timer(profiler, core::Phase::BOUNDARY, last_phase_ms(core::Phase::BOUNDARY));
+                apply_boundary();
+            }
+            {
+                // the springs are fast forces, the exclusions correct the slow pair forces
+                core::PhaseTimer timer(profiler, core::Phase::BONDED_FORCES, last_phase_ms(core::Phase::BONDED_FORCES));
+                compute_bonded_forces(env::BondList::HARMONIC);
+            }
+            {
+                core::PhaseTimer timer(profiler, core::Phase::KICK, last_phase_ms(core::Phase::KICK));
+                kick(sub_dt);
+            }
+        }
+        exchange_slow_forces(step, dt);
+        {
+            core::PhaseTimer timer(profiler, core::Phase::KICK, last_phase_ms(core::Phase::KICK));
+            slow_kick(dt);
+        }
+    }
+
+    void IntegratorBase::exchange_slow_forces(const unsigned step, const double dt) {
+        for (auto& p : env.particles()) {
+            respa_slow_forces[p.id] = p.force;
+            p.force = {0, 0, 0};
+        }
+        {
+            core::PhaseTimer timer(profiler, core::Phase::PAIR_FORCES, last_phase_ms(core::Phase::PAIR_FORCES));
+            pair_forces();
+        }
+        {
+            core::PhaseTimer timer(profiler, core::Phase::BONDED_FORCES, last_phase_ms(core::Phase::BONDED_FORCES));
+            compute_bonded_forces(env::BondList::EXCLUDED);
+        }
+        {
+            core::PhaseTimer timer(profiler, core::Phase::EXTERNAL_FORCES, last_phase_ms(core::Phase::EXTERNAL_FORCES));
+            apply_external_forces(step, dt);
+        }
+        for (auto& p : env.particles()) {
+            std::swap(p.force, respa_slow_forces[p.id]);
+        }
+    }
+
+    void IntegratorBase::slow_kick(const double dt) {
+        for (auto& p : env.particles()) {
+            p.velocity = p.velocity + dt / 2 / p.mass * respa_slow_forces[p.id];
+        }
+    }
+
+    void IntegratorBase::drift(const double dt) {
+        drift_dim<3>(dt);
+    }
+
+    void IntegratorBase::migrate() {
+        // particles that left the domain have to be moved to the outside cell as well
+        for (auto& p : env.particles(env::GridCell::INSIDE | env::GridCell::OUTSIDE)) {
+            p.update_grid();
+        }
+    }
+
+    void IntegratorBase::apply_boundary() {
+        env.apply_boundary();
+    }
+
+    void IntegratorBase::pair_forces() {
+        if (use_direct_sum) {
+            env.apply_direct_sum(direct_sum_parallel);
+        } else {
+            compute_pair_forces();
+        }
+    }
+
+    void IntegratorBase::compute_bonded_forces(const uint8_t kinds) {
+        env.apply_bonded_forces(false, kinds);
+    }
+
+    void IntegratorBase::apply_external_forces(const unsigned step, const double dt) {
+        for (auto& f : external_forces) {
+            for (const size_t id : f.marked_particles()) {
+                f.apply_force(env[id], dt * step);
+            }
+        }
+    }
+
+    void IntegratorBase::kick(const double dt) {
+        kick_dim<3>(dt);
+    }
+
+    template <int DIM>
+    void IntegratorBase::drift_dim(const double dt) {
+        for (auto& p : env.particles()) {
+            const double scale = pow(dt, 2) / (2 * p.mass);
+            p.old_position = p.position;
+            for (int k = 0; k < DIM; k++) p.position[k] += dt * p.velocity[k] + scale * p.force[k];
+            p.reset_force();
+        }
+    }
+
+    template <int DIM>
+    void IntegratorBase::kick_dim(const double dt, const bool parallel) {
+        auto kick_particle = [dt](env::Particle& p) {
+            const double scale = dt / 2 / p.mass;
+            for (int k = 0; k < DIM; k++) p.velocity[k] += scale * (p.force[k] + p.old_force[k]);
+        };
+
+        if (!parallel) {
+            for (auto& p : env.particles()) kick_particle(p);
+            return;
+        }
+        const auto& ids = env.particle_ids(env::Particle::ALIVE);
+#pragma omp parallel for
+        for (size_t i = 0; i < ids.size(); ++i) {
+            kick_particle(env[ids[i]]);
+        }
+    }
+
+    template void IntegratorBase::drift_dim<2>(double);
+    template void IntegratorBase::drift_dim<3>(double);
+    template void IntegratorBase::kick_dim<2>(double, bool);
+    template void IntegratorBase::kick_dim<3>(double, bool);
+
+    void IntegratorBase::apply_thermostat(const unsigned step) {
+        if (step % temp_adjust_freq == 0) {
+            TRACE_SCOPE("adjust_temperature");
+            thermostat.adjust_temperature(env);
+        }
+    }
+
+    void IntegratorBase::begin_live_metrics(const double start_time, const double end_time, const double dt) {
+        if (!live_metrics) return;
+        live_start_time = start_time;
+        live_dt = dt;
+        live_data.total_steps = static_cast<uint64_t>(std::ceil((end_time - start_time) / dt));
+        live_data.end_time = end_time;
+        live_data.finished = 0;
+        live_data.phase_ms.fill(0);
+        publish_live_metrics(0);
+    }
+
+    void IntegratorBase::publish_live_metrics(const unsigned int steps, const bool finished) {
+        if (!live_metrics) return;
+        live_data.step = steps;
+        live_data.time = live_start_time + steps * live_dt;
+        live_data.alive = env.size(env::Particle::ALIVE);
+        live_data.temperature = live_data.alive > 0 ? env.temperature() : 0;
+        live_data.stationary = env.size(env::Particle::STATIONARY);
+        live_data.dead = env.size(env::Particle::DEAD) + env.removed_count();
+        live_data.finished = finished;
+        live_metrics->publish(live_data);
+    }
+
+    void IntegratorBase::compact() {
+        TRACE_SCOPE("compact");
+        if (env.compact(compact_cell_order) == 0) return;
+        for (auto& f : external_forces) {
+            f.unmark_removed(env);
+        }
+    }
+
+    void IntegratorBase::insert_particles(const unsigned step, const double dt) {
+        TRACE_SCOPE("inflow");
+        const size_t first_id = env.id_count();
+        size_t count = 0;
+        for (auto& source : inflow_sources) {
+            count += source.insert(env, dt * (step + 1), dt);
+        }
+        if (count == 0) return;
+        for (auto& f : external_forces) {
+            f.mark_added(env, first_id);
+        }
+    }
+
+    size_t IntegratorBase::count_pair_candidates() {
+        if (use_direct_sum) {
+            const size_t n = env.size(static_cast<env::Particle::State>(env::Particle::ALIVE | env::Particle::STATIONARY));
+            return n * (n - 1) / 2;
+        }
+        return env.pair_candidates();
     }
-}  // namespace md::Integrator
\ No newline at end of file
+}  // namespace md::Integrator
@@ -1,11 +1,15 @@
 #pragma once
 
 #include <limits>
+#include "LiveMetrics.h"
+#include "LoadMonitor.h"
 #include "Statistics.h"
+#include "StepProfiler.h"
 #include "env/Environment.h"
 #include "effects/Thermostat.h"
 #include "io/IOStrategy.h"
 #include "effects/ConstantForce.h"
+#include "effects/InflowSource.h"
 #define NEVER std::numeric_limits<unsigned int>::max()
 
 namespace md::Integrator {
@@ -47,25 +51,246 @@ namespace md::Integrator {
         void simulate(double start_time, double end_time, double dt, unsigned int write_freq = 1000, unsigned int temp_adj_freq = NEVER );
 
         /**
-         * @brief Benchmarks the performance of the simulation. Calculates the total execution time and the average
-         * execution time per step.
+         * @brief Benchmarks the performance of the simulation. Measures the time spent in each phase of every step and
+         * prints a summary with mean and percentiles of the step times, the number of pair candidates and the MUPS/s.
          * @param start_time The start time of the simulation.
          * @param end_time The end time of the simnulation.
          * @param dt Δt The time increment for each simulation step.
          * @param temp_adj_freq Number of time steps between periodic temperature adjustments.
+         * @param warmup_steps Number of steps at the start that are excluded from the measurement.
+         * @param report Base path of the report files (<report>.json and <report>.csv), no report is written if empty.
+         * @param hardware_counters Read hardware performance counters for each phase and thread (Linux only). The
+         * counters are added to the JSON report and written to <report>_counters.csv.
          */
-        void benchmark(double start_time, double end_time, double dt, unsigned int temp_adj_freq = NEVER);
+        void benchmark(double start_time, double end_time, double dt, unsigned int temp_adj_freq = NEVER,
+                       unsigned int warmup_steps = 0, const std::string& report = "", bool hardware_counters = false);
+
+        /**
+         * @brief Runs the simulation without output, statistics or progress bar and measures its wall clock time.
+         * @param start_time The start time of the simulation.
+         * @param end_time The end time of the simulation.
+         * @param dt Δt The time increment for each simulation step.
+         * @param temp_adj_freq Number of time steps between periodic temperature adjustments.
+         * @return The run time in seconds.
+         */
+        double timed_run(double start_time, double end_time, double dt, unsigned int temp_adj_freq = NEVER);
+
+        /**
+         * @brief Runs the simulation without output, statistics or progress bar and records the time of each phase of
+         * every step.
+         * @param start_time The start time of the simulation.
+         * @param end_time The end time of the simulation.
+         * @param dt Δt The time increment for each simulation step.
+         * @param temp_adj_freq Number of time steps between periodic temperature adjustments.
+         * @param step_profiler The profiler that records the steps.
+         */
+        void profiled_run(double start_time, double end_time, double dt, unsigned int temp_adj_freq,
+                          core::StepProfiler& step_profiler);
+
+        /**
+         * @brief Measures busy, lock wait and barrier wait time per thread in the parallel pair force computation and
+         * logs the load imbalance periodically.
+         * @param report_freq Number of steps between two reports.
+         */
+        void monitor_load(unsigned int report_freq);
+
+        /**
+         * @brief Removes the dead particles from the particle storage periodically, see env::Environment::compact.
+         * @param freq Number of steps between two compactions.
+         * @param cell_order Whether the storage is repacked in the order of the grid cells.
+         */
+        void compact_storage(unsigned int freq, bool cell_order = false);
+
+        /**
+         * @brief Adds a source that inserts particles between the steps. External forces are applied to the inserted
+         * particles that their markers select.
+         * @param source The inflow source.
+         */
+        void add_inflow(const env::InflowSource& source);
+
+        /**
+         * @brief Switches to the r-RESPA multiple time step scheme (Tuckerman et al., 1992). The fast forces, i.e. the
+         * bonds and the repulsive boundary walls, are integrated with substeps of dt / substeps inside every step,
+         * while the pair and external forces are only computed once per step and applied as half kicks at its start
+         * and end. With stiff bonds, dt can then be chosen for the pair forces alone.
+         * @param substeps Number of fast substeps per step, plain Störmer-Verlet if 1.
+         */
+        void multiple_time_step(unsigned int substeps);
+
+        /**
+         * @brief Computes the pair forces by the direct sum of all particle pairs instead of the linked cells of the
+         * integrator, see env::Environment::apply_direct_sum.
+         * @param parallel Whether the pairs are evaluated by all OpenMP threads.
+         */
+        void direct_sum(bool parallel);
+
+        /**
+         * @brief Publishes step, simulation time, step rate, MUPS/s, temperature, particle counts and the phase times
+         * of the last step in a shared memory segment during every run, at most every LIVE_METRICS_INTERVAL_MS.
+         * The segment can be watched with MolSimMonitor and is removed when the simulator is destroyed.
+         * @param name Name of the shared memory segment, must start with '/'.
+         * @return "true" if the segment could be created, "false" otherwise.
+         */
+        bool enable_live_metrics(const std::string& name);
 
        protected:
         /**
-         * @brief Abstract method for performing a single simulation step.
+         * @brief Performs a single simulation step by running all phases in order. Each phase is timed if a profiler
+         * is attached.
+         * @param step The current iteration.
+         * @param dt Δt The time increment for each simulation step.
+         */
+        virtual void simulation_step(unsigned int step, double dt);
+
+        /**
+         * @brief Performs a single r-RESPA step, see multiple_time_step. At the start of a run the forces of the
+         * initial positions are computed first.
+         * @param step The current iteration.
+         * @param dt Δt The time increment of the step, divided into the substeps.
+         */
+        void respa_step(unsigned int step, double dt);
+
+        /**
+         * @brief Computes the pair and external forces of the current positions. The fast forces held by the particles
+         * are kept, the new slow forces are swapped into respa_slow_forces.
+         * @param step The current iteration.
+         * @param dt Δt The time increment for each simulation step.
+         */
+        void exchange_slow_forces(unsigned int step, double dt);
+
+        /**
+         * @brief Updates the velocities of the particles by the slow forces over half a step.
+         * @param dt Δt The time increment of the step.
+         */
+        void slow_kick(double dt);
+
+        /**
+         * @brief Returns where the time of a phase of the last step is stored for the live metrics.
+         * @param phase The phase.
+         * @return The address of the phase time, null if the live metrics are not published.
+         */
+        double* last_phase_ms(core::Phase phase);
+
+        /**
+         * @brief Updates the positions of the particles and resets their forces.
+         * @param dt Δt The time increment for each simulation step.
+         */
+        virtual void drift(double dt);
+
+        /**
+         * @brief Moves particles that changed their position to their new grid cell.
+         */
+        virtual void migrate();
+
+        /**
+         * @brief Applies the boundary conditions to the particles in boundary cells or outside of the domain.
+         */
+        virtual void apply_boundary();
+
+        /**
+         * @brief Computes the pair forces between the particles of all linked cells.
+         */
+        virtual void compute_pair_forces() = 0;
+
+        /**
+         * @brief Computes the pair forces, by the direct sum if selected and by compute_pair_forces otherwise.
+         */
+        void pair_forces();
+
+        /**
+         * @brief Computes the forces of the bonds between specific particles, see env::Environment::apply_bonded_forces.
+         * @param kinds The env::BondList::Flags to evaluate.
+         */
+        virtual void compute_bonded_forces(uint8_t kinds);
+
+        /**
+         * @brief Applies the constant external forces.
+         * @param step The current iteration.
+         * @param dt Δt The time increment for each simulation step.
+         */
+        virtual void apply_external_forces(unsigned int step, double dt);
+
+        /**
+         * @brief Updates the velocities of the particles.
+         * @param dt Δt The time increment for each simulation step.
+         */
+        virtual void kick(double dt);
+
+        /**
+         * @brief Updates the positions of the particles along the first DIM axes and resets their forces.
+         * @tparam DIM The number of dimensions, 2 or 3.
+         * @param dt Δt The time increment for each simulation step.
+         */
+        template <int DIM>
+        void drift_dim(double dt);
+
+        /**
+         * @brief Updates the velocities of the particles along the first DIM axes.
+         * @tparam DIM The number of dimensions, 2 or 3.
+         * @param dt Δt The time increment for each simulation step.
+         * @param parallel Whether all alive particles are updated in parallel, otherwise the ones inside the domain
+         * are updated sequentially.
+         */
+        template <int DIM>
+        void kick_dim(double dt, bool parallel = false);
+
+        /**
+         * @brief Adjusts the temperature if the step is a multiple of the temperature adjustment frequency.
+         * @param step The current iteration.
+         */
+        virtual void apply_thermostat(unsigned int step);
+
+        /**
+         * @brief Compacts the particle storage and drops the removed particles from the external forces.
+         */
+        void compact();
+
+        /**
+         * @brief Inserts the particles of the inflow sources due in the step and marks them for the external forces.
+         * @param step The current iteration.
+         * @param dt Δt The time increment for each simulation step.
+         */
+        void insert_particles(unsigned int step, double dt);
+
+        /**
+         * @brief Counts the particle pairs visited by the pair force computation.
+         * @return The number of pair candidates.
+         */
+        [[nodiscard]] size_t count_pair_candidates();
+
+        /**
+         * @brief Sets the run parameters of the live metrics at the start of a run.
+         * @param start_time The start time of the simulation.
+         * @param end_time The end time of the simulation.
+         * @param dt Δt The time increment for each simulation step.
+         */
+        void begin_live_metrics(double start_time, double end_time, double dt);
+
+        /**
+         * @brief Publishes the live metrics.
+         * @param steps Number of completed steps.
+         * @param finished Whether the run has ended.
          */
-        virtual void simulation_step(unsigned int, double) {};
+        void publish_live_metrics(unsigned int steps, bool finished = false);
 
         env::Environment& env;            ///< Reference to the environment.
         const env::Thermostat thermostat; ///< Thermostat to adjust temperature of the environment
         unsigned int temp_adjust_freq;    ///< Number of time steps between periodic temperature adjustments.
         std::vector<env::ConstantForce> external_forces;  ///< List of constant external forces applied to the particles.
+        std::vector<env::InflowSource> inflow_sources;   ///< Sources inserting particles between the steps.
+        core::StepProfiler* profiler = nullptr;  ///< Phase timings, only attached during benchmarks.
+        std::unique_ptr<core::LoadMonitor> load_monitor;  ///< Per thread load, null if not monitored.
+        unsigned int load_report_freq = 0;       ///< Number of steps between two load imbalance reports.
+        unsigned int compact_freq = 0;           ///< Number of steps between two compactions, never compacted if 0.
+        bool compact_cell_order = false;         ///< Whether the storage is repacked in the order of the grid cells.
+        std::unique_ptr<core::LiveMetrics> live_metrics;  ///< Shared memory segment, null if not published.
+        core::LiveMetricsData live_data;         ///< Metrics of the running simulation, phase times of the last step.
+        double live_start_time = 0;              ///< Start time of the running simulation.
+        double live_dt = 0;                      ///< Time step of the running simulation.
+        unsigned int respa_substeps = 1;         ///< Fast substeps per step, r-RESPA is used if greater than 1.
+        std::vector<vec3> respa_slow_forces;     ///< Pair and external forces of each particle id (r-RESPA).
+        bool use_direct_sum = false;             ///< Whether the pair forces are computed by the direct sum.
+        bool direct_sum_parallel = false;        ///< Whether the direct sum runs on all OpenMP threads.
 
        private:
         std::unique_ptr<io::OutputWriterBase> writer;  ///< The output writer.
@@ -1,34 +1,81 @@
 #include "IntegratorFactory.h"
 #include "StoermerVerlet/StoermerVerlet.h"
 #include "StoermerVerlet/StoermerVerletCellLock.h"
+#include "StoermerVerlet/StoermerVerletNewton3Off.h"
 #include "StoermerVerlet/StoermerVerletSpatialDecomp.h"
 #include "io/Logger/Logger.h"
 
 namespace md::Integrator {
-    std::unique_ptr<IntegratorBase> create_simulator(io::ProgramArguments &args) {
+    namespace {
+        /**
+         * @brief Creates the integrator of the parallelization strategy with the kernels of a dimension.
+         * @tparam DIM The number of dimensions, 2 or 3.
+         * @param args The program arguments.
+         * @param writer The output writer, may be null.
+         * @param checkpoint_writer The checkpoint writer, may be null.
+         * @return The integrator.
+         */
+        template <int DIM>
+        std::unique_ptr<IntegratorBase> create_integrator(io::ProgramArguments &args,
+                                                          std::unique_ptr<io::OutputWriterBase> writer,
+                                                          std::unique_ptr<io::CheckpointWriter> checkpoint_writer) {
+            switch (args.parallel_strategy) {
+                case 1:
+                    return std::make_unique<StoermerVerletCellLock<DIM>>(args.env, std::move(writer), std::move(checkpoint_writer),
+                                                                         args.thermostat, args.external_forces, std::move(args.stats));
+                case 2:
+                    return std::make_unique<StoermerVerletSpatialDecomp<DIM>>(args.env, std::move(writer), std::move(checkpoint_writer),
+                                                                              args.thermostat, args.external_forces, std::move(args.stats));
+                case 3:
+                    return std::make_unique<StoermerVerletNewton3Off<DIM>>(args.env, std::move(writer), std::move(checkpoint_writer),
+                                                                           args.thermostat, args.external_forces, std::move(args.stats));
+                default:
+                    return std::make_unique<StoermerVerlet<DIM>>(args.env, std::move(writer), std::move(checkpoint_writer),
+                                                                 args.thermostat, args.external_forces, std::move(args.stats));
+            }
+        }
+    }  // namespace
+
+    std::unique_ptr<IntegratorBase> create_simulator(io::ProgramArguments &args, const bool with_output) {
 
-        auto writer = create_writer(args.output_baseName, args.output_format, args.override);
-        auto checkpoint_writer = io::create_checkpoint_writer();
+        std::unique_ptr<io::OutputWriterBase> writer = nullptr;
+        std::unique_ptr<io::CheckpointWriter> checkpoint_writer = nullptr;
+        if (with_output) {
+            writer = create_writer(args.output_baseName, args.output_format, args.override, args.output_filter);
+            checkpoint_writer = io::create_checkpoint_writer();
+        }
 
 #ifndef _OPENMP
-        if (args.parallel_strategy == 1 || args.parallel_strategy == 2) {
+        if (args.parallel_strategy >= 1 && args.parallel_strategy <= 3) {
             SPDLOG_INFO("A parallelization strategy was selected, but the program was compiled without the OpenMP flag. "
                         "To enable parallelization, please compile with the \"-fopenmp\" flag.");
             exit(-1);
         }
 #endif
 
-        switch (args.parallel_strategy) {
-            case 1:
-                return std::make_unique<StoermerVerletCellLock>(args.env, std::move(writer), std::move(checkpoint_writer),
-                                                                args.thermostat, args.external_forces, std::move(args.stats));
-            case 2:
-                return std::make_unique<StoermerVerletSpatialDecomp>(args.env, std::move(writer), std::move(checkpoint_writer),
-                                                                     args.thermostat, args.external_forces, std::move(args.stats));
-            default:
-                return std::make_unique<StoermerVerlet>(args.env, std::move(writer), std::move(checkpoint_writer),
-                                                        args.thermostat, args.external_forces, std::move(args.stats));
+        // the kernels are specialized for the dimension at compile time
+        std::unique_ptr<IntegratorBase> simulator =
+            args.env.dim() == 2 ? create_integrator<2>(args, std::move(writer), std::move(checkpoint_writer))
+                                : create_integrator<3>(args, std::move(writer), std::move(checkpoint_writer));
+
+        bool direct_sum = false;
+        if (args.pair_method == env::PairMethod::DIRECT_SUM) {
+            direct_sum = args.env.direct_sum_supported();
+            if (!direct_sum) {
+                SPDLOG_WARN("The direct sum does not support the forces or the boundary, using the linked cells.");
+            }
+        } else if (args.pair_method == env::PairMethod::AUTO) {
+            direct_sum = args.env.direct_sum_suitable();
+        }
+        if (direct_sum) {
+            SPDLOG_INFO("Computing the pair forces by the direct sum of all particle pairs.");
+            simulator->direct_sum(args.parallel_strategy != 0);
         }
 
+        for (const auto& source : args.inflow_sources) {
+            simulator->add_inflow(source);
+        }
+        simulator->multiple_time_step(args.respa_substeps);
+        return simulator;
     }
 } // namespace md::Integrator
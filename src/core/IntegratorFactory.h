@@ -7,8 +7,9 @@ namespace md::Integrator {
     /**
      * @brief Creates a simulator object based on the chosen parallelization strategy.
      * @param args Program arguments for configuring the simulation.
-     * @param stats (optional)
+     * @param with_output If "false", no output and checkpoint writers are created and the output folder is left
+     * untouched (e.g. for measurements).
      * @return A unique pointer to an "IntegratorBase" object.
      */
-    std::unique_ptr<IntegratorBase> create_simulator(io::ProgramArguments &args);
+    std::unique_ptr<IntegratorBase> create_simulator(io::ProgramArguments &args, bool with_output = true);
 }
@@ -0,0 +1,120 @@
+#include "LiveMetrics.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace md::core {
+    // the atomics are shared between processes, which is only defined for lock-free atomics
+    static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free);
+    static_assert(std::is_trivially_copyable_v<LiveMetricsData>);
+
+    namespace {
+        /// Number of attempts of a reader to get a consistent snapshot.
+        constexpr int READ_ATTEMPTS = 1000;
+    }  // namespace
+
+    std::string live_metrics_name(const int64_t pid) { return LIVE_METRICS_PREFIX + std::to_string(pid); }
+
+    LiveMetrics::LiveMetrics(std::string name, const std::array<const char*, N_PHASES>& phase_names,
+                             const clock::duration interval)
+        : name(std::move(name)),
+          interval(interval) {
+        shm_unlink(this->name.c_str());
+        const int fd = shm_open(this->name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0) return;
+
+        void* memory = MAP_FAILED;
+        if (ftruncate(fd, sizeof(LiveMetricsSegment)) == 0) {
+            memory = mmap(nullptr, sizeof(LiveMetricsSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+        if (memory == MAP_FAILED) {
+            shm_unlink(this->name.c_str());
+            return;
+        }
+
+        // the segment is zero filled by ftruncate, readers ignore it until the magic number is set
+        segment = new (memory) LiveMetricsSegment{};
+        segment->version = LIVE_METRICS_VERSION;
+        for (size_t i = 0; i < N_PHASES; ++i) {
+            std::strncpy(segment->phase_names[i].data(), phase_names[i], segment->phase_names[i].size() - 1);
+        }
+        segment->data.pid = getpid();
+        segment->magic.store(LIVE_METRICS_MAGIC, std::memory_order_release);
+        last_update = clock::now();
+    }
+
+    LiveMetrics::~LiveMetrics() {
+        if (!segment) return;
+        munmap(segment, sizeof(LiveMetricsSegment));
+        shm_unlink(name.c_str());
+    }
+
+    void LiveMetrics::publish(LiveMetricsData data) {
+        if (!segment) return;
+
+        const auto now = clock::now();
+        const double seconds = std::chrono::duration<double>(now - last_update).count();
+        const uint64_t steps = data.step - std::min(last_step, data.step);
+        data.pid = getpid();
+        data.steps_per_second = seconds > 0 ? static_cast<double>(steps) / seconds : 0;
+        data.mups = data.steps_per_second * static_cast<double>(data.alive) * 1e-6;
+        last_update = now;
+        last_step = data.step;
+
+        // sequence lock: odd while writing, the fences keep the data writes between the two increments
+        const uint64_t sequence = segment->sequence.load(std::memory_order_relaxed);
+        segment->sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&segment->data, &data, sizeof(LiveMetricsData));
+        segment->sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    LiveMetricsReader::LiveMetricsReader(const std::string& name) {
+        const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) return;
+
+        struct stat info {};
+        void* memory = MAP_FAILED;
+        if (fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= sizeof(LiveMetricsSegment)) {
+            memory = mmap(nullptr, sizeof(LiveMetricsSegment), PROT_READ, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+        if (memory == MAP_FAILED) return;
+
+        segment = static_cast<const LiveMetricsSegment*>(memory);
+        if (segment->magic.load(std::memory_order_acquire) != LIVE_METRICS_MAGIC ||
+            segment->version != LIVE_METRICS_VERSION) {
+            munmap(memory, sizeof(LiveMetricsSegment));
+            segment = nullptr;
+        }
+    }
+
+    LiveMetricsReader::~LiveMetricsReader() {
+        if (segment) munmap(const_cast<LiveMetricsSegment*>(segment), sizeof(LiveMetricsSegment));
+    }
+
+    std::string LiveMetricsReader::phase_name(const size_t phase) const {
+        if (!segment || phase >= N_PHASES) return "";
+        const auto& name = segment->phase_names[phase];
+        return {name.data(), strnlen(name.data(), name.size())};
+    }
+
+    bool LiveMetricsReader::read(LiveMetricsData& data) const {
+        if (!segment) return false;
+
+        for (int attempt = 0; attempt < READ_ATTEMPTS; ++attempt) {
+            const uint64_t before = segment->sequence.load(std::memory_order_acquire);
+            if (before & 1) continue;
+            std::memcpy(&data, &segment->data, sizeof(LiveMetricsData));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (segment->sequence.load(std::memory_order_relaxed) == before) return true;
+        }
+        return false;
+    }
+}  // namespace md::core
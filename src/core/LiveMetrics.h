@@ -0,0 +1,146 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "StepProfiler.h"
+
+#define LIVE_METRICS_PREFIX "/molsim."
+#define LIVE_METRICS_MAGIC 0x4d444c4du  // "MLDM"
+#define LIVE_METRICS_VERSION 1u
+#define LIVE_METRICS_INTERVAL_MS 200
+
+namespace md::core {
+
+    /**
+     * @brief Metrics of a running simulation as published in the shared memory segment.
+     */
+    struct LiveMetricsData {
+        int64_t pid = 0;                          ///< Process id of the simulation.
+        uint64_t step = 0;                        ///< Number of completed steps.
+        uint64_t total_steps = 0;                 ///< Number of steps of the run.
+        double time = 0;                          ///< Simulation time.
+        double end_time = 0;                      ///< Simulation time at the end of the run.
+        double steps_per_second = 0;              ///< Steps per wall clock second since the previous update.
+        double mups = 0;                          ///< Million particle updates per second since the previous update.
+        double temperature = 0;                   ///< Temperature of the moving particles.
+        uint64_t alive = 0;                       ///< Number of moving particles.
+        uint64_t stationary = 0;                  ///< Number of stationary particles.
+        uint64_t dead = 0;                        ///< Number of removed particles.
+        std::array<double, N_PHASES> phase_ms{};  ///< Time of each phase of the last step in ms.
+        uint32_t finished = 0;                    ///< 1 once the run has ended.
+    };
+
+    /**
+     * @brief Layout of the shared memory segment.
+     *
+     * The data is guarded by a sequence lock: the writer makes the sequence odd, writes the data and makes it even
+     * again. A reader copies the data and retries if the sequence was odd or changed meanwhile. Neither side blocks.
+     */
+    struct LiveMetricsSegment {
+        std::atomic<uint32_t> magic;                             ///< LIVE_METRICS_MAGIC once the segment is ready.
+        uint32_t version;                                        ///< LIVE_METRICS_VERSION.
+        std::array<std::array<char, 16>, N_PHASES> phase_names;  ///< Names of the phases.
+        std::atomic<uint64_t> sequence;                          ///< Sequence lock, odd while the data is written.
+        LiveMetricsData data;                                    ///< The metrics.
+    };
+
+    /**
+     * @brief Returns the default segment name of a process: LIVE_METRICS_PREFIX<pid>.
+     * @param pid The process id.
+     */
+    std::string live_metrics_name(int64_t pid);
+
+    /**
+     * @brief Publishes the metrics of a simulation in a POSIX shared memory segment (/dev/shm/<name> on Linux).
+     *
+     * Publishing is lock-free and never waits for readers. The segment is removed when the object is destroyed.
+     */
+    class LiveMetrics {
+       public:
+        using clock = std::chrono::steady_clock;
+
+        /**
+         * @brief Creates the shared memory segment, an existing segment of the same name is replaced.
+         * @param name Name of the segment, must start with '/'.
+         * @param phase_names Names of the phases, stored in the segment for the readers.
+         * @param interval Minimal wall clock time between two updates.
+         */
+        LiveMetrics(std::string name, const std::array<const char*, N_PHASES>& phase_names,
+                    clock::duration interval = std::chrono::milliseconds(LIVE_METRICS_INTERVAL_MS));
+        ~LiveMetrics();
+
+        LiveMetrics(const LiveMetrics&) = delete;
+        LiveMetrics& operator=(const LiveMetrics&) = delete;
+
+        /**
+         * @brief Returns whether the segment could be created.
+         */
+        [[nodiscard]] bool is_open() const { return segment != nullptr; }
+
+        /**
+         * @brief Returns the name of the segment.
+         */
+        [[nodiscard]] const std::string& segment_name() const { return name; }
+
+        /**
+         * @brief Returns whether the interval since the last update has passed, i.e. whether the caller should
+         * gather the metrics and publish them.
+         */
+        [[nodiscard]] bool due() const { return is_open() && clock::now() - last_update >= interval; }
+
+        /**
+         * @brief Publishes the metrics. Step rate and MUPS/s are derived from the steps and the moving particles
+         * since the previous update.
+         * @param data The metrics, pid, steps_per_second and mups are overwritten.
+         */
+        void publish(LiveMetricsData data);
+
+       private:
+        std::string name;                       ///< Name of the segment.
+        clock::duration interval;               ///< Minimal time between two updates.
+        LiveMetricsSegment* segment = nullptr;  ///< The mapped segment, null if it could not be created.
+        clock::time_point last_update;          ///< Time of the previous update.
+        uint64_t last_step = 0;                 ///< Step of the previous update.
+    };
+
+    /**
+     * @brief Reads the metrics published by a LiveMetrics object of another process.
+     */
+    class LiveMetricsReader {
+       public:
+        /**
+         * @brief Opens an existing segment for reading.
+         * @param name Name of the segment.
+         */
+        explicit LiveMetricsReader(const std::string& name);
+        ~LiveMetricsReader();
+
+        LiveMetricsReader(const LiveMetricsReader&) = delete;
+        LiveMetricsReader& operator=(const LiveMetricsReader&) = delete;
+
+        /**
+         * @brief Returns whether the segment exists and has a matching layout.
+         */
+        [[nodiscard]] bool is_open() const { return segment != nullptr; }
+
+        /**
+         * @brief Returns the name of a phase as stored in the segment.
+         * @param phase Index of the phase.
+         */
+        [[nodiscard]] std::string phase_name(size_t phase) const;
+
+        /**
+         * @brief Copies a consistent snapshot of the metrics.
+         * @param data Receives the metrics.
+         * @return "false" if no consistent snapshot could be taken, e.g. because the writer updates continuously.
+         */
+        bool read(LiveMetricsData& data) const;
+
+       private:
+        const LiveMetricsSegment* segment = nullptr;  ///< The mapped segment, null if it could not be opened.
+    };
+}  // namespace md::core
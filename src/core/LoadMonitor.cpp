@@ -0,0 +1,120 @@
+#include "LoadMonitor.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include "io/Logger/Logger.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace md::core {
+    namespace {
+        double seconds(const LoadMonitor::clock::duration duration) {
+            return std::chrono::duration<double>(duration).count();
+        }
+    }  // namespace
+
+    LoadMonitor::LoadMonitor() {
+#ifdef _OPENMP
+        slots.resize(omp_get_max_threads());
+#else
+        slots.resize(1);
+#endif
+        totals.resize(slots.size());
+        run_totals.resize(slots.size());
+    }
+
+    void LoadMonitor::begin_region() {
+        for (auto& slot : slots) slot.active = false;
+    }
+
+    void LoadMonitor::thread_done(const clock::time_point start, const clock::duration lock_wait) {
+        const auto done = clock::now();
+#ifdef _OPENMP
+        const auto thread = static_cast<size_t>(omp_get_thread_num());
+#else
+        const size_t thread = 0;
+#endif
+        if (thread >= slots.size()) return;
+        slots[thread] = {start, done, lock_wait, true};
+    }
+
+    void LoadMonitor::end_region(const size_t block_set) {
+        clock::time_point end{};
+        for (const auto& slot : slots) {
+            if (slot.active) end = std::max(end, slot.done);
+        }
+
+        if (set_waits.size() <= block_set) set_waits.resize(block_set + 1);
+        for (size_t t = 0; t < slots.size(); ++t) {
+            const Slot& slot = slots[t];
+            if (!slot.active) continue;
+            const double busy = seconds(slot.done - slot.start - slot.lock_wait);
+            const double lock_wait = seconds(slot.lock_wait);
+            const double barrier_wait = seconds(end - slot.done);
+            for (auto* times : {&totals[t], &run_totals[t]}) {
+                times->busy += busy;
+                times->lock_wait += lock_wait;
+                times->barrier_wait += barrier_wait;
+            }
+            set_waits[block_set] += barrier_wait;
+        }
+        regions++;
+    }
+
+    double LoadMonitor::imbalance() const {
+        double max = 0;
+        double sum = 0;
+        size_t threads = 0;
+        for (const auto& times : totals) {
+            if (times.busy <= 0) continue;
+            max = std::max(max, times.busy);
+            sum += times.busy;
+            threads++;
+        }
+        return sum > 0 ? max / (sum / static_cast<double>(threads)) : 1.0;
+    }
+
+    std::string LoadMonitor::summary() const {
+        double busy = 0, lock_wait = 0, barrier_wait = 0;
+        for (const auto& times : totals) {
+            busy += times.busy;
+            lock_wait += times.lock_wait;
+            barrier_wait += times.barrier_wait;
+        }
+        const double total = busy + lock_wait + barrier_wait;
+        auto share = [&](const double value) { return total > 0 ? 100.0 * value / total : 0.0; };
+
+        std::string result = fmt::format(
+            "imbalance (max/mean busy) {:.3f} over {} regions, busy {:.1f}%, lock wait {:.1f}%, barrier wait {:.1f}%",
+            imbalance(), regions, share(busy), share(lock_wait), share(barrier_wait));
+        if (set_waits.size() > 1) {
+            const auto worst = std::max_element(set_waits.begin(), set_waits.end());
+            result += fmt::format(", most barrier wait in block set {} ({:.3f} ms)", worst - set_waits.begin(),
+                                  *worst * 1e3);
+        }
+        return result;
+    }
+
+    void LoadMonitor::write_csv(const std::string& file_name) const {
+        std::ofstream file(file_name);
+        if (!file.is_open()) {
+            SPDLOG_ERROR("Could not open load report {}", file_name);
+            return;
+        }
+
+        file << "thread,busy_s,lock_wait_s,barrier_wait_s\n";
+        for (size_t t = 0; t < run_totals.size(); ++t) {
+            const ThreadTimes& times = run_totals[t];
+            file << fmt::format("{},{},{},{}\n", t, times.busy, times.lock_wait, times.barrier_wait);
+        }
+    }
+
+    void LoadMonitor::reset() {
+        std::fill(totals.begin(), totals.end(), ThreadTimes{});
+        std::fill(set_waits.begin(), set_waits.end(), 0.0);
+        regions = 0;
+    }
+}  // namespace md::core
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace md::core {
+
+    /**
+     * @brief Measures how evenly the work of the parallel pair force computation is spread over the OpenMP threads.
+     *
+     * For every parallel region each thread reports when it started, when it finished its share of the work and how
+     * long it waited for cell locks. The time until the last thread finishes is the barrier wait of the others, the
+     * remaining time is busy time. The imbalance factor is the maximum busy time of a thread divided by the mean.
+     * Summaries cover the window since the last reset, the per thread times cover the whole run.
+     */
+    class LoadMonitor {
+       public:
+        using clock = std::chrono::steady_clock;
+
+        /**
+         * @brief Accumulated times of one thread in seconds.
+         */
+        struct ThreadTimes {
+            double busy = 0;          ///< Time spent working.
+            double lock_wait = 0;     ///< Time spent waiting for cell locks.
+            double barrier_wait = 0;  ///< Time spent waiting for the other threads at the end of a region.
+        };
+
+        /**
+         * @brief Constructs a LoadMonitor for the threads of the OpenMP team.
+         */
+        LoadMonitor();
+
+        /**
+         * @brief Starts a parallel region, called by the main thread before the region.
+         */
+        void begin_region();
+
+        /**
+         * @brief Reports the end of the work of the calling thread in the current region.
+         * @param start The time the thread entered the region.
+         * @param lock_wait The time the thread waited for locks in the region.
+         */
+        void thread_done(clock::time_point start, clock::duration lock_wait = {});
+
+        /**
+         * @brief Ends a parallel region and accumulates its times, called by the main thread after the region.
+         * @param block_set Index of the block set processed in the region (0 if there are no block sets).
+         */
+        void end_region(size_t block_set = 0);
+
+        /**
+         * @brief Returns the accumulated times of each thread over the whole run.
+         */
+        [[nodiscard]] const std::vector<ThreadTimes>& thread_times() const { return run_totals; }
+
+        /**
+         * @brief Returns the barrier wait summed over all threads for each block set since the last reset, in seconds.
+         */
+        [[nodiscard]] const std::vector<double>& block_set_waits() const { return set_waits; }
+
+        /**
+         * @brief Returns the maximum busy time of a thread divided by the mean busy time of the threads that took part
+         * in the current window, 1 if nothing was measured.
+         */
+        [[nodiscard]] double imbalance() const;
+
+        /**
+         * @brief Describes the measurements since the last reset in a single line, e.g. for a log message.
+         */
+        [[nodiscard]] std::string summary() const;
+
+        /**
+         * @brief Writes the times of each thread over the whole run as CSV file.
+         * @param file_name Path of the file.
+         */
+        void write_csv(const std::string& file_name) const;
+
+        /**
+         * @brief Starts a new window, the times of the whole run are kept.
+         */
+        void reset();
+
+       private:
+        /**
+         * @brief Times of the current region of one thread, on its own cache line to avoid false sharing.
+         */
+        struct alignas(64) Slot {
+            clock::time_point start;    ///< Start of the region.
+            clock::time_point done;     ///< End of the work.
+            clock::duration lock_wait;  ///< Lock wait in the region.
+            bool active = false;        ///< Whether the thread took part in the region.
+        };
+
+        std::vector<Slot> slots;              ///< Times of the current region per thread.
+        std::vector<ThreadTimes> totals;      ///< Times per thread of the current window.
+        std::vector<ThreadTimes> run_totals;  ///< Times per thread of the whole run.
+        std::vector<double> set_waits;        ///< Barrier wait per block set of the current window.
+        size_t regions = 0;                   ///< Number of regions of the current window.
+    };
+}  // namespace md::core
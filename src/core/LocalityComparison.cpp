@@ -0,0 +1,90 @@
+#include "LocalityComparison.h"
+
+#include <iostream>
+
+#include "IntegratorFactory.h"
+#include "io/IOStrategy.h"
+#include "io/Logger/Logger.h"
+
+namespace md::core {
+    namespace {
+        /**
+         * @brief Runs the scenario with a cell order and measures it.
+         */
+        LocalityResult measure(const LocalityOptions& options, const env::CellOrder order) {
+            io::ProgramArguments args;
+            args.stream_input = options.stream_input;
+            args.cell_order = order;
+            // reading the input logs every particle set
+            const auto log_level = spdlog::get_level();
+            spdlog::set_level(spdlog::level::warn);
+            io::read_file(options.input_file, args);
+            spdlog::set_level(log_level);
+
+            args.stats = nullptr;
+            // the cell order only affects the linked cells
+            args.pair_method = env::PairMethod::LINKED_CELLS;
+            const auto simulator = Integrator::create_simulator(args, false);
+            if (options.compact_freq > 0) {
+                simulator->compact_storage(options.compact_freq, options.compact_cell_order);
+            }
+
+            StepProfiler profiler(options.warmup_steps);
+            profiler.enable_counters();
+            simulator->profiled_run(0, args.duration, args.dt, args.temp_adj_freq, profiler);
+
+            LocalityResult result;
+            result.order = order;
+            result.step_ms = profiler.step_summary().mean;
+            const auto updates = static_cast<double>(profiler.particle_updates());
+            auto per_update = [&](const Counter counter) {
+                if (!profiler.counter_available(counter) || updates == 0) return -1.0;
+                double total = 0;
+                for (size_t i = 0; i < N_PHASES; ++i) {
+                    total += profiler.phase_counters(static_cast<Phase>(i))[static_cast<size_t>(counter)];
+                }
+                return total / updates;
+            };
+            result.l1d_misses = per_update(Counter::L1D_MISSES);
+            result.llc_misses = per_update(Counter::LLC_MISSES);
+            return result;
+        }
+
+        std::string format_value(const double value, const int precision) {
+            return value < 0 ? "n/a" : fmt::format("{:.{}f}", value, precision);
+        }
+
+        std::string format_change(const double before, const double after) {
+            if (before <= 0 || after < 0) return "n/a";
+            return fmt::format("{:+.1f}%", 100 * (after - before) / before);
+        }
+    }  // namespace
+
+    const char* cell_order_name(const env::CellOrder order) {
+        switch (order) {
+            case env::CellOrder::MORTON: return "morton";
+            case env::CellOrder::HILBERT: return "hilbert";
+            default: return "linear";
+        }
+    }
+
+    std::array<LocalityResult, 2> compare_cell_orders(const LocalityOptions& options) {
+        const std::array results = {measure(options, env::CellOrder::LINEAR), measure(options, options.order)};
+        const auto& [linear, curve] = results;
+
+        std::cout << "Cell order comparison (means of the measured steps, misses per particle update):\n";
+        std::cout << fmt::format("  {:<8} {:>12} {:>12} {:>12}\n", "order", "step [ms]", "L1D misses", "LLC misses");
+        for (const auto& result : results) {
+            std::cout << fmt::format("  {:<8} {:>12.4f} {:>12} {:>12}\n", cell_order_name(result.order), result.step_ms,
+                                     format_value(result.l1d_misses, 3), format_value(result.llc_misses, 4));
+        }
+        std::cout << fmt::format("  {:<8} {:>12} {:>12} {:>12}\n", "change", format_change(linear.step_ms, curve.step_ms),
+                                 format_change(linear.l1d_misses, curve.l1d_misses),
+                                 format_change(linear.llc_misses, curve.llc_misses));
+        if (linear.l1d_misses < 0 && linear.llc_misses < 0) {
+            std::cout << "Hardware counters: not available (check /proc/sys/kernel/perf_event_paranoid)\n";
+        }
+        std::cout.flush();
+        return results;
+    }
+}  // namespace md::core
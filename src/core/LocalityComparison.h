@@ -0,0 +1,47 @@
+#pragma once
+
+#include <array>
+#include <string>
+
+#include "env/ParticleGrid.h"
+
+namespace md::core {
+
+    /**
+     * @brief Configuration of a comparison of the memory locality of two cell orders.
+     */
+    struct LocalityOptions {
+        std::string input_file;                          ///< Scenario to run.
+        env::CellOrder order = env::CellOrder::HILBERT;  ///< Cell order compared to the linear order.
+        unsigned int warmup_steps = 0;                   ///< Number of steps excluded from the measurement.
+        unsigned int compact_freq = 0;                   ///< Steps between two compactions, never if 0.
+        bool compact_cell_order = false;                 ///< Repack the particle storage in cell order when compacting.
+        bool stream_input = false;                       ///< Read xml input in streaming (SAX) mode.
+    };
+
+    /**
+     * @brief Step time and cache misses of a run with one cell order.
+     */
+    struct LocalityResult {
+        env::CellOrder order = env::CellOrder::LINEAR;  ///< The cell order.
+        double step_ms = 0;                             ///< Mean step time in ms.
+        double l1d_misses = -1;  ///< L1 data cache misses per particle update over all phases, negative if unknown.
+        double llc_misses = -1;  ///< Last level cache misses per particle update over all phases, negative if unknown.
+    };
+
+    /**
+     * @brief Returns the command line name of a cell order.
+     * @param order The cell order.
+     * @return The name.
+     */
+    const char* cell_order_name(env::CellOrder order);
+
+    /**
+     * @brief Runs the scenario once with the linear and once with the given cell order, reading the hardware counters
+     * if possible, and prints the step times and cache misses per particle update together with their change. The
+     * input file is read anew for each run and no output is written.
+     * @param options The configuration of the comparison.
+     * @return The results of the linear and of the given order.
+     */
+    std::array<LocalityResult, 2> compare_cell_orders(const LocalityOptions& options);
+}  // namespace md::core
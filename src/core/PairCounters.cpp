@@ -0,0 +1,47 @@
+#include "PairCounters.h"
+
+#ifdef MD_PAIR_COUNTERS
+
+namespace md::core {
+    thread_local PairCounters::Slot* PairCounters::local_slot = nullptr;
+
+    PairCounters& PairCounters::instance() {
+        static PairCounters counters;
+        return counters;
+    }
+
+    PairCounters::Slot* PairCounters::register_thread() {
+        auto slot = std::make_unique<Slot>();
+        const std::lock_guard lock(registration);
+        slots.push_back(std::move(slot));
+        return slots.back().get();
+    }
+
+    void PairCounters::end_step(const bool measured) {
+        const std::lock_guard lock(registration);
+        Counts step;
+        for (const auto& slot : slots) {
+            for (size_t b = 0; b < PAIR_COUNTER_BUCKETS; ++b) {
+                if (measured) buckets[b] += slot->buckets[b];
+                step += slot->buckets[b];
+            }
+            slot->buckets.fill({});
+        }
+        if (measured) steps.push_back(step);
+    }
+
+    PairCounters::Counts PairCounters::total() const {
+        Counts counts;
+        for (const auto& bucket : buckets) counts += bucket;
+        return counts;
+    }
+
+    void PairCounters::reset() {
+        const std::lock_guard lock(registration);
+        for (const auto& slot : slots) slot->buckets.fill({});
+        steps.clear();
+        buckets.fill({});
+    }
+}  // namespace md::core
+
+#endif
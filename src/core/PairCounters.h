@@ -0,0 +1,162 @@
+#pragma once
+
+/**
+ * Counters of the pair force computation, enabled by compiling with MD_PAIR_COUNTERS (cmake -DENABLE_PAIR_COUNTERS=ON).
+ *
+ * Every particle pair handed to Environment::force is counted as candidate, split into pairs within the cutoff radius,
+ * pairs beyond it and pairs skipped because both particles are stationary or one is dead. The counts are kept per step
+ * and per occupancy bucket of the first cell of the pair, and reported with the benchmark output. Without
+ * MD_PAIR_COUNTERS the macros expand to nothing and their arguments are not evaluated.
+ */
+#ifdef MD_PAIR_COUNTERS
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#define PAIR_COUNTER_BUCKETS 8
+
+#define PAIR_COUNT_SKIPPED(occupancy) \
+    md::core::PairCounters::instance().count(occupancy, md::core::PairCounters::SKIPPED)
+#define PAIR_COUNT_CANDIDATE(occupancy, dist_squared, cutoff_squared)                              \
+    md::core::PairCounters::instance().count(occupancy, (dist_squared) <= (cutoff_squared)         \
+                                                            ? md::core::PairCounters::WITHIN_CUTOFF \
+                                                            : md::core::PairCounters::BEYOND_CUTOFF)
+
+namespace md::core {
+
+    /**
+     * @brief Counts the particle pairs of the pair force computation of all threads.
+     *
+     * Every thread counts into its own cache line, only the first count of a thread registers it. Occupancy bucket b
+     * holds the pairs whose first cell contains 2^b to 2^(b+1) - 1 particles, the last bucket all larger cells.
+     */
+    class PairCounters {
+       public:
+        /**
+         * @brief Outcome of a candidate pair.
+         */
+        enum Outcome : uint8_t {
+            SKIPPED,        ///< Both particles stationary or one of them dead, no force evaluated.
+            BEYOND_CUTOFF,  ///< Distance larger than the cutoff radius.
+            WITHIN_CUTOFF,  ///< Distance within the cutoff radius.
+        };
+
+        /**
+         * @brief Counts of candidate pairs.
+         */
+        struct Counts {
+            uint64_t candidates = 0;     ///< All pairs handed to the force computation.
+            uint64_t within_cutoff = 0;  ///< Pairs within the cutoff radius.
+            uint64_t skipped = 0;        ///< Pairs skipped for stationary or dead particles.
+
+            /**
+             * @brief Returns the share of the candidates within the cutoff radius, 0 if there are none.
+             */
+            [[nodiscard]] double hit_rate() const {
+                return candidates > 0 ? static_cast<double>(within_cutoff) / static_cast<double>(candidates) : 0.0;
+            }
+
+            Counts& operator+=(const Counts& other) {
+                candidates += other.candidates;
+                within_cutoff += other.within_cutoff;
+                skipped += other.skipped;
+                return *this;
+            }
+        };
+
+        /**
+         * @brief Returns the counters of the program.
+         */
+        static PairCounters& instance();
+
+        /**
+         * @brief Returns the occupancy bucket of a cell.
+         * @param occupancy Number of particles in the cell.
+         */
+        static size_t bucket(const size_t occupancy) {
+            return occupancy < 2 ? 0 : std::min<size_t>(std::bit_width(occupancy) - 1, PAIR_COUNTER_BUCKETS - 1);
+        }
+
+        /**
+         * @brief Returns the smallest and largest occupancy of a bucket, the largest is 0 for the open last bucket.
+         * @param bucket The bucket.
+         */
+        static std::pair<size_t, size_t> bucket_range(const size_t bucket) {
+            if (bucket == 0) return {0, 1};
+            return {size_t{1} << bucket, bucket + 1 < PAIR_COUNTER_BUCKETS ? (size_t{1} << (bucket + 1)) - 1 : 0};
+        }
+
+        /**
+         * @brief Counts a candidate pair of the calling thread.
+         * @param occupancy Number of particles in the first cell of the pair.
+         * @param outcome The outcome of the pair.
+         */
+        void count(const size_t occupancy, const Outcome outcome) {
+            if (!local_slot) local_slot = register_thread();
+            Counts& counts = local_slot->buckets[bucket(occupancy)];
+            counts.candidates++;
+            counts.within_cutoff += outcome == WITHIN_CUTOFF;
+            counts.skipped += outcome == SKIPPED;
+        }
+
+        /**
+         * @brief Collects the counts of all threads since the last call, called by the main thread between steps.
+         * @param measured Whether the step is measured, the counts of warm-up steps are dropped.
+         */
+        void end_step(bool measured);
+
+        /**
+         * @brief Returns the counts of each measured step.
+         */
+        [[nodiscard]] const std::vector<Counts>& step_counts() const { return steps; }
+
+        /**
+         * @brief Returns the counts of the measured steps per occupancy bucket.
+         */
+        [[nodiscard]] const std::array<Counts, PAIR_COUNTER_BUCKETS>& bucket_counts() const { return buckets; }
+
+        /**
+         * @brief Returns the counts of all measured steps.
+         */
+        [[nodiscard]] Counts total() const;
+
+        /**
+         * @brief Drops all counts, e.g. at the start of a benchmark.
+         */
+        void reset();
+
+       private:
+        /**
+         * @brief Counts of one thread since the last step, on its own cache lines to avoid false sharing.
+         */
+        struct alignas(64) Slot {
+            std::array<Counts, PAIR_COUNTER_BUCKETS> buckets{};  ///< Counts per occupancy bucket.
+        };
+
+        PairCounters() = default;
+
+        /**
+         * @brief Creates the slot of the calling thread.
+         */
+        Slot* register_thread();
+
+        std::mutex registration;                           ///< Guards the slot list during registration.
+        std::vector<std::unique_ptr<Slot>> slots;           ///< Slots of all threads that counted a pair.
+        std::vector<Counts> steps;                          ///< Counts of each measured step.
+        std::array<Counts, PAIR_COUNTER_BUCKETS> buckets{};  ///< Counts of the measured steps per bucket.
+        static thread_local Slot* local_slot;               ///< Slot of the calling thread.
+    };
+}  // namespace md::core
+
+#else
+
+#define PAIR_COUNT_SKIPPED(occupancy) ((void)0)
+#define PAIR_COUNT_CANDIDATE(occupancy, dist_squared, cutoff_squared) ((void)0)
+
+#endif
@@ -0,0 +1,197 @@
+#include "PerfCounters.h"
+
+#include <algorithm>
+#include <fstream>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace md::core {
+    namespace {
+        /**
+         * @brief An event opened with perf_event_open and how it contributes to the reported counters.
+         */
+        struct EventSpec {
+            uint32_t type;      ///< perf event type.
+            uint64_t config;    ///< perf event configuration.
+            int group;          ///< Events of the same group are scheduled together.
+            bool intel_only;    ///< Raw event that is only defined on Intel CPUs.
+            Counter counter;    ///< Counter the event is added to.
+            double weight;      ///< Factor of the event when added to the FLOPS counter.
+        };
+
+#ifdef __linux__
+        constexpr uint64_t cache_event(const uint64_t cache, const uint64_t op, const uint64_t result) {
+            return cache | (op << 8) | (result << 16);
+        }
+
+        // FP_ARITH_INST_RETIRED (event 0xC7) with the umask of the instruction width
+        constexpr uint64_t fp_arith(const uint64_t umask) { return 0xC7 | (umask << 8); }
+
+        const std::vector<EventSpec> EVENTS = {
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, 0, false, Counter::CYCLES, 0},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, 0, false, Counter::INSTRUCTIONS, 0},
+            {PERF_TYPE_HW_CACHE,
+             cache_event(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS), 0,
+             false, Counter::L1D_MISSES, 0},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, 0, false, Counter::LLC_MISSES, 0},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, 0, false, Counter::BRANCH_MISSES, 0},
+            {PERF_TYPE_RAW, fp_arith(0x01), 1, true, Counter::FP_SCALAR, 1},  // scalar double
+            {PERF_TYPE_RAW, fp_arith(0x04), 1, true, Counter::FP_VECTOR, 2},  // 128 bit packed double
+            {PERF_TYPE_RAW, fp_arith(0x10), 1, true, Counter::FP_VECTOR, 4},  // 256 bit packed double
+            {PERF_TYPE_RAW, fp_arith(0x40), 1, true, Counter::FP_VECTOR, 8},  // 512 bit packed double
+        };
+
+        bool is_intel() {
+            std::ifstream cpuinfo("/proc/cpuinfo");
+            std::string line;
+            while (std::getline(cpuinfo, line)) {
+                if (line.starts_with("vendor_id")) return line.find("GenuineIntel") != std::string::npos;
+            }
+            return false;
+        }
+
+        int open_event(const EventSpec& spec, const int group_fd) {
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = spec.type;
+            attr.config = spec.config;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            // counts the calling thread on any cpu
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+        }
+#else
+        const std::vector<EventSpec> EVENTS = {};
+#endif
+    }  // namespace
+
+    const char* counter_name(const Counter counter) {
+        switch (counter) {
+            case Counter::CYCLES: return "cycles";
+            case Counter::INSTRUCTIONS: return "instructions";
+            case Counter::L1D_MISSES: return "l1d_misses";
+            case Counter::LLC_MISSES: return "llc_misses";
+            case Counter::BRANCH_MISSES: return "branch_misses";
+            case Counter::FP_SCALAR: return "fp_scalar";
+            case Counter::FP_VECTOR: return "fp_vector";
+            case Counter::FLOPS: return "flops";
+        }
+        return "unknown";
+    }
+
+    PerfCounters::PerfCounters() : opened(EVENTS.size(), true) {
+#ifdef __linux__
+        const bool intel = is_intel();
+#ifdef _OPENMP
+        thread_groups.resize(omp_get_max_threads());
+#else
+        thread_groups.resize(1);
+#endif
+
+        // counters only count the thread that opened them, hence every thread of the team opens its own
+#ifdef _OPENMP
+#pragma omp parallel num_threads(static_cast<int>(thread_groups.size()))
+#endif
+        {
+#ifdef _OPENMP
+            auto& groups = thread_groups[omp_get_thread_num()];
+#else
+            auto& groups = thread_groups[0];
+#endif
+            for (size_t i = 0; i < EVENTS.size(); ++i) {
+                if (EVENTS[i].intel_only && !intel) continue;
+                if (groups.size() <= static_cast<size_t>(EVENTS[i].group)) groups.resize(EVENTS[i].group + 1);
+
+                auto& group = groups[EVENTS[i].group];
+                const int fd = open_event(EVENTS[i], group.leader);
+                if (fd < 0) continue;
+                if (group.leader < 0) group.leader = fd;
+                group.fds.push_back(fd);
+                group.events.push_back(i);
+            }
+        }
+#endif
+
+        for (size_t i = 0; i < EVENTS.size(); ++i) {
+            for (const auto& groups : thread_groups) {
+                bool found = false;
+                for (const auto& group : groups) {
+                    for (const size_t event : group.events) found |= event == i;
+                }
+                opened[i] = opened[i] && found;
+            }
+        }
+    }
+
+    PerfCounters::~PerfCounters() {
+#ifdef __linux__
+        for (const auto& groups : thread_groups) {
+            for (const auto& group : groups) {
+                for (const int fd : group.fds) close(fd);
+            }
+        }
+#endif
+    }
+
+    bool PerfCounters::available(const Counter counter) const {
+        bool any = false;
+        for (size_t i = 0; i < EVENTS.size(); ++i) {
+            if (EVENTS[i].counter == counter || (counter == Counter::FLOPS && EVENTS[i].weight > 0)) {
+                any |= opened[i];
+            }
+        }
+        return any;
+    }
+
+    bool PerfCounters::any_available() const {
+        for (size_t i = 0; i < N_COUNTERS; ++i) {
+            if (available(static_cast<Counter>(i))) return true;
+        }
+        return false;
+    }
+
+    void PerfCounters::read(std::vector<Values>& values) const {
+        values.resize(thread_groups.size());
+#ifdef __linux__
+        // layout of a group read: nr, time_enabled, time_running, value[nr]
+        std::array<uint64_t, 3 + 16> buffer{};
+        for (size_t t = 0; t < thread_groups.size(); ++t) {
+            values[t].fill(0);
+            for (const auto& group : thread_groups[t]) {
+                if (group.leader < 0) continue;
+                if (::read(group.leader, buffer.data(), sizeof(buffer)) <= 0) continue;
+
+                const uint64_t n = std::min<uint64_t>(buffer[0], group.events.size());
+                // scale multiplexed events to the whole enabled time
+                const double scale = buffer[2] > 0 ? static_cast<double>(buffer[1]) / static_cast<double>(buffer[2]) : 0;
+                for (uint64_t i = 0; i < n; ++i) {
+                    const EventSpec& spec = EVENTS[group.events[i]];
+                    const double value = static_cast<double>(buffer[3 + i]) * scale;
+                    values[t][static_cast<size_t>(spec.counter)] += value;
+                    values[t][static_cast<size_t>(Counter::FLOPS)] += spec.weight * value;
+                }
+            }
+        }
+#endif
+    }
+
+    std::string PerfCounters::missing() const {
+        std::string result;
+        for (size_t i = 0; i < N_COUNTERS; ++i) {
+            const auto counter = static_cast<Counter>(i);
+            if (available(counter)) continue;
+            if (!result.empty()) result += ", ";
+            result += counter_name(counter);
+        }
+        return result;
+    }
+}  // namespace md::core
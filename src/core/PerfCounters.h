@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace md::core {
+
+    /**
+     * @brief Enumeration of the hardware events counted in benchmark mode.
+     */
+    enum class Counter : uint8_t {
+        CYCLES,          ///< CPU cycles.
+        INSTRUCTIONS,    ///< Retired instructions.
+        L1D_MISSES,      ///< L1 data cache read misses.
+        LLC_MISSES,      ///< Last level cache misses.
+        BRANCH_MISSES,   ///< Mispredicted branches.
+        FP_SCALAR,       ///< Retired scalar double precision floating point instructions.
+        FP_VECTOR,       ///< Retired packed double precision floating point instructions.
+        FLOPS,           ///< Double precision floating point operations, derived from the packed instructions.
+    };
+
+    constexpr size_t N_COUNTERS = 8;
+
+    /**
+     * @brief Returns the name of a counter as used in the benchmark reports.
+     * @param counter The counter.
+     * @return The name of the counter.
+     */
+    const char* counter_name(Counter counter);
+
+    /**
+     * @brief Reads hardware performance counters of all OpenMP threads via the Linux perf_event_open interface.
+     *
+     * Every thread of the OpenMP team opens its own counters, which are read from the calling thread. Events the
+     * CPU or the kernel does not provide (e.g. in virtual machines or with a restrictive perf_event_paranoid setting)
+     * are left out; their values stay zero and available() reports them as missing. The floating point events are
+     * model specific and only opened on Intel CPUs.
+     */
+    class PerfCounters {
+       public:
+        using Values = std::array<double, N_COUNTERS>;  ///< Counter values of one thread.
+
+        /**
+         * @brief Opens and starts the counters for every thread of the OpenMP team.
+         */
+        PerfCounters();
+        ~PerfCounters();
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        /**
+         * @brief Checks whether a counter could be opened for all threads.
+         * @param counter The counter.
+         * @return "true" if the counter is counted, "false" otherwise.
+         */
+        [[nodiscard]] bool available(Counter counter) const;
+
+        /**
+         * @brief Checks whether any counter could be opened.
+         */
+        [[nodiscard]] bool any_available() const;
+
+        /**
+         * @brief Returns the number of threads the counters were opened for.
+         */
+        [[nodiscard]] size_t threads() const { return thread_groups.size(); }
+
+        /**
+         * @brief Reads the current values of all counters. Values of multiplexed events are scaled to the full time.
+         * @param values The values per thread, resized to threads().
+         */
+        void read(std::vector<Values>& values) const;
+
+        /**
+         * @brief Describes which counters are missing, e.g. for a warning.
+         * @return A comma separated list of missing counters, empty if all are available.
+         */
+        [[nodiscard]] std::string missing() const;
+
+       private:
+        /**
+         * @brief Counters that are scheduled together on the PMU and read with a single system call.
+         */
+        struct Group {
+            int leader = -1;                      ///< File descriptor of the group leader.
+            std::vector<int> fds;                 ///< File descriptors of all members, including the leader.
+            std::vector<size_t> events;           ///< Index of the counted event of each member.
+        };
+
+        std::vector<std::vector<Group>> thread_groups;  ///< Groups of each thread.
+        std::vector<bool> opened;                       ///< Whether an event is counted on all threads.
+    };
+}  // namespace md::core
@@ -0,0 +1,100 @@
+#include "PerformanceBaseline.h"
+
+#include <fstream>
+#include <sstream>
+
+#include "io/Logger/Logger.h"
+
+namespace md::core {
+    namespace {
+        constexpr double MIN_PHASE_SHARE = 0.01;
+
+        std::string csv_header() {
+            std::string header = "scenario,size,strategy,threads,particles,steps,mups,step_ms";
+            for (size_t i = 0; i < N_PHASES; ++i) {
+                header += fmt::format(",{}_ms", phase_name(static_cast<Phase>(i)));
+            }
+            return header;
+        }
+    }  // namespace
+
+    std::string baseline_key(const ScenarioResult& result) {
+        return fmt::format("{}/{}/{}/{}", result.scenario, result.size, result.strategy, result.threads);
+    }
+
+    std::vector<ScenarioResult> read_baselines(const std::string& file_name) {
+        std::vector<ScenarioResult> baselines;
+        std::ifstream file(file_name);
+        if (!file.is_open()) return baselines;
+
+        std::string line;
+        if (!std::getline(file, line) || line != csv_header()) {
+            SPDLOG_WARN("Baseline file {} has a different format and is ignored, record the baselines again",
+                        file_name);
+            return baselines;
+        }
+
+        while (std::getline(file, line)) {
+            if (line.empty()) continue;
+            std::vector<std::string> fields;
+            std::stringstream stream(line);
+            for (std::string field; std::getline(stream, field, ',');) fields.push_back(field);
+            if (fields.size() != 8 + N_PHASES) {
+                SPDLOG_WARN("Skipping malformed baseline: {}", line);
+                continue;
+            }
+
+            try {
+                ScenarioResult result;
+                result.scenario = fields[0];
+                result.size = fields[1];
+                result.strategy = std::stoi(fields[2]);
+                result.threads = std::stoi(fields[3]);
+                result.particles = std::stoul(fields[4]);
+                result.steps = std::stoul(fields[5]);
+                result.mups = std::stod(fields[6]);
+                result.step_ms = std::stod(fields[7]);
+                for (size_t i = 0; i < N_PHASES; ++i) result.phase_ms[i] = std::stod(fields[8 + i]);
+                baselines.push_back(std::move(result));
+            } catch (const std::exception&) {
+                SPDLOG_WARN("Skipping malformed baseline: {}", line);
+            }
+        }
+        return baselines;
+    }
+
+    void write_baselines(const std::vector<ScenarioResult>& results, const std::string& file_name) {
+        std::ofstream file(file_name);
+        if (!file.is_open()) {
+            SPDLOG_ERROR("Could not open baseline file {}", file_name);
+            return;
+        }
+
+        file << csv_header() << "\n";
+        for (const auto& r : results) {
+            file << fmt::format("{},{},{},{},{},{},{},{}", r.scenario, r.size, r.strategy, r.threads, r.particles,
+                                r.steps, r.mups, r.step_ms);
+            for (const double time : r.phase_ms) file << "," << fmt::format("{}", time);
+            file << "\n";
+        }
+    }
+
+    std::vector<Regression> find_regressions(const ScenarioResult& result, const ScenarioResult& baseline,
+                                             const double threshold) {
+        std::vector<Regression> regressions;
+        if (baseline.mups > 0) {
+            const double change = result.mups / baseline.mups - 1;
+            if (change < -threshold) regressions.push_back({"mups", baseline.mups, result.mups, change});
+        }
+
+        for (size_t i = 0; i < N_PHASES; ++i) {
+            const double base = baseline.phase_ms[i];
+            if (base <= 0 || base < MIN_PHASE_SHARE * baseline.step_ms) continue;
+            const double change = result.phase_ms[i] / base - 1;
+            if (change > threshold) {
+                regressions.push_back({phase_name(static_cast<Phase>(i)), base, result.phase_ms[i], change});
+            }
+        }
+        return regressions;
+    }
+}  // namespace md::core
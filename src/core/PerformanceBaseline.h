@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "StepProfiler.h"
+
+namespace md::core {
+
+    /**
+     * @brief Measurement of one scenario of the performance suite, times in milliseconds.
+     */
+    struct ScenarioResult {
+        std::string scenario;                   ///< Name of the scenario.
+        std::string size;                       ///< Size of the scenario ("S", "M" or "L").
+        int strategy = 0;                       ///< Parallel strategy (0: none, 1: cell lock, 2: spatial).
+        int threads = 1;                        ///< Number of threads.
+        size_t particles = 0;                   ///< Number of particles.
+        size_t steps = 0;                       ///< Number of measured steps.
+        double mups = 0;                        ///< Million particle updates per second.
+        double step_ms = 0;                     ///< Median step time.
+        std::array<double, N_PHASES> phase_ms{};  ///< Median time of each phase per step.
+    };
+
+    /**
+     * @brief A metric of a scenario that got worse than allowed compared to its baseline.
+     */
+    struct Regression {
+        std::string metric;  ///< "mups" or the name of a phase.
+        double baseline;     ///< Value of the baseline.
+        double measured;     ///< Measured value.
+        double change;       ///< Relative change, e.g. -0.2 if the MUPS/s dropped by 20%.
+    };
+
+    /**
+     * @brief Returns the key identifying the baseline of a result: scenario, size, strategy and thread count.
+     * @param result The result.
+     * @return The key.
+     */
+    std::string baseline_key(const ScenarioResult& result);
+
+    /**
+     * @brief Reads baselines written by write_baselines.
+     * @param file_name Path of the file.
+     * @return The baselines, empty if the file does not exist or has a different format.
+     */
+    std::vector<ScenarioResult> read_baselines(const std::string& file_name);
+
+    /**
+     * @brief Writes results as CSV file with one row per scenario, to be used as baselines of later runs.
+     * @param results The results.
+     * @param file_name Path of the file.
+     */
+    void write_baselines(const std::vector<ScenarioResult>& results, const std::string& file_name);
+
+    /**
+     * @brief Compares a result with its baseline.
+     *
+     * The MUPS/s regress if they drop by more than the threshold, a phase regresses if its time grows by more than the
+     * threshold. Phases that take less than 1% of the baseline step time are skipped, their times are dominated by
+     * noise.
+     * @param result The result.
+     * @param baseline The baseline of the same scenario, size, strategy and thread count.
+     * @param threshold Allowed relative change, e.g. 0.1 for 10%.
+     * @return The regressed metrics, empty if there are none.
+     */
+    std::vector<Regression> find_regressions(const ScenarioResult& result, const ScenarioResult& baseline,
+                                             double threshold);
+}  // namespace md::core
@@ -0,0 +1,331 @@
+#include "PerformanceSuite.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <unordered_map>
+
+#include "IntegratorFactory.h"
+#include "PerformanceBaseline.h"
+#include "io/IOStrategy.h"
+#include "io/Logger/Logger.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace md::core {
+    namespace {
+        using env::BoundaryNormal;
+        using env::BoundaryRule;
+        using env::Dimension;
+
+        constexpr const char* SIZES[] = {"S", "M", "L"};
+
+        /**
+         * @brief Sets the simulation parameters shared by all scenarios.
+         */
+        void set_parameters(io::ProgramArguments& args, const double dt, const size_t steps, const double temperature,
+                            const unsigned int temp_adj_freq) {
+            args.dt = dt;
+            args.duration = dt * static_cast<double>(steps);
+            args.write_freq = 0;
+            args.parallel_strategy = 0;
+            args.benchmark = true;
+            args.override = false;
+            args.output_format = io::OutputFormat::XYZ;
+            args.thermostat.init(temperature, temperature, env::Thermostat::INF_TEMP);
+            args.temp_adj_freq = temp_adj_freq;
+        }
+
+        void lj_fluid_3d(io::ProgramArguments& args, const size_t size) {
+            constexpr unsigned int n[] = {12, 24, 40};
+            constexpr size_t steps[] = {400, 100, 40};
+            constexpr double width = 1.1225;
+            set_parameters(args, 0.002, steps[size], 0.7, 50);
+
+            const double extent = n[size] * width;
+            args.env.add_cuboid({width / 2, width / 2, width / 2}, {0, 0, 0}, {n[size], n[size], n[size]}, width, 1, 0,
+                                0, Dimension::THREE);
+            args.env.set_force(env::LennardJones(1, 1, 2.5), 0);
+            args.env.set_grid_constant(2.5);
+            args.boundary.origin = {0, 0, 0};
+            args.boundary.extent = {extent, extent, extent};
+            args.boundary.set_boundary_rule(BoundaryRule::PERIODIC);
+        }
+
+        void gas_2d(io::ProgramArguments& args, const size_t size) {
+            constexpr unsigned int n[] = {40, 120, 256};
+            constexpr size_t steps[] = {400, 100, 40};
+            constexpr double width = 3;
+            set_parameters(args, 0.005, steps[size], 1, 50);
+
+            const double extent = n[size] * width;
+            args.env.set_dimension(Dimension::TWO);
+            args.env.add_cuboid({width / 2, width / 2, 0}, {0, 0, 0}, {n[size], n[size], 1}, width, 1, 0, 0,
+                                Dimension::TWO);
+            args.env.set_force(env::LennardJones(1, 1, 2.5), 0);
+            args.env.set_grid_constant(2.5);
+            args.boundary.origin = {0, 0, 0};
+            args.boundary.extent = {extent, extent, 1};
+            args.boundary.set_boundary_rule(BoundaryRule::VELOCITY_REFLECTION);
+        }
+
+        void nanoflow(io::ProgramArguments& args, const size_t size) {
+            constexpr unsigned int scale_y[] = {1, 2, 3};
+            constexpr unsigned int scale_z[] = {1, 2, 4};
+            constexpr size_t steps[] = {200, 50, 20};
+            set_parameters(args, 0.0005, steps[size], 40, 10);
+
+            const unsigned int sy = scale_y[size];
+            const unsigned int sz = scale_z[size];
+            // stationary walls at both ends of the x-axis, fluid in between
+            args.env.add_cuboid({1, 0.5, 0.5}, {0, 0, 0}, {2, 30 * sy, 12 * sz}, 1, 1, 0, 0, Dimension::THREE,
+                                env::Particle::STATIONARY);
+            args.env.add_cuboid({27.2, 0.5, 0.5}, {0, 0, 0}, {2, 30 * sy, 12 * sz}, 1, 1, 0, 0, Dimension::THREE,
+                                env::Particle::STATIONARY);
+            args.env.add_cuboid({3.2, 0.6, 0.6}, {0, 0, 0}, {20, 25 * sy, 10 * sz}, 1.2, 1, 0, 1, Dimension::THREE);
+            args.env.set_force(env::LennardJones(2, 1.1, 2.75), 0);
+            args.env.set_force(env::LennardJones(1, 1, 2.75), 1);
+            args.env.set_grid_constant(2.75);
+            args.external_forces.push_back(env::Gravity(-0.8, {0, 1, 0}));
+
+            args.boundary.origin = {0, 0, 0};
+            args.boundary.extent = {30, 30.0 * sy, 12.0 * sz};
+            args.boundary.set_boundary_rule(BoundaryRule::PERIODIC);
+            args.boundary.set_boundary_rule(BoundaryRule::OUTFLOW, BoundaryNormal::LEFT);
+            args.boundary.set_boundary_rule(BoundaryRule::OUTFLOW, BoundaryNormal::RIGHT);
+        }
+
+        void membrane(io::ProgramArguments& args, const size_t size) {
+            constexpr unsigned int n[] = {50, 100, 200};
+            constexpr size_t steps[] = {400, 100, 40};
+            constexpr double width = 2.2;
+            set_parameters(args, 0.01, steps[size], env::Thermostat::NO_TEMP, NEVER);
+
+            const double extent = 30 + n[size] * width;
+            args.env.add_membrane({15, 15, 1.5}, {0, 0, 0}, {n[size], n[size], 1}, width, 1, 300, 4.49, 0);
+            args.env.set_force(env::LennardJones(1, 1, 1.1225), 0);
+            args.env.set_grid_constant(4.49);
+            args.external_forces.push_back(env::Gravity(-0.001, {0, 0, 1}));
+            // pulls the same four particles of the membrane upwards for all sizes
+            args.external_forces.emplace_back(vec3{0, 0, 1}, 0.8, env::MarkBox({52.4, 67.8, 0}, {54.82, 70.22, 2}), 0,
+                                              150);
+
+            args.boundary.origin = {0, 0, 0};
+            args.boundary.extent = {extent, extent, 40};
+            args.boundary.set_boundary_rule(BoundaryRule::VELOCITY_REFLECTION);
+        }
+
+        void rayleigh_taylor(io::ProgramArguments& args, const size_t size) {
+            constexpr unsigned int n[] = {16, 30, 50};
+            constexpr unsigned int height[] = {8, 12, 20};
+            constexpr size_t steps[] = {100, 25, 10};
+            constexpr double width = 1.2;
+            set_parameters(args, 0.0005, steps[size], 40, 1000);
+
+            const unsigned int h = height[size];
+            args.env.add_cuboid({0.6, 0.6, 0.6}, {0, 0, 0}, {n[size], h, n[size]}, width, 1, 0, 0, Dimension::THREE);
+            args.env.add_cuboid({0.6, 0.6 + h * width, 0.6}, {0, 0, 0}, {n[size], h, n[size]}, width, 2, 0, 1,
+                                Dimension::THREE);
+            args.env.set_force(env::LennardJones(1, 1.2, 3.6), 0);
+            args.env.set_force(env::LennardJones(1, 1.1, 3.6), 1);
+            args.env.set_grid_constant(3.6);
+            args.external_forces.push_back(env::Gravity(-12.44, {0, 1, 0}));
+
+            args.boundary.origin = {0, 0, 0};
+            args.boundary.extent = {n[size] * width, 2.5 * h * width, n[size] * width};
+            args.boundary.set_boundary_rule(BoundaryRule::PERIODIC);
+            args.boundary.set_boundary_rule(BoundaryRule::REPULSIVE_FORCE, BoundaryNormal::TOP);
+            args.boundary.set_boundary_rule(BoundaryRule::REPULSIVE_FORCE, BoundaryNormal::BOTTOM);
+            args.boundary.set_boundary_force(env::Boundary::LennardJonesForce(1, 1.15));
+        }
+
+        using ScenarioBuilder = void (*)(io::ProgramArguments&, size_t);
+
+        const std::vector<std::pair<std::string, ScenarioBuilder>>& scenarios() {
+            static const std::vector<std::pair<std::string, ScenarioBuilder>> table = {
+                {"lj_fluid_3d", lj_fluid_3d}, {"gas_2d", gas_2d},
+                {"nanoflow", nanoflow},       {"membrane", membrane},
+                {"rayleigh_taylor", rayleigh_taylor},
+            };
+            return table;
+        }
+
+        double median(std::vector<double> values) {
+            if (values.empty()) return 0;
+            std::ranges::sort(values);
+            const size_t mid = values.size() / 2;
+            return values.size() % 2 == 1 ? values[mid] : (values[mid - 1] + values[mid]) / 2;
+        }
+
+        /**
+         * @brief Combines the repetitions of a scenario into one result with the median of each measurement.
+         */
+        ScenarioResult combine(const std::vector<ScenarioResult>& repetitions) {
+            ScenarioResult result = repetitions.front();
+            auto median_of = [&](auto member) {
+                std::vector<double> values;
+                for (const auto& r : repetitions) values.push_back(member(r));
+                return median(values);
+            };
+            result.mups = median_of([](const ScenarioResult& r) { return r.mups; });
+            result.step_ms = median_of([](const ScenarioResult& r) { return r.step_ms; });
+            for (size_t i = 0; i < N_PHASES; ++i) {
+                result.phase_ms[i] = median_of([i](const ScenarioResult& r) { return r.phase_ms[i]; });
+            }
+            return result;
+        }
+    }  // namespace
+
+    const std::vector<std::string>& scenario_names() {
+        static const std::vector<std::string> names = [] {
+            std::vector<std::string> result;
+            for (const auto& [name, builder] : scenarios()) result.push_back(name);
+            return result;
+        }();
+        return names;
+    }
+
+    bool build_scenario(const std::string& name, const std::string& size, io::ProgramArguments& args) {
+        const auto scenario = std::ranges::find(scenarios(), name, &std::pair<std::string, ScenarioBuilder>::first);
+        const auto size_it = std::ranges::find(SIZES, size);
+        if (scenario == scenarios().end() || size_it == std::end(SIZES)) return false;
+
+        scenario->second(args, size_it - std::begin(SIZES));
+        io::build_environment(args);
+        args.thermostat.set_initial_temperature(args.env);
+        return true;
+    }
+
+    std::string default_baseline_file() {
+        char host[256] = {};
+        if (gethostname(host, sizeof(host) - 1) != 0 || host[0] == '\0') return SUITE_BASELINE_DIR "/default.csv";
+        return fmt::format("{}/{}.csv", SUITE_BASELINE_DIR, host);
+    }
+
+    int run_suite(const SuiteOptions& options) {
+        const std::vector<std::string>& names = options.scenarios.empty() ? scenario_names() : options.scenarios;
+        for (const auto& name : names) {
+            if (std::ranges::find(scenario_names(), name) == scenario_names().end()) {
+                SPDLOG_ERROR("Unknown scenario: {}", name);
+                return -1;
+            }
+        }
+        for (const auto& size : options.sizes) {
+            if (std::ranges::find(SIZES, size) == std::end(SIZES)) {
+                SPDLOG_ERROR("Unknown scenario size: {} (expected S, M or L)", size);
+                return -1;
+            }
+        }
+        if (options.repetitions == 0) {
+            SPDLOG_ERROR("The performance suite needs at least one repetition.");
+            return -1;
+        }
+
+#ifdef _OPENMP
+        if (options.threads > 0) omp_set_num_threads(options.threads);
+        const int threads = omp_get_max_threads();
+#else
+        if (options.strategy != 0 || options.threads > 1) {
+            SPDLOG_ERROR("Parallel strategies require the program to be compiled with the -fopenmp flag.");
+            return -1;
+        }
+        const int threads = 1;
+#endif
+
+        const std::string baseline_file = options.baseline.empty() ? default_baseline_file() : options.baseline;
+        std::vector<ScenarioResult> baselines = read_baselines(baseline_file);
+        std::unordered_map<std::string, size_t> baseline_index;
+        for (size_t i = 0; i < baselines.size(); ++i) baseline_index[baseline_key(baselines[i])] = i;
+        if (!options.record && baselines.empty()) {
+            std::cout << "No baselines found in " << baseline_file << ", run with --record to create them" << std::endl;
+        }
+
+        // building the scenarios logs every particle set, which would bury the results
+        const auto log_level = spdlog::get_level();
+
+        std::vector<ScenarioResult> results;
+        int regressions = 0;
+        for (const auto& name : names) {
+            for (const auto& size : options.sizes) {
+                std::vector<ScenarioResult> repetitions;
+                for (unsigned int rep = 0; rep < options.repetitions; ++rep) {
+                    io::ProgramArguments args;
+                    args.strategy_override = options.strategy;
+                    spdlog::set_level(spdlog::level::warn);
+                    build_scenario(name, size, args);
+                    spdlog::set_level(log_level);
+                    // the baselines are measured with the linked cells of the strategy
+                    args.pair_method = env::PairMethod::LINKED_CELLS;
+
+                    const auto simulator = Integrator::create_simulator(args, false);
+                    const auto steps = static_cast<unsigned int>(std::ceil(args.duration / args.dt));
+                    StepProfiler profiler(steps / 10);
+                    simulator->profiled_run(0, args.duration, args.dt, args.temp_adj_freq, profiler);
+
+                    ScenarioResult result;
+                    result.scenario = name;
+                    result.size = size;
+                    result.strategy = args.parallel_strategy;
+                    result.threads = threads;
+                    result.particles = args.env.size(env::Particle::ALIVE | env::Particle::STATIONARY);
+                    result.steps = profiler.measured_steps();
+                    result.mups = profiler.mups();
+                    result.step_ms = profiler.step_summary().p50;
+                    for (size_t i = 0; i < N_PHASES; ++i) {
+                        result.phase_ms[i] = profiler.phase_summary(static_cast<Phase>(i)).p50;
+                    }
+                    repetitions.push_back(std::move(result));
+                }
+                ScenarioResult result = combine(repetitions);
+
+                std::string status = "no baseline";
+                if (options.record) {
+                    status = "recorded";
+                } else if (const auto it = baseline_index.find(baseline_key(result)); it != baseline_index.end()) {
+                    const ScenarioResult& baseline = baselines[it->second];
+                    if (baseline.particles != result.particles) {
+                        status = fmt::format("scenario changed ({} particles in baseline), record it again",
+                                             baseline.particles);
+                    } else {
+                        status = fmt::format("{:+.1f}% MUPS/s", 100 * (result.mups / baseline.mups - 1));
+                        for (const auto& r : find_regressions(result, baseline, options.threshold)) {
+                            status += fmt::format(", REGRESSION {} {:.4g} -> {:.4g} ({:+.1f}%)", r.metric, r.baseline,
+                                                  r.measured, 100 * r.change);
+                            regressions++;
+                        }
+                    }
+                }
+                std::cout << fmt::format("{:<16} {} particles {:>7}, MUPS/s {:>8.3f}, step {:>9.4f} ms: {}\n", name,
+                                         size, result.particles, result.mups, result.step_ms, status);
+                results.push_back(std::move(result));
+            }
+        }
+
+        write_baselines(results, options.report + ".csv");
+        std::cout << "Suite results written to " << options.report << ".csv" << std::endl;
+
+        if (options.record) {
+            // replace the baselines of the recorded runs, keep those of other scenarios, strategies and thread counts
+            for (auto& result : results) {
+                if (const auto it = baseline_index.find(baseline_key(result)); it != baseline_index.end()) {
+                    baselines[it->second] = result;
+                } else {
+                    baselines.push_back(result);
+                }
+            }
+            const auto directory = std::filesystem::path(baseline_file).parent_path();
+            if (!directory.empty()) std::filesystem::create_directories(directory);
+            write_baselines(baselines, baseline_file);
+            std::cout << "Baselines written to " << baseline_file << std::endl;
+            return 0;
+        }
+
+        std::cout << fmt::format("{} regression(s) beyond {:.0f}%", regressions, 100 * options.threshold) << std::endl;
+        return regressions;
+    }
+}  // namespace md::core
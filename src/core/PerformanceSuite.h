@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#define SUITE_BASELINE_DIR "baselines"
+
+namespace md::io {
+    struct ProgramArguments;
+}
+
+namespace md::core {
+
+    /**
+     * @brief Configuration of a run of the performance suite.
+     */
+    struct SuiteOptions {
+        std::vector<std::string> scenarios;              ///< Scenarios to run, all if empty.
+        std::vector<std::string> sizes = {"S", "M", "L"};  ///< Sizes to run.
+        int strategy = 0;                  ///< Parallel strategy (0: none, 1: cell lock, 2: spatial decomposition).
+        int threads = 0;                   ///< Number of threads, the OpenMP default if 0.
+        unsigned int repetitions = 3;      ///< Runs per scenario, the medians of the measurements are compared.
+        std::string baseline;              ///< Baseline file, SUITE_BASELINE_DIR/<host name>.csv if empty.
+        double threshold = 0.1;            ///< Allowed relative change before a metric counts as regression.
+        bool record = false;               ///< Store the results as baselines instead of comparing them.
+        std::string report = "suite";      ///< Base path of the results table, written to <report>.csv.
+    };
+
+    /**
+     * @brief Returns the names of the scenarios of the performance suite.
+     *
+     * - lj_fluid_3d: dense Lennard-Jones fluid in a periodic box.
+     * - gas_2d: sparse two dimensional gas between reflecting walls.
+     * - nanoflow: fluid driven by gravity through a periodic channel between stationary walls.
+     * - membrane: membrane with harmonic bonds pulled up against gravity.
+     * - rayleigh_taylor: two fluids of different type and mass layered under gravity.
+     */
+    const std::vector<std::string>& scenario_names();
+
+    /**
+     * @brief Sets up and builds a scenario of the performance suite. The sizes grow by a factor of about eight in the
+     * number of particles from S to L, the number of steps shrinks accordingly. The strategy override of the arguments
+     * is applied.
+     * @param name Name of the scenario.
+     * @param size Size of the scenario ("S", "M" or "L").
+     * @param args The ProgramArguments that receive the environment and the simulation parameters.
+     * @return "true" if the scenario and size exist, "false" otherwise.
+     */
+    bool build_scenario(const std::string& name, const std::string& size, io::ProgramArguments& args);
+
+    /**
+     * @brief Returns the baseline file of this machine: SUITE_BASELINE_DIR/<host name>.csv.
+     */
+    std::string default_baseline_file();
+
+    /**
+     * @brief Runs the selected scenarios and compares their MUPS/s and phase times with the baselines of the machine.
+     *
+     * Each scenario is run options.repetitions times without output, the medians of the measurements are compared with
+     * the baseline of the same scenario, size, strategy and thread count. The results are written to <report>.csv in
+     * the format of the baseline file. With options.record the results replace the matching baselines instead.
+     * @param options The configuration of the run.
+     * @return The number of regressions, -1 if the options are invalid.
+     */
+    int run_suite(const SuiteOptions& options);
+}  // namespace md::core
@@ -0,0 +1,169 @@
+#include "ScalingSweep.h"
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+
+#include "IntegratorFactory.h"
+#include "io/IOStrategy.h"
+#include "io/Logger/Logger.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace md::core {
+    namespace {
+        /**
+         * @brief Returns the 97.5% quantile of the Student t-distribution, used for two sided 95% intervals.
+         * @param dof Degrees of freedom.
+         */
+        double t_quantile(const size_t dof) {
+            constexpr double table[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                        2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                        2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+            if (dof == 0) return 0;
+            return dof <= std::size(table) ? table[dof - 1] : 1.960;
+        }
+
+        const char* strategy_name(const int strategy) {
+            switch (strategy) {
+                case 1: return "cell_lock";
+                case 2: return "spatial_decomposition";
+                case 3: return "newton3_off";
+                default: return "none";
+            }
+        }
+
+        const char* mode_name(const ScalingOptions::Mode mode) {
+            return mode == ScalingOptions::WEAK ? "weak" : "strong";
+        }
+    }  // namespace
+
+    void summarize(ScalingResult& result) {
+        const auto n = static_cast<double>(result.times.size());
+        if (result.times.empty()) return;
+
+        result.mean = std::accumulate(result.times.begin(), result.times.end(), 0.0) / n;
+        double sum_sq = 0;
+        for (const double t : result.times) sum_sq += (t - result.mean) * (t - result.mean);
+        result.stddev = result.times.size() > 1 ? std::sqrt(sum_sq / (n - 1)) : 0.0;
+        result.ci95 = t_quantile(result.times.size() - 1) * result.stddev / std::sqrt(n);
+    }
+
+    void compare(ScalingResult& result, const ScalingResult& baseline, const ScalingOptions::Mode mode) {
+        // the baseline has a speedup and efficiency of exactly one
+        if (&result == &baseline || result.mean <= 0 || baseline.mean <= 0) return;
+
+        const double ratio = baseline.mean / result.mean;
+        const double thread_ratio = static_cast<double>(result.threads) / baseline.threads;
+        const double rel_error = std::hypot(baseline.ci95 / baseline.mean, result.ci95 / result.mean);
+
+        if (mode == ScalingOptions::WEAK) {
+            result.efficiency = ratio;
+            result.speedup = ratio * thread_ratio;
+        } else {
+            result.speedup = ratio;
+            result.efficiency = ratio / thread_ratio;
+        }
+        result.speedup_ci95 = result.speedup * rel_error;
+        result.efficiency_ci95 = result.efficiency * rel_error;
+    }
+
+    std::vector<ScalingResult> run_scaling_sweep(const ScalingOptions& options) {
+        std::vector<ScalingResult> results;
+        if (options.threads.empty() || options.strategies.empty() || options.repetitions == 0) {
+            SPDLOG_ERROR("Scaling sweep needs at least one thread count, strategy and repetition.");
+            return results;
+        }
+#ifndef _OPENMP
+        for (const int threads : options.threads) {
+            if (threads != 1) {
+                SPDLOG_ERROR("Thread counts other than 1 require the program to be compiled with the -fopenmp flag.");
+                return results;
+            }
+        }
+#endif
+        const int base_threads = options.threads.front();
+        if (options.mode == ScalingOptions::WEAK) {
+            for (const int threads : options.threads) {
+                if (threads % base_threads != 0) {
+                    SPDLOG_ERROR("Weak scaling needs thread counts that are multiples of the first one ({}), got {}.",
+                                 base_threads, threads);
+                    return results;
+                }
+            }
+        }
+
+        // reading the input logs every particle set, which would bury the progress of the sweep
+        const auto log_level = spdlog::get_level();
+
+        for (const int strategy : options.strategies) {
+            for (const int threads : options.threads) {
+                ScalingResult result;
+                result.strategy = strategy;
+                result.threads = threads;
+                result.replicas = options.mode == ScalingOptions::WEAK ? threads / base_threads : 1;
+#ifdef _OPENMP
+                omp_set_num_threads(threads);
+#endif
+                size_t steps = 0;
+                for (unsigned int rep = 0; rep < options.repetitions; ++rep) {
+                    io::ProgramArguments args;
+                    args.stream_input = options.stream_input;
+                    args.strategy_override = strategy;
+                    args.replicas = result.replicas;
+                    spdlog::set_level(spdlog::level::warn);
+                    io::read_file(options.input_file, args);
+                    spdlog::set_level(log_level);
+
+                    // statistics would write files and add work that does not scale with the strategy
+                    args.stats = nullptr;
+                    // the strategies only parallelize the linked cells
+                    args.pair_method = env::PairMethod::LINKED_CELLS;
+                    const auto simulator = Integrator::create_simulator(args, false);
+                    result.particles = args.env.size(env::Particle::ALIVE | env::Particle::STATIONARY);
+                    steps = static_cast<size_t>(std::ceil(args.duration / args.dt));
+                    result.times.push_back(simulator->timed_run(0, args.duration, args.dt, args.temp_adj_freq));
+                }
+                summarize(result);
+                if (result.mean > 0) {
+                    result.mups = static_cast<double>(result.particles * steps) / result.mean / 1e6;
+                }
+
+                std::cout << fmt::format("{:<22} threads {:>3}, replicas {:>3}, particles {:>8}: {:.4f} +- {:.4f} s\n",
+                                         strategy_name(strategy), threads, result.replicas,
+                                         result.particles, result.mean, result.ci95);
+                results.push_back(std::move(result));
+            }
+        }
+
+        // the baseline of a strategy is its first thread count
+        const size_t per_strategy = options.threads.size();
+        for (size_t i = 0; i < results.size(); ++i) {
+            compare(results[i], results[i - i % per_strategy], options.mode);
+        }
+
+        write_scaling_csv(results, options.mode, options.report + ".csv");
+        std::cout << "Scaling results written to " << options.report << ".csv" << std::endl;
+        return results;
+    }
+
+    void write_scaling_csv(const std::vector<ScalingResult>& results, const ScalingOptions::Mode mode,
+                           const std::string& file_name) {
+        std::ofstream file(file_name);
+        if (!file.is_open()) {
+            SPDLOG_ERROR("Could not open scaling report {}", file_name);
+            return;
+        }
+
+        file << "mode,strategy,threads,replicas,particles,repetitions,mean_s,stddev_s,ci95_s,"
+                "speedup,speedup_ci95,efficiency,efficiency_ci95,mups\n";
+        for (const auto& r : results) {
+            file << fmt::format("{},{},{},{},{},{},{},{},{},{},{},{},{},{}\n", mode_name(mode),
+                                strategy_name(r.strategy), r.threads, r.replicas, r.particles, r.times.size(), r.mean,
+                                r.stddev, r.ci95, r.speedup, r.speedup_ci95, r.efficiency, r.efficiency_ci95, r.mups);
+        }
+    }
+}  // namespace md::core
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace md::core {
+
+    /**
+     * @brief Configuration of a scaling sweep.
+     */
+    struct ScalingOptions {
+        enum Mode { STRONG, WEAK };
+
+        Mode mode = STRONG;                       ///< Strong (fixed problem) or weak (problem grows with threads).
+        std::string input_file;                   ///< Scenario to run.
+        std::vector<int> threads = {1};           ///< Thread counts to sweep, the first one is the baseline.
+        std::vector<int> strategies = {0};        ///< Parallel strategies to sweep (0: none, 1: cell lock, 2: spatial).
+        unsigned int repetitions = 5;             ///< Number of runs per point.
+        std::string report = "scaling";           ///< Base path of the results table, written to <report>.csv.
+        bool stream_input = false;                ///< Read xml input in streaming (SAX) mode.
+    };
+
+    /**
+     * @brief Summary of the run times of one point of the sweep, times in seconds.
+     */
+    struct ScalingResult {
+        int strategy = 0;           ///< Parallel strategy.
+        int threads = 1;            ///< Number of threads.
+        unsigned int replicas = 1;  ///< Number of copies of the scenario.
+        size_t particles = 0;       ///< Number of particles.
+        std::vector<double> times;  ///< Run time of each repetition.
+        double mean = 0;            ///< Mean run time.
+        double stddev = 0;          ///< Sample standard deviation of the run times.
+        double ci95 = 0;            ///< Half width of the 95% confidence interval of the mean.
+        double speedup = 1;         ///< Speedup over the baseline thread count of the same strategy.
+        double speedup_ci95 = 0;    ///< Half width of the 95% confidence interval of the speedup.
+        double efficiency = 1;      ///< Parallel efficiency.
+        double efficiency_ci95 = 0; ///< Half width of the 95% confidence interval of the efficiency.
+        double mups = 0;            ///< Million particle updates per second of the mean run.
+    };
+
+    /**
+     * @brief Computes mean, standard deviation and confidence interval of the run times of a point.
+     * @param result The point, its times must be set.
+     */
+    void summarize(ScalingResult& result);
+
+    /**
+     * @brief Computes speedup and parallel efficiency of a point relative to a baseline of the same strategy.
+     *
+     * For strong scaling the speedup is T_base / T and the efficiency the speedup per additional thread. For weak
+     * scaling the work per thread is constant, hence the efficiency is T_base / T and the speedup the efficiency times
+     * the thread ratio. The confidence intervals are propagated from the relative errors of both means.
+     * @param result The point, must be summarized.
+     * @param baseline The point with the baseline thread count, must be summarized.
+     * @param mode The scaling mode.
+     */
+    void compare(ScalingResult& result, const ScalingResult& baseline, ScalingOptions::Mode mode);
+
+    /**
+     * @brief Runs the scenario for every combination of strategy and thread count and writes the results table.
+     *
+     * Every run reads the input file anew, with the parallel strategy overridden and, in weak scaling mode, the
+     * scenario replicated threads / threads[0] times along the x-axis. Runs write no output files.
+     * @param options The configuration of the sweep.
+     * @return The results of all points, in the order of the table.
+     */
+    std::vector<ScalingResult> run_scaling_sweep(const ScalingOptions& options);
+
+    /**
+     * @brief Writes the results of a sweep as CSV table with one row per point.
+     * @param results The results.
+     * @param mode The scaling mode.
+     * @param file_name Path of the file.
+     */
+    void write_scaling_csv(const std::vector<ScalingResult>& results, ScalingOptions::Mode mode,
+                           const std::string& file_name);
+}  // namespace md::core
@@ -7,8 +7,8 @@
 #include "env/Particle.h"
 
 namespace md::core {
-    NanoFlowStatistics::NanoFlowStatistics(const int compute_freq, const int n_bins):
-        Statistics(compute_freq), n_bins(n_bins), writer(n_bins){}
+    NanoFlowStatistics::NanoFlowStatistics(const int compute_freq, const int n_bins, const std::string& file_name):
+        Statistics(compute_freq), n_bins(n_bins), writer(n_bins, file_name){}
 
     void NanoFlowStatistics::compute(const env::Environment& env, double time) {
         const double bin_width = env.extent()[0] / static_cast<double>(n_bins);
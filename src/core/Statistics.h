@@ -2,6 +2,8 @@
 #include "env/Environment.h"
 #include "io/Output/CSVWriter.h"
 
+#define STATISTICS_FILE "statistics.csv"
+
 namespace md::core {
 
     /**
@@ -30,7 +32,13 @@ namespace md::core {
      */
     class NanoFlowStatistics final : public Statistics {
     public:
-        NanoFlowStatistics(int compute_freq, int n_bins);
+        /**
+         * @brief Constructs the nano-scale flow statistics.
+         * @param compute_freq Number of iterations between each statistics calculation.
+         * @param n_bins Number of bins along the x-axis.
+         * @param file_name Path of the csv file the statistics are written to.
+         */
+        NanoFlowStatistics(int compute_freq, int n_bins, const std::string& file_name = STATISTICS_FILE);
 
         /**
          * @brief Computes the nano-scale flow statistics, such as for velocity and density and writes them to a CSV file.
@@ -0,0 +1,376 @@
+#include "StepProfiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+
+#include "io/Logger/Logger.h"
+
+namespace md::core {
+    namespace {
+        /**
+         * @brief Summarizes samples using the nearest-rank method for the percentiles.
+         */
+        StepProfiler::Summary summarize(std::vector<double> samples) {
+            StepProfiler::Summary summary;
+            if (samples.empty()) return summary;
+
+            std::ranges::sort(samples);
+            auto percentile = [&](const double p) {
+                const auto rank = static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(samples.size())));
+                return samples[std::clamp<size_t>(rank, 1, samples.size()) - 1];
+            };
+
+            summary.total = std::accumulate(samples.begin(), samples.end(), 0.0);
+            summary.mean = summary.total / static_cast<double>(samples.size());
+            summary.p50 = percentile(50);
+            summary.p95 = percentile(95);
+            summary.p99 = percentile(99);
+            summary.max = samples.back();
+            return summary;
+        }
+
+        double to_ms(const StepProfiler::clock::duration duration) {
+            return std::chrono::duration<double, std::milli>(duration).count();
+        }
+
+        /**
+         * @brief Metrics derived from the hardware counters of a phase.
+         */
+        struct CounterMetrics {
+            double ipc = 0;              ///< Instructions per cycle.
+            double l1d_per_pair = 0;     ///< L1 data cache misses per pair candidate.
+            double llc_per_pair = 0;     ///< Last level cache misses per pair candidate.
+            double branch_per_pair = 0;  ///< Branch misses per pair candidate.
+            double gflops = 0;           ///< Floating point operations per second, in billions.
+        };
+
+        CounterMetrics derive(const PerfCounters::Values& values, const double time_ms, const size_t pairs) {
+            auto get = [&](const Counter counter) { return values[static_cast<size_t>(counter)]; };
+            auto per_pair = [&](const Counter counter) { return pairs > 0 ? get(counter) / static_cast<double>(pairs) : 0; };
+
+            CounterMetrics metrics;
+            metrics.ipc = get(Counter::CYCLES) > 0 ? get(Counter::INSTRUCTIONS) / get(Counter::CYCLES) : 0;
+            metrics.l1d_per_pair = per_pair(Counter::L1D_MISSES);
+            metrics.llc_per_pair = per_pair(Counter::LLC_MISSES);
+            metrics.branch_per_pair = per_pair(Counter::BRANCH_MISSES);
+            metrics.gflops = time_ms > 0 ? get(Counter::FLOPS) / (time_ms * 1e6) : 0;
+            return metrics;
+        }
+    }  // namespace
+
+    const char* phase_name(const Phase phase) {
+        switch (phase) {
+            case Phase::DRIFT: return "drift";
+            case Phase::MIGRATION: return "migration";
+            case Phase::BOUNDARY: return "boundary";
+            case Phase::PAIR_FORCES: return "pair_forces";
+            case Phase::BONDED_FORCES: return "bonded_forces";
+            case Phase::EXTERNAL_FORCES: return "external_forces";
+            case Phase::KICK: return "kick";
+            case Phase::THERMOSTAT: return "thermostat";
+        }
+        return "unknown";
+    }
+
+    StepProfiler::StepProfiler(const unsigned int warmup_steps) : warmup_steps(warmup_steps) {
+#ifdef MD_PAIR_COUNTERS
+        PairCounters::instance().reset();
+#endif
+    }
+
+    StepProfiler::~StepProfiler() = default;
+
+    bool StepProfiler::enable_counters() {
+        counters = std::make_unique<PerfCounters>();
+        for (size_t i = 0; i < N_PHASES; ++i) {
+            current_counts[i].assign(counters->threads(), {});
+            counter_totals[i].assign(counters->threads(), {});
+        }
+        return counters->any_available();
+    }
+
+    void StepProfiler::begin_phase() {
+        if (counters) counters->read(phase_start);
+    }
+
+    void StepProfiler::record_phase(const Phase phase, const clock::duration duration) {
+        current[static_cast<size_t>(phase)] += to_ms(duration);
+
+        if (counters) {
+            counters->read(phase_end);
+            auto& counts = current_counts[static_cast<size_t>(phase)];
+            for (size_t t = 0; t < counts.size(); ++t) {
+                for (size_t c = 0; c < N_COUNTERS; ++c) {
+                    counts[t][c] += phase_end[t][c] - phase_start[t][c];
+                }
+            }
+        }
+    }
+
+    void StepProfiler::end_step(const clock::duration duration, const size_t particle_updates,
+                                const size_t pair_candidates) {
+        const bool measured = steps_seen++ >= warmup_steps;
+#ifdef MD_PAIR_COUNTERS
+        PairCounters::instance().end_step(measured);
+#endif
+        if (measured) {
+            for (size_t i = 0; i < N_PHASES; ++i) {
+                phase_times[i].push_back(current[i]);
+            }
+            step_times.push_back(to_ms(duration));
+            update_count += particle_updates;
+            pair_count += pair_candidates;
+
+            for (size_t i = 0; counters && i < N_PHASES; ++i) {
+                for (size_t t = 0; t < counter_totals[i].size(); ++t) {
+                    for (size_t c = 0; c < N_COUNTERS; ++c) counter_totals[i][t][c] += current_counts[i][t][c];
+                }
+            }
+        }
+        current.fill(0);
+        for (auto& counts : current_counts) {
+            for (auto& values : counts) values.fill(0);
+        }
+    }
+
+    PerfCounters::Values StepProfiler::phase_counters(const Phase phase, const int thread) const {
+        PerfCounters::Values values{};
+        const auto& totals = counter_totals[static_cast<size_t>(phase)];
+        for (size_t t = 0; t < totals.size(); ++t) {
+            if (thread >= 0 && static_cast<size_t>(thread) != t) continue;
+            for (size_t c = 0; c < N_COUNTERS; ++c) values[c] += totals[t][c];
+        }
+        return values;
+    }
+
+    StepProfiler::Summary StepProfiler::phase_summary(const Phase phase) const {
+        return summarize(phase_times[static_cast<size_t>(phase)]);
+    }
+
+    StepProfiler::Summary StepProfiler::step_summary() const { return summarize(step_times); }
+
+    double StepProfiler::mups() const {
+        const double seconds = step_summary().total / 1000.0;
+        return seconds > 0 ? static_cast<double>(update_count) / seconds / 1e6 : 0.0;
+    }
+
+    void StepProfiler::print() const {
+        const Summary step = step_summary();
+        // Using std::cout instead of logging, as logging should be disabled during benchmarking.
+        std::cout << fmt::format("Measured steps: {} (warm-up: {})\n", measured_steps(), steps_seen - measured_steps());
+        std::cout << fmt::format("Total execution time: {:.3f} ms\n", step.total);
+        std::cout << fmt::format("Step time [ms]: mean {:.4f}, p50 {:.4f}, p95 {:.4f}, p99 {:.4f}, max {:.4f}\n",
+                                 step.mean, step.p50, step.p95, step.p99, step.max);
+        for (size_t i = 0; i < N_PHASES; ++i) {
+            const Summary phase = phase_summary(static_cast<Phase>(i));
+            const double share = step.total > 0 ? 100.0 * phase.total / step.total : 0.0;
+            std::cout << fmt::format("  {:<16} mean {:.4f} ms, p99 {:.4f} ms ({:.1f}%)\n",
+                                     phase_name(static_cast<Phase>(i)), phase.mean, phase.p99, share);
+        }
+        std::cout << fmt::format("Particle updates: {}\n", update_count);
+        std::cout << fmt::format("Pair candidates: {}\n", pair_count);
+        std::cout << fmt::format("MUPS/s: {:.3f}", mups()) << std::endl;
+
+#ifdef MD_PAIR_COUNTERS
+        const PairCounters& pairs = PairCounters::instance();
+        const PairCounters::Counts total = pairs.total();
+        double min_rate = total.candidates > 0 ? 1 : 0, max_rate = 0;
+        for (const auto& step_counts : pairs.step_counts()) {
+            min_rate = std::min(min_rate, step_counts.hit_rate());
+            max_rate = std::max(max_rate, step_counts.hit_rate());
+        }
+        std::cout << fmt::format("Pair counters: {} candidates, {} within cutoff ({:.1f}%, per step {:.1f}-{:.1f}%), "
+                                 "{} skipped\n",
+                                 total.candidates, total.within_cutoff, 100 * total.hit_rate(), 100 * min_rate,
+                                 100 * max_rate, total.skipped);
+        for (size_t b = 0; b < PAIR_COUNTER_BUCKETS; ++b) {
+            const auto& counts = pairs.bucket_counts()[b];
+            if (counts.candidates == 0) continue;
+            const auto [low, high] = PairCounters::bucket_range(b);
+            std::cout << fmt::format("  cell occupancy {:>4}-{:<4} {:>14} candidates, {:5.1f}% within cutoff, {} skipped\n",
+                                     low, high > 0 ? std::to_string(high) : "", counts.candidates,
+                                     100 * counts.hit_rate(), counts.skipped);
+        }
+        std::cout.flush();
+#endif
+
+        if (!counters) return;
+        if (!counters->any_available()) {
+            std::cout << "Hardware counters: not available (check /proc/sys/kernel/perf_event_paranoid)" << std::endl;
+            return;
+        }
+        std::cout << fmt::format("Hardware counters ({} threads{}):\n", counters->threads(),
+                                 counters->missing().empty() ? "" : ", missing: " + counters->missing());
+        for (size_t i = 0; i < N_PHASES; ++i) {
+            const auto phase = static_cast<Phase>(i);
+            const CounterMetrics m = derive(phase_counters(phase), phase_summary(phase).total, pair_count);
+            std::cout << fmt::format(
+                "  {:<16} IPC {:.2f}, misses/pair: L1D {:.3f}, LLC {:.4f}, branch {:.3f}, GFLOP/s {:.2f}\n",
+                phase_name(phase), m.ipc, m.l1d_per_pair, m.llc_per_pair, m.branch_per_pair, m.gflops);
+            if (counters->threads() < 2) continue;
+            std::string ipc;
+            for (size_t t = 0; t < counters->threads(); ++t) {
+                ipc += fmt::format(" {:.2f}", derive(phase_counters(phase, static_cast<int>(t)), 0, 0).ipc);
+            }
+            std::cout << fmt::format("  {:<16} IPC per thread:{}\n", "", ipc);
+        }
+        std::cout.flush();
+    }
+
+    void StepProfiler::write_json(const std::string& file_name) const {
+        std::ofstream file(file_name);
+        if (!file.is_open()) {
+            SPDLOG_ERROR("Could not open benchmark report {}", file_name);
+            return;
+        }
+
+        auto summary_json = [](const Summary& s) {
+            return fmt::format(R"({{"total_ms": {}, "mean_ms": {}, "p50_ms": {}, "p95_ms": {}, "p99_ms": {}, "max_ms": {}}})",
+                               s.total, s.mean, s.p50, s.p95, s.p99, s.max);
+        };
+
+        file << "{\n";
+        file << fmt::format("  \"warmup_steps\": {},\n", steps_seen - measured_steps());
+        file << fmt::format("  \"measured_steps\": {},\n", measured_steps());
+        file << fmt::format("  \"particle_updates\": {},\n", update_count);
+        file << fmt::format("  \"pair_candidates\": {},\n", pair_count);
+        file << fmt::format("  \"mups\": {},\n", mups());
+#ifdef MD_PAIR_COUNTERS
+        const PairCounters& pairs = PairCounters::instance();
+        const PairCounters::Counts total = pairs.total();
+        file << fmt::format(R"(  "pair_counters": {{"candidates": {}, "within_cutoff": {}, "skipped": {}, )"
+                            R"("hit_rate": {}, "buckets": [)",
+                            total.candidates, total.within_cutoff, total.skipped, total.hit_rate());
+        for (size_t b = 0; b < PAIR_COUNTER_BUCKETS; ++b) {
+            const auto& counts = pairs.bucket_counts()[b];
+            const auto [low, high] = PairCounters::bucket_range(b);
+            file << fmt::format(R"({}{{"min_occupancy": {}, "max_occupancy": {}, "candidates": {}, )"
+                                R"("within_cutoff": {}, "skipped": {}}})",
+                                b > 0 ? ", " : "", low, high > 0 ? std::to_string(high) : "null", counts.candidates,
+                                counts.within_cutoff, counts.skipped);
+        }
+        file << "]},\n";
+#endif
+        file << fmt::format("  \"step\": {},\n", summary_json(step_summary()));
+        file << "  \"phases\": {\n";
+        for (size_t i = 0; i < N_PHASES; ++i) {
+            const auto phase = static_cast<Phase>(i);
+            file << fmt::format("    \"{}\": {}{}\n", phase_name(phase), summary_json(phase_summary(phase)),
+                                i + 1 < N_PHASES ? "," : "");
+        }
+        file << (counters ? "  },\n" : "  }\n");
+        if (counters) write_counters_json(file);
+        file << "}\n";
+    }
+
+    void StepProfiler::write_counters_json(std::ostream& file) const {
+        // counters that could not be opened are written as null
+        auto counters_json = [&](const PerfCounters::Values& values) {
+            std::string json;
+            for (size_t c = 0; c < N_COUNTERS; ++c) {
+                const auto counter = static_cast<Counter>(c);
+                json += fmt::format("\"{}\": {}, ", counter_name(counter),
+                                    counters->available(counter) ? fmt::format("{}", values[c]) : "null");
+            }
+            return json;
+        };
+        auto metrics_json = [&](const CounterMetrics& m) {
+            return fmt::format(R"("ipc": {}, "l1d_misses_per_pair": {}, "llc_misses_per_pair": {}, )"
+                               R"("branch_misses_per_pair": {}, "gflops": {})",
+                               m.ipc, m.l1d_per_pair, m.llc_per_pair, m.branch_per_pair, m.gflops);
+        };
+
+        file << "  \"counters\": {\n";
+        file << fmt::format("    \"threads\": {},\n", counters->threads());
+        file << "    \"phases\": {\n";
+        for (size_t i = 0; i < N_PHASES; ++i) {
+            const auto phase = static_cast<Phase>(i);
+            const double time = phase_summary(phase).total;
+            const auto total = phase_counters(phase);
+            file << fmt::format("      \"{}\": {{{}{}, \"threads\": [", phase_name(phase), counters_json(total),
+                                metrics_json(derive(total, time, pair_count)));
+            for (size_t t = 0; t < counters->threads(); ++t) {
+                const auto values = phase_counters(phase, static_cast<int>(t));
+                file << fmt::format("{}{{{}{}}}", t > 0 ? ", " : "", counters_json(values),
+                                    metrics_json(derive(values, time, pair_count)));
+            }
+            file << fmt::format("]}}{}\n", i + 1 < N_PHASES ? "," : "");
+        }
+        file << "    }\n  }\n";
+    }
+
+    void StepProfiler::write_csv(const std::string& file_name) const {
+        std::ofstream file(file_name);
+        if (!file.is_open()) {
+            SPDLOG_ERROR("Could not open benchmark report {}", file_name);
+            return;
+        }
+
+        auto row = [&](const std::string& name, const Summary& s) {
+            file << fmt::format("{},{},{},{},{},{},{}\n", name, s.total, s.mean, s.p50, s.p95, s.p99, s.max);
+        };
+
+        file << "phase,total_ms,mean_ms,p50_ms,p95_ms,p99_ms,max_ms\n";
+        for (size_t i = 0; i < N_PHASES; ++i) {
+            row(phase_name(static_cast<Phase>(i)), phase_summary(static_cast<Phase>(i)));
+        }
+        row("step", step_summary());
+    }
+
+    void StepProfiler::write_counters_csv(const std::string& file_name) const {
+        if (!counters) return;
+        std::ofstream file(file_name);
+        if (!file.is_open()) {
+            SPDLOG_ERROR("Could not open benchmark report {}", file_name);
+            return;
+        }
+
+        file << "phase,thread";
+        for (size_t c = 0; c < N_COUNTERS; ++c) file << ',' << counter_name(static_cast<Counter>(c));
+        file << ",ipc,l1d_misses_per_pair,llc_misses_per_pair,branch_misses_per_pair,gflops\n";
+
+        for (size_t i = 0; i < N_PHASES; ++i) {
+            const auto phase = static_cast<Phase>(i);
+            const double time = phase_summary(phase).total;
+            // thread -1 is the sum over all threads
+            for (int t = -1; t < static_cast<int>(counters->threads()); ++t) {
+                const auto values = phase_counters(phase, t);
+                file << phase_name(phase) << ',' << (t < 0 ? "all" : std::to_string(t));
+                for (size_t c = 0; c < N_COUNTERS; ++c) {
+                    file << ',';
+                    if (counters->available(static_cast<Counter>(c))) file << fmt::format("{}", values[c]);
+                }
+                const CounterMetrics m = derive(values, time, pair_count);
+                file << fmt::format(",{},{},{},{},{}\n", m.ipc, m.l1d_per_pair, m.llc_per_pair, m.branch_per_pair,
+                                    m.gflops);
+            }
+        }
+    }
+
+    void StepProfiler::write_pairs_csv([[maybe_unused]] const std::string& file_name) const {
+#ifdef MD_PAIR_COUNTERS
+        std::ofstream file(file_name);
+        if (!file.is_open()) {
+            SPDLOG_ERROR("Could not open benchmark report {}", file_name);
+            return;
+        }
+
+        const PairCounters& pairs = PairCounters::instance();
+        file << "scope,index,min_occupancy,max_occupancy,candidates,within_cutoff,skipped,hit_rate\n";
+        for (size_t i = 0; i < pairs.step_counts().size(); ++i) {
+            const auto& counts = pairs.step_counts()[i];
+            file << fmt::format("step,{},,,{},{},{},{}\n", i, counts.candidates, counts.within_cutoff, counts.skipped,
+                                counts.hit_rate());
+        }
+        for (size_t b = 0; b < PAIR_COUNTER_BUCKETS; ++b) {
+            const auto& counts = pairs.bucket_counts()[b];
+            const auto [low, high] = PairCounters::bucket_range(b);
+            file << fmt::format("bucket,{},{},{},{},{},{},{}\n", b, low, high > 0 ? std::to_string(high) : "",
+                                counts.candidates, counts.within_cutoff, counts.skipped, counts.hit_rate());
+        }
+#endif
+    }
+}  // namespace md::core
@@ -0,0 +1,235 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "PairCounters.h"
+#include "PerfCounters.h"
+#include "Trace.h"
+
+namespace md::core {
+
+    /**
+     * @brief Enumeration of the phases of a simulation step.
+     */
+    enum class Phase : uint8_t {
+        DRIFT,            ///< Position update and force reset.
+        MIGRATION,        ///< Moving particles between grid cells.
+        BOUNDARY,         ///< Application of the boundary conditions.
+        PAIR_FORCES,      ///< Short range pair interactions over the linked cells.
+        BONDED_FORCES,    ///< Bonds between specific particles.
+        EXTERNAL_FORCES,  ///< Constant external forces.
+        KICK,             ///< Velocity update.
+        THERMOSTAT,       ///< Temperature adjustment.
+    };
+
+    constexpr size_t N_PHASES = 8;
+
+    /**
+     * @brief Returns the name of a phase as used in the benchmark reports.
+     * @param phase The phase.
+     * @return The name of the phase.
+     */
+    const char* phase_name(Phase phase);
+
+    /**
+     * @brief Records the time spent in each phase of every simulation step.
+     *
+     * Samples of the first warmup_steps steps are discarded, so that cache and allocation effects at the start of a run
+     * do not distort the results. The recorded samples are summarized as mean and percentiles and can be written as
+     * JSON or CSV report.
+     */
+    class StepProfiler {
+       public:
+        using clock = std::chrono::steady_clock;
+
+        /**
+         * @brief Summary of the samples of one phase (or of the whole step), times in milliseconds.
+         */
+        struct Summary {
+            double total = 0;  ///< Sum of all samples.
+            double mean = 0;   ///< Mean of the samples.
+            double p50 = 0;    ///< Median.
+            double p95 = 0;    ///< 95th percentile.
+            double p99 = 0;    ///< 99th percentile.
+            double max = 0;    ///< Largest sample.
+        };
+
+        /**
+         * @brief Constructs a StepProfiler.
+         * @param warmup_steps Number of steps at the start whose samples are discarded.
+         */
+        explicit StepProfiler(unsigned int warmup_steps = 0);
+        ~StepProfiler();
+
+        /**
+         * @brief Starts reading hardware performance counters at the start and end of each phase.
+         * @return "true" if at least one counter is available, "false" otherwise.
+         */
+        bool enable_counters();
+
+        /**
+         * @brief Marks the start of a phase, reads the hardware counters if enabled.
+         */
+        void begin_phase();
+
+        /**
+         * @brief Adds the duration of a phase to the current step.
+         * @param phase The phase.
+         * @param duration The time spent in the phase.
+         */
+        void record_phase(Phase phase, clock::duration duration);
+
+        /**
+         * @brief Finishes the current step.
+         * @param duration The time spent in the whole step.
+         * @param particle_updates Number of particles updated during the step.
+         * @param pair_candidates Number of particle pairs considered for the pair forces during the step.
+         */
+        void end_step(clock::duration duration, size_t particle_updates, size_t pair_candidates);
+
+        /**
+         * @brief Summarizes the samples of a phase.
+         * @param phase The phase.
+         * @return The summary.
+         */
+        [[nodiscard]] Summary phase_summary(Phase phase) const;
+
+        /**
+         * @brief Summarizes the samples of the whole steps.
+         * @return The summary.
+         */
+        [[nodiscard]] Summary step_summary() const;
+
+        /**
+         * @brief Returns the number of steps whose samples were recorded (warm-up steps excluded).
+         */
+        [[nodiscard]] size_t measured_steps() const { return step_times.size(); }
+
+        /**
+         * @brief Returns the number of particle updates per second of the measured steps, in millions.
+         */
+        [[nodiscard]] double mups() const;
+
+        /**
+         * @brief Returns the number of pair candidates of the measured steps.
+         */
+        [[nodiscard]] size_t pair_candidates() const { return pair_count; }
+
+        /**
+         * @brief Returns the number of particle updates of the measured steps.
+         */
+        [[nodiscard]] size_t particle_updates() const { return update_count; }
+
+        /**
+         * @brief Returns whether a hardware counter is enabled and could be opened.
+         * @param counter The counter.
+         */
+        [[nodiscard]] bool counter_available(const Counter counter) const {
+            return counters && counters->available(counter);
+        }
+
+        /**
+         * @brief Returns the hardware counters of a phase summed over the measured steps.
+         * @param phase The phase.
+         * @param thread Index of the OpenMP thread, all threads are summed up if negative.
+         * @return The counter values, all zero if counters are not enabled.
+         */
+        [[nodiscard]] PerfCounters::Values phase_counters(Phase phase, int thread = -1) const;
+
+        /**
+         * @brief Prints a human readable summary to the standard output.
+         */
+        void print() const;
+
+        /**
+         * @brief Writes the report as JSON file.
+         * @param file_name Path of the file.
+         */
+        void write_json(const std::string& file_name) const;
+
+        /**
+         * @brief Writes the report as CSV file with one row per phase and one for the whole step.
+         * @param file_name Path of the file.
+         */
+        void write_csv(const std::string& file_name) const;
+
+        /**
+         * @brief Writes the hardware counters as CSV file with one row per phase and thread. Does nothing if counters
+         * are not enabled.
+         * @param file_name Path of the file.
+         */
+        void write_counters_csv(const std::string& file_name) const;
+
+        /**
+         * @brief Writes the pair counters as CSV file with one row per measured step and one per occupancy bucket.
+         * Does nothing unless compiled with MD_PAIR_COUNTERS.
+         * @param file_name Path of the file.
+         */
+        void write_pairs_csv(const std::string& file_name) const;
+
+       private:
+        /**
+         * @brief Writes the hardware counters as "counters" member of the JSON report.
+         * @param file The stream of the JSON report.
+         */
+        void write_counters_json(std::ostream& file) const;
+
+        unsigned int warmup_steps;                           ///< Number of steps to discard.
+        unsigned int steps_seen = 0;                         ///< Number of steps ended so far, including warm-up.
+        std::array<double, N_PHASES> current{};              ///< Phase times of the running step in ms.
+        std::array<std::vector<double>, N_PHASES> phase_times;  ///< Phase times of the measured steps in ms.
+        std::vector<double> step_times;                      ///< Times of the measured steps in ms.
+        size_t update_count = 0;                             ///< Particle updates of the measured steps.
+        size_t pair_count = 0;                               ///< Pair candidates of the measured steps.
+
+        std::unique_ptr<PerfCounters> counters;              ///< Hardware counters, null if not enabled.
+        std::vector<PerfCounters::Values> phase_start;       ///< Counter values at the start of the running phase.
+        std::vector<PerfCounters::Values> phase_end;         ///< Counter values at the end of the running phase.
+        std::array<std::vector<PerfCounters::Values>, N_PHASES> current_counts;  ///< Counts of the running step.
+        std::array<std::vector<PerfCounters::Values>, N_PHASES> counter_totals;  ///< Counts of the measured steps.
+    };
+
+    /**
+     * @brief Measures the time of a scope and adds it to a phase of a StepProfiler and/or stores it in milliseconds.
+     * Does nothing if neither is given. With MD_TRACE, the phase is recorded in the trace as well.
+     */
+    class PhaseTimer {
+       public:
+        PhaseTimer(StepProfiler* profiler, const Phase phase, double* last_ms = nullptr)
+            : profiler(profiler),
+              phase(phase),
+              last_ms(last_ms)
+#ifdef MD_TRACE
+              , trace(phase_name(phase))
+#endif
+        {
+            if (profiler) profiler->begin_phase();
+            if (profiler || last_ms) start = StepProfiler::clock::now();
+        }
+
+        ~PhaseTimer() {
+            if (!profiler && !last_ms) return;
+            const auto duration = StepProfiler::clock::now() - start;
+            if (profiler) profiler->record_phase(phase, duration);
+            if (last_ms) *last_ms = std::chrono::duration<double, std::milli>(duration).count();
+        }
+
+        PhaseTimer(const PhaseTimer&) = delete;
+        PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+       private:
+        StepProfiler* profiler;
+        Phase phase;
+        double* last_ms;
+        StepProfiler::clock::time_point start{};
+#ifdef MD_TRACE
+        TraceScope trace;
+#endif
+    };
+}  // namespace md::core
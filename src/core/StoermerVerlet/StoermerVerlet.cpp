@@ -4,21 +4,8 @@
 
 namespace md::Integrator {
 
-    void StoermerVerlet::simulation_step(const unsigned step, const double dt) {
-
-        // update position
-        for (auto &p: env.particles()) {
-            p.update_position(dt * p.velocity + pow(dt, 2) / (2 * p.mass) * p.force);
-            p.update_grid();
-            p.reset_force();
-        }
-
-
-        for (auto &particle: env.particles(env::GridCell::BOUNDARY | env::GridCell::OUTSIDE)) {
-            env.apply_boundary(particle);
-        }
-
-        // calculate forces
+    template <int DIM>
+    void StoermerVerlet<DIM>::compute_pair_forces() {
         for (auto &cell_pair: env.linked_cells()) {
 
             // cells are equal iterate over all unique pairs
@@ -28,7 +15,7 @@ namespace md::Integrator {
                     for (auto it2 = std::next(it1); it2 != particles.end(); ++it2) {
                         env::Particle *p1 = *it1;
                         env::Particle *p2 = *it2;
-                        vec3 new_F = env.force(*p1, *p2, cell_pair);
+                        vec3 new_F = env.force<DIM>(*p1, *p2, cell_pair);
                         p2->force = p2->force + new_F;
                         p1->force = p1->force - new_F;
                     }
@@ -38,32 +25,26 @@ namespace md::Integrator {
             else {
                 for (auto *p1: cell_pair.cell1.particles) {
                     for (auto *p2: cell_pair.cell2.particles) {
-                        vec3 new_F = env.force(*p1, *p2, cell_pair);
+                        vec3 new_F = env.force<DIM>(*p1, *p2, cell_pair);
                         p2->force = p2->force + new_F;
                         p1->force = p1->force - new_F;
                     }
                 }
             }
         }
+    }
 
+    template <int DIM>
+    void StoermerVerlet<DIM>::drift(const double dt) {
+        drift_dim<DIM>(dt);
+    }
 
-
-        // apply constant forces
-        for (auto &f: external_forces) {
-            for (const size_t id: f.marked_particles()) {
-                f.apply_force(env[id], dt * step);
-            }
-        }
-
-        // update velocities
-        for (auto &p: env.particles()) {
-            p.velocity = p.velocity + dt / 2 / p.mass * (p.force + p.old_force);
-        }
-
-        // apply thermostat
-        if (step % temp_adjust_freq == 0) {
-            thermostat.adjust_temperature(env);
-        }
+    template <int DIM>
+    void StoermerVerlet<DIM>::kick(const double dt) {
+        kick_dim<DIM>(dt);
     }
 
+    template class StoermerVerlet<2>;
+    template class StoermerVerlet<3>;
+
 }  // namespace md::Integrator
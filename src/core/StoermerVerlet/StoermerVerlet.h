@@ -6,19 +6,39 @@ namespace md::Integrator {
 
     /**
      * @brief Implements the calculation of Stoermer-Verlet.
+     * @tparam DIM The number of dimensions of the kernels, 2 or 3 (default: 3).
      */
+    template <int DIM = 3>
     class StoermerVerlet final : public IntegratorBase {
        public:
         using IntegratorBase::IntegratorBase;
 
        private:
        
-         /**
-         * @brief Performs a single step of the Stoermer-Verlet.
-         * @param step
+        /**
+         * @brief Computes the pair forces of all linked cells sequentially.
+         */
+        void compute_pair_forces() override;
+
+        /**
+         * @brief Updates the positions of the particles along the first DIM axes and resets their forces.
+         * @param dt Δt The time increment for each simulation step.
+         */
+        void drift(double dt) override;
+
+        /**
+         * @brief Updates the velocities of the particles along the first DIM axes.
          * @param dt Δt The time increment for each simulation step.
          */
-        void simulation_step(unsigned step, double dt) override;
+        void kick(double dt) override;
     };
 
+    /**
+     * @brief Deduces the 3D kernels if the integrator is constructed without template arguments.
+     */
+    StoermerVerlet(env::Environment&, std::unique_ptr<io::OutputWriterBase> = nullptr,
+                   std::unique_ptr<io::CheckpointWriter> = nullptr, const env::Thermostat& = env::Thermostat(),
+                   const std::vector<env::ConstantForce>& = {}, std::unique_ptr<core::Statistics> = nullptr)
+        -> StoermerVerlet<>;
+
 }  // namespace md::Integrator
@@ -6,7 +6,9 @@ namespace md::Integrator {
 
     /**
      * @brief Implements the calculation of Stoermer-Verlet using cell lock as parallelization strategy.
+     * @tparam DIM The number of dimensions of the kernels, 2 or 3 (default: 3).
      */
+    template <int DIM = 3>
     class StoermerVerletCellLock final : public IntegratorBase {
     public:
         using IntegratorBase::IntegratorBase;
@@ -14,11 +16,42 @@ namespace md::Integrator {
     private:
 
         /**
-        * @brief Performs a single step of the Stoermer-Verlet, with cell locking.
-        * @param step
+        * @brief Updates the positions of the particles along the first DIM axes and resets their forces.
         * @param dt Δt The time increment for each simulation step.
         */
-        void simulation_step(unsigned step, double dt) override;
+        void drift(double dt) override;
+
+        /**
+        * @brief Computes the pair forces of all linked cells in parallel, using cell locking.
+        */
+        void compute_pair_forces() override;
+
+        /**
+        * @brief Computes the bonded forces in parallel.
+        * @param kinds The env::BondList::Flags to evaluate.
+        */
+        void compute_bonded_forces(uint8_t kinds) override;
+
+        /**
+        * @brief Applies the constant external forces in parallel.
+        * @param step The current iteration.
+        * @param dt Δt The time increment for each simulation step.
+        */
+        void apply_external_forces(unsigned step, double dt) override;
+
+        /**
+        * @brief Updates the velocities of all alive particles in parallel.
+        * @param dt Δt The time increment for each simulation step.
+        */
+        void kick(double dt) override;
     };
 
-}  // namespace md::Integrator
\ No newline at end of file
+    /**
+     * @brief Deduces the 3D kernels if the integrator is constructed without template arguments.
+     */
+    StoermerVerletCellLock(env::Environment&, std::unique_ptr<io::OutputWriterBase> = nullptr,
+                           std::unique_ptr<io::CheckpointWriter> = nullptr, const env::Thermostat& = env::Thermostat(),
+                           const std::vector<env::ConstantForce>& = {}, std::unique_ptr<core::Statistics> = nullptr)
+        -> StoermerVerletCellLock<>;
+
+}  // namespace md::Integrator
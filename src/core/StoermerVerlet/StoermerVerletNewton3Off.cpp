@@ -0,0 +1,70 @@
+#include "StoermerVerletNewton3Off.h"
+
+#include "core/Trace.h"
+#include "utils/ArrayUtils.h"
+
+namespace md::Integrator {
+
+    template <int DIM>
+    void StoermerVerletNewton3Off<DIM>::compute_pair_forces() {
+        using clock = core::LoadMonitor::clock;
+        core::LoadMonitor *const monitor = load_monitor.get();
+        if (monitor) monitor->begin_region();
+
+        // the shells are built on first use, outside of the parallel region
+        const auto &shells = env.cell_shells();
+
+#pragma omp parallel
+        {
+            TRACE_SCOPE("cell_shells");
+            const auto start = monitor ? clock::now() : clock::time_point{};
+
+#pragma omp for schedule(dynamic) nowait
+            for (size_t i = 0; i < shells.size(); ++i) {
+                for (const auto &cell_pair: shells[i]) {
+                    // only the particles of cell1, the cell owning the shell, are written to
+                    for (auto *p1: cell_pair.cell1.particles) {
+                        vec3 force{};
+                        for (auto *p2: cell_pair.cell2.particles) {
+                            if (p1 == p2) continue;
+                            force = force - env.force<DIM>(*p1, *p2, cell_pair);
+                        }
+                        p1->force = p1->force + force;
+                    }
+                }
+            }
+            if (monitor) monitor->thread_done(start);
+        }
+        if (monitor) monitor->end_region();
+    }
+
+    template <int DIM>
+    void StoermerVerletNewton3Off<DIM>::compute_bonded_forces(const uint8_t kinds) {
+        env.apply_bonded_forces(true, kinds);
+    }
+
+    template <int DIM>
+    void StoermerVerletNewton3Off<DIM>::apply_external_forces(const unsigned step, const double dt) {
+        for (auto &f: external_forces) {
+            const std::vector<size_t> marked_particles = f.marked_particles();
+#pragma omp parallel for
+            for (size_t i = 0; i < marked_particles.size(); ++i) {
+                f.apply_force(env[marked_particles[i]], dt * step);
+            }
+        }
+    }
+
+    template <int DIM>
+    void StoermerVerletNewton3Off<DIM>::kick(const double dt) {
+        kick_dim<DIM>(dt, true);
+    }
+
+    template <int DIM>
+    void StoermerVerletNewton3Off<DIM>::drift(const double dt) {
+        drift_dim<DIM>(dt);
+    }
+
+    template class StoermerVerletNewton3Off<2>;
+    template class StoermerVerletNewton3Off<3>;
+
+} // namespace md::Integrator
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "core/IntegratorBase.h"
+
+namespace md::Integrator {
+
+    /**
+     * @brief Implements the calculation of Stoermer-Verlet without Newton's third law as parallelization strategy.
+     * Each thread evaluates the full neighbor shell of its cells and only writes to the particles of these cells, which
+     * doubles the pair evaluations but needs no locks or sequential block sets.
+     * @tparam DIM The number of dimensions of the kernels, 2 or 3 (default: 3).
+     */
+    template <int DIM = 3>
+    class StoermerVerletNewton3Off final : public IntegratorBase {
+    public:
+        using IntegratorBase::IntegratorBase;
+
+    private:
+
+        /**
+        * @brief Updates the positions of the particles along the first DIM axes and resets their forces.
+        * @param dt Δt The time increment for each simulation step.
+        */
+        void drift(double dt) override;
+
+        /**
+        * @brief Computes the pair forces of all cell shells in parallel, each pair is evaluated for both particles.
+        */
+        void compute_pair_forces() override;
+
+        /**
+        * @brief Computes the bonded forces in parallel.
+        * @param kinds The env::BondList::Flags to evaluate.
+        */
+        void compute_bonded_forces(uint8_t kinds) override;
+
+        /**
+        * @brief Applies the constant external forces in parallel.
+        * @param step The current iteration.
+        * @param dt Δt The time increment for each simulation step.
+        */
+        void apply_external_forces(unsigned step, double dt) override;
+
+        /**
+        * @brief Updates the velocities of all alive particles in parallel.
+        * @param dt Δt The time increment for each simulation step.
+        */
+        void kick(double dt) override;
+    };
+
+    /**
+     * @brief Deduces the 3D kernels if the integrator is constructed without template arguments.
+     */
+    StoermerVerletNewton3Off(env::Environment&, std::unique_ptr<io::OutputWriterBase> = nullptr,
+                             std::unique_ptr<io::CheckpointWriter> = nullptr, const env::Thermostat& = env::Thermostat(),
+                             const std::vector<env::ConstantForce>& = {}, std::unique_ptr<core::Statistics> = nullptr)
+        -> StoermerVerletNewton3Off<>;
+
+}  // namespace md::Integrator
@@ -1,54 +1,62 @@
 #include "StoermerVerletSpatialDecomp.h"
 
+#include "core/Trace.h"
 #include "utils/ArrayUtils.h"
 
 namespace md::Integrator {
 
-    void StoermerVerletSpatialDecomp::simulation_step(const unsigned step, const double dt) {
-        // update position
-        for (auto &p: env.particles()) {
-            p.update_position(dt * p.velocity + pow(dt, 2) / (2 * p.mass) * p.force);
-            p.update_grid();
-            p.reset_force();
-        }
-
-
-        for (auto &particle: env.particles(env::GridCell::BOUNDARY | env::GridCell::OUTSIDE)) {
-            env.apply_boundary(particle);
-        }
-
-        // calculate forces
-        for (auto &set : env.block_sets()) {
-#pragma omp parallel for
-            for (UINT_T i = 0; i < set.size(); ++i) {
-                auto &block = set[i];
-                for (auto &cell_pair: block.cell_pairs) {
-                    if (cell_pair.cell1.id == cell_pair.cell2.id) {
-                        auto &particles = cell_pair.cell1.particles;
-                        for (auto it1 = particles.begin(); it1 != particles.end(); ++it1) {
-                            for (auto it2 = std::next(it1); it2 != particles.end(); ++it2) {
-                                env::Particle *p1 = *it1;
-                                env::Particle *p2 = *it2;
-                                vec3 new_F = env.force(*p1, *p2, cell_pair);
-                                p2->force = p2->force + new_F;
-                                p1->force = p1->force - new_F;
+    template <int DIM>
+    void StoermerVerletSpatialDecomp<DIM>::compute_pair_forces() {
+        core::LoadMonitor *const monitor = load_monitor.get();
+        const auto &block_sets = env.block_sets();
+        for (size_t s = 0; s < block_sets.size(); ++s) {
+            auto &set = block_sets[s];
+            if (monitor) monitor->begin_region();
+#pragma omp parallel
+            {
+                // ends when the thread is done with its blocks, the time until the end of the region is barrier wait
+                TRACE_SCOPE_ARG("block_set", s);
+                const auto start = monitor ? core::LoadMonitor::clock::now() : core::LoadMonitor::clock::time_point{};
+#pragma omp for nowait
+                for (UINT_T i = 0; i < set.size(); ++i) {
+                    auto &block = set[i];
+                    for (auto &cell_pair: block.cell_pairs) {
+                        if (cell_pair.cell1.id == cell_pair.cell2.id) {
+                            auto &particles = cell_pair.cell1.particles;
+                            for (auto it1 = particles.begin(); it1 != particles.end(); ++it1) {
+                                for (auto it2 = std::next(it1); it2 != particles.end(); ++it2) {
+                                    env::Particle *p1 = *it1;
+                                    env::Particle *p2 = *it2;
+                                    vec3 new_F = env.force<DIM>(*p1, *p2, cell_pair);
+                                    p2->force = p2->force + new_F;
+                                    p1->force = p1->force - new_F;
+                                }
                             }
                         }
-                    }
-                    else {
-                        for (auto *p1: cell_pair.cell1.particles) {
-                            for (auto *p2: cell_pair.cell2.particles) {
-                                vec3 new_F = env.force(*p1, *p2, cell_pair);
-                                p2->force = p2->force + new_F;
-                                p1->force = p1->force - new_F;
+                        else {
+                            for (auto *p1: cell_pair.cell1.particles) {
+                                for (auto *p2: cell_pair.cell2.particles) {
+                                    vec3 new_F = env.force<DIM>(*p1, *p2, cell_pair);
+                                    p2->force = p2->force + new_F;
+                                    p1->force = p1->force - new_F;
+                                }
                             }
                         }
                     }
                 }
+                if (monitor) monitor->thread_done(start);
             }
+            if (monitor) monitor->end_region(s);
         }
+    }
 
-        // apply constant forces
+    template <int DIM>
+    void StoermerVerletSpatialDecomp<DIM>::compute_bonded_forces(const uint8_t kinds) {
+        env.apply_bonded_forces(true, kinds);
+    }
+
+    template <int DIM>
+    void StoermerVerletSpatialDecomp<DIM>::apply_external_forces(const unsigned step, const double dt) {
         for (auto &f: external_forces) {
             const std::vector<size_t> marked_particles = f.marked_particles();
 #pragma omp parallel for
@@ -56,20 +64,19 @@ namespace md::Integrator {
                 f.apply_force(env[marked_particles[i]], dt * step);
             }
         }
+    }
 
-        // update velocities
-#pragma omp parallel for
-        for (size_t i = 0; i < (env.size(env::Particle::ALIVE | env::Particle::STATIONARY | env::Particle::DEAD)); ++i) {
-            auto &p = env[i];
-            if (p.state == env::Particle::ALIVE) {
-                p.velocity = p.velocity + dt / 2 / p.mass * (p.force + p.old_force);
-            }
-        }
+    template <int DIM>
+    void StoermerVerletSpatialDecomp<DIM>::kick(const double dt) {
+        kick_dim<DIM>(dt, true);
+    }
 
-        // apply thermostat
-        if (step % temp_adjust_freq == 0) {
-            thermostat.adjust_temperature(env);
-        }
+    template <int DIM>
+    void StoermerVerletSpatialDecomp<DIM>::drift(const double dt) {
+        drift_dim<DIM>(dt);
     }
 
+    template class StoermerVerletSpatialDecomp<2>;
+    template class StoermerVerletSpatialDecomp<3>;
+
 } // namespace md::Integrator
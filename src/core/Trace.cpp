@@ -0,0 +1,86 @@
+#include "Trace.h"
+
+#ifdef MD_TRACE
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+#include "io/Logger/Logger.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace md::core {
+    thread_local Tracer::Buffer* Tracer::local_buffer = nullptr;
+
+    Tracer& Tracer::instance() {
+        // destroyed after main returns (or exit is called), which writes the trace
+        static Tracer tracer;
+        return tracer;
+    }
+
+    Tracer::Buffer* Tracer::register_thread() {
+        auto buffer = std::make_unique<Buffer>();
+#ifdef _OPENMP
+        buffer->thread = omp_get_thread_num();
+#else
+        buffer->thread = 0;
+#endif
+        const std::lock_guard lock(registration);
+        buffers.push_back(std::move(buffer));
+        return buffers.back().get();
+    }
+
+    void Tracer::record(const Event& event) {
+        if (!local_buffer) local_buffer = register_thread();
+        local_buffer->events[local_buffer->count % TRACE_BUFFER_SIZE] = event;
+        local_buffer->count++;
+    }
+
+    void Tracer::write(const std::string& file_name) const {
+        std::ofstream file(file_name);
+        if (!file.is_open()) {
+            SPDLOG_ERROR("Could not open trace file {}", file_name);
+            return;
+        }
+
+        // timestamps are relative to the first recorded event
+        uint64_t origin = std::numeric_limits<uint64_t>::max();
+        for (const auto& buffer : buffers) {
+            const uint64_t n = std::min<uint64_t>(buffer->count, TRACE_BUFFER_SIZE);
+            for (uint64_t i = 0; i < n; ++i) origin = std::min(origin, buffer->events[i].start);
+        }
+
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        bool first = true;
+        for (size_t tid = 0; tid < buffers.size(); ++tid) {
+            const Buffer& buffer = *buffers[tid];
+            file << fmt::format("{}{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":{},"
+                                "\"args\":{{\"name\":\"thread {} (omp {})\"}}}}",
+                                first ? "" : ",\n", tid, tid, buffer.thread);
+            first = false;
+
+            // oldest event first if the ring buffer wrapped around
+            const uint64_t n = std::min<uint64_t>(buffer.count, TRACE_BUFFER_SIZE);
+            const uint64_t begin = buffer.count - n;
+            for (uint64_t i = begin; i < buffer.count; ++i) {
+                const Event& event = buffer.events[i % TRACE_BUFFER_SIZE];
+                file << fmt::format(",\n{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}",
+                                    event.name, tid, static_cast<double>(event.start - origin) / 1e3,
+                                    static_cast<double>(event.end - event.start) / 1e3);
+                if (event.arg >= 0) file << fmt::format(",\"args\":{{\"index\":{}}}", event.arg);
+                file << "}";
+            }
+            if (begin > 0) SPDLOG_WARN("Trace buffer of thread {} overflowed, {} events were dropped", tid, begin);
+        }
+        file << "\n]}\n";
+    }
+
+    Tracer::~Tracer() {
+        write(TRACE_FILE);
+    }
+}  // namespace md::core
+
+#endif
@@ -0,0 +1,122 @@
+#pragma once
+
+/**
+ * Timeline tracing of the simulation, enabled by compiling with MD_TRACE (cmake -DENABLE_TRACE=ON).
+ *
+ * TRACE_SCOPE(name) records the time between its declaration and the end of the enclosing scope as one event of the
+ * calling thread. The name must be a string with static storage duration. Without MD_TRACE the macros expand to nothing.
+ */
+#ifdef MD_TRACE
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define TRACE_FILE "trace.json"
+#define TRACE_BUFFER_SIZE (1 << 16)
+
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+#define TRACE_SCOPE(name) const md::core::TraceScope TRACE_CONCAT(trace_scope_, __LINE__)(name)
+#define TRACE_SCOPE_ARG(name, arg) \
+    const md::core::TraceScope TRACE_CONCAT(trace_scope_, __LINE__)(name, static_cast<int64_t>(arg))
+
+namespace md::core {
+
+    /**
+     * @brief Collects the events of all threads and writes them as Chrome trace (TRACE_FILE) at program exit.
+     *
+     * Every thread writes into its own ring buffer of TRACE_BUFFER_SIZE events, so recording needs no
+     * synchronization; only the first event of a thread registers its buffer. If a buffer is full, the oldest events
+     * are overwritten. The trace can be opened in chrome://tracing or https://ui.perfetto.dev.
+     */
+    class Tracer {
+       public:
+        /**
+         * @brief A completed scope.
+         */
+        struct Event {
+            const char* name;   ///< Name of the scope.
+            int64_t arg;        ///< Optional index (e.g. of a block set), negative if not set.
+            uint64_t start;     ///< Start time in ns.
+            uint64_t end;       ///< End time in ns.
+        };
+
+        /**
+         * @brief Returns the tracer of the program.
+         */
+        static Tracer& instance();
+
+        /**
+         * @brief Returns the current time in ns.
+         */
+        static uint64_t now() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        /**
+         * @brief Records an event of the calling thread.
+         * @param event The event.
+         */
+        void record(const Event& event);
+
+        /**
+         * @brief Writes all recorded events as Chrome trace JSON.
+         * @param file_name Path of the file.
+         */
+        void write(const std::string& file_name) const;
+
+        ~Tracer();
+
+       private:
+        /**
+         * @brief Events of one thread.
+         */
+        struct Buffer {
+            std::array<Event, TRACE_BUFFER_SIZE> events;  ///< Ring buffer of events.
+            uint64_t count = 0;                           ///< Number of events recorded so far.
+            int thread;                                   ///< OpenMP thread number at registration.
+        };
+
+        Tracer() = default;
+
+        /**
+         * @brief Creates the buffer of the calling thread.
+         */
+        Buffer* register_thread();
+
+        std::mutex registration;                      ///< Guards the buffer list during registration.
+        std::vector<std::unique_ptr<Buffer>> buffers;  ///< Buffers of all threads that recorded an event.
+        static thread_local Buffer* local_buffer;      ///< Buffer of the calling thread.
+    };
+
+    /**
+     * @brief Records the lifetime of a scope as trace event.
+     */
+    class TraceScope {
+       public:
+        explicit TraceScope(const char* name, const int64_t arg = -1) : name(name), arg(arg), start(Tracer::now()) {}
+
+        ~TraceScope() { Tracer::instance().record({name, arg, start, Tracer::now()}); }
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+       private:
+        const char* name;
+        int64_t arg;
+        uint64_t start;
+    };
+}  // namespace md::core
+
+#else
+
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_SCOPE_ARG(name, arg) ((void)0)
+
+#endif
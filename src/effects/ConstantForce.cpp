@@ -23,6 +23,18 @@ namespace md::env {
         }
     }
 
+    void ConstantForce::mark_added(const Environment& env, const size_t first_id) {
+        for (size_t id = first_id; id < env.id_count(); id++) {
+            if (env.contains(id) && env[id].state == Particle::ALIVE && marker(env[id])) {
+                marked.push_back(id);
+            }
+        }
+    }
+
+    void ConstantForce::unmark_removed(const Environment& env) {
+        std::erase_if(marked, [&env](const size_t id) { return !env.contains(id); });
+    }
+
     void ConstantForce::apply_force(Particle& particle, const double t) const {
         if (t >= start_time && t <= end_time) {
             particle.force = particle.force + strength * (const_acceleration ? particle.mass : 1.0) * direction;
@@ -28,6 +28,18 @@ namespace md::env {
          * @param env The environment of the particles.
          */
         void mark_particles(const Environment& env);
+        /**
+         * @brief Marks the affected particles among those added after the force was set up, e.g. by inflow sources.
+         * @param env The environment of the particles.
+         * @param first_id The id of the first added particle, the others follow consecutively.
+         */
+        void mark_added(const Environment& env, size_t first_id);
+        /**
+         * @brief Drops the ids of marked particles that were removed from the environment by compaction.
+         * @param env The environment of the particles.
+         */
+        void unmark_removed(const Environment& env);
+
         /**
          * @brief Applies the force to a particle at a given time.
          * @param particle The particle to which the force is applied.
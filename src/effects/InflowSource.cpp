@@ -0,0 +1,69 @@
+#include "InflowSource.h"
+
+#include <cmath>
+
+#include "env/Environment.h"
+#include "io/Logger/Logger.h"
+
+namespace md::env {
+    InflowSource::InflowSource(const double rate, const vec3& origin, const vec3& extent, const vec3& velocity,
+                               const double thermal_v, const double mass, const int type, const double start_time,
+                               const double end_time, const double min_distance, const unsigned int seed)
+        : rate(rate),
+          origin(origin),
+          extent(extent),
+          velocity(velocity),
+          thermal_v(thermal_v),
+          mass(mass),
+          type(type),
+          start_time(start_time),
+          end_time(end_time),
+          min_distance(min_distance),
+          random_engine(seed)
+    {}
+
+    size_t InflowSource::insert(Environment& env, const double t, const double dt) {
+        if (t < start_time || t > end_time) return 0;
+
+        pending += rate * dt;
+        const auto due = static_cast<size_t>(std::floor(pending));
+        pending -= static_cast<double>(due);
+        if (due == 0) return 0;
+
+        std::uniform_real_distribution<double> uniform(0, 1);
+        std::normal_distribution<double> normal(0, 1);
+        const int dim = env.dim();
+
+        size_t count = 0;
+        for (size_t i = 0; i < due; i++) {
+            vec3 position{};
+            bool found = false;
+            for (int attempt = 0; attempt < INFLOW_PLACEMENT_ATTEMPTS && !found; attempt++) {
+                for (int k = 0; k < 3; k++) position[k] = origin[k] + uniform(random_engine) * extent[k];
+                found = min_distance <= 0 || !env.occupied(position, min_distance);
+            }
+            if (!found) {
+                num_skipped++;
+                continue;
+            }
+
+            // same distribution as maxwellBoltzmannDistributedVelocity, but drawn from the engine of the source
+            vec3 v = velocity;
+            for (int k = 0; k < dim; k++) v[k] += thermal_v * normal(random_engine);
+            env.add_particle(position, v, mass, type);
+            count++;
+        }
+
+        num_inserted += count;
+        SPDLOG_TRACE("Inflow source inserted {} particles at time {}", count, t);
+        return count;
+    }
+
+    size_t InflowSource::inserted() const {
+        return num_inserted;
+    }
+
+    size_t InflowSource::skipped() const {
+        return num_skipped;
+    }
+} // namespace md::env
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <limits>
+#include <random>
+
+#include "env/Common.h"
+
+#define INFLOW_PLACEMENT_ATTEMPTS 16
+
+namespace md::env {
+    class Environment;
+
+    /**
+     * @brief Inserts particles into a running simulation at a constant rate, e.g. to feed a flow through an outflow
+     * boundary. The particles are placed uniformly at random in a box and get a mean velocity plus a Maxwell-Boltzmann
+     * distributed thermal velocity.
+     */
+    class InflowSource {
+    public:
+        /**
+         * @brief Constructor.
+         * @param rate Number of inserted particles per time unit, fractions are carried over to the next batch.
+         * @param origin The lower left front corner of the insertion box.
+         * @param extent The extent of the insertion box, 0 in z for 2D simulations.
+         * @param velocity The mean velocity of the inserted particles.
+         * @param thermal_v The thermal velocity of the inserted particles.
+         * @param mass The mass of the inserted particles.
+         * @param type The type of the inserted particles, a force must be set for it (default: 0).
+         * @param start_time Start time of the insertion (default: 0).
+         * @param end_time End time of the insertion (default: no end).
+         * @param min_distance Minimal distance of an inserted particle to all others, not checked if 0 (default: 0).
+         * @param seed Seed of the random placement, sources with equal seeds insert equal particles (default: 42).
+         */
+        InflowSource(double rate, const vec3& origin, const vec3& extent, const vec3& velocity, double thermal_v,
+                     double mass, int type = 0, double start_time = 0,
+                     double end_time = std::numeric_limits<double>::max(), double min_distance = 0,
+                     unsigned int seed = 42);
+
+        /**
+         * @brief Inserts the particles due for a time step into the built environment. A particle that finds no
+         * position respecting the minimal distance within INFLOW_PLACEMENT_ATTEMPTS attempts is skipped.
+         * @param env The environment.
+         * @param t The simulation time at the end of the step.
+         * @param dt Δt The time increment of the step.
+         * @return The number of inserted particles, their ids are consecutive.
+         */
+        size_t insert(Environment& env, double t, double dt);
+
+        /**
+         * @brief Returns the number of particles inserted so far.
+         * @return The number of particles.
+         */
+        [[nodiscard]] size_t inserted() const;
+
+        /**
+         * @brief Returns the number of particles skipped because no free position was found.
+         * @return The number of particles.
+         */
+        [[nodiscard]] size_t skipped() const;
+
+    private:
+        double rate;           ///< Number of inserted particles per time unit.
+        vec3 origin;           ///< Lower left front corner of the insertion box.
+        vec3 extent;           ///< Extent of the insertion box.
+        vec3 velocity;         ///< Mean velocity of the inserted particles.
+        double thermal_v;      ///< Thermal velocity of the inserted particles.
+        double mass;           ///< Mass of the inserted particles.
+        int type;              ///< Type of the inserted particles.
+        double start_time;     ///< Start time of the insertion.
+        double end_time;       ///< End time of the insertion.
+        double min_distance;   ///< Minimal distance to the other particles, not checked if 0.
+        double pending = 0;    ///< Fraction of a particle carried over to the next step.
+        size_t num_inserted = 0;  ///< Number of particles inserted so far.
+        size_t num_skipped = 0;   ///< Number of particles skipped for lack of space.
+        std::default_random_engine random_engine;  ///< Engine of the random placement and velocities.
+    };
+} // namespace md::env
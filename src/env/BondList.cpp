@@ -0,0 +1,80 @@
+#include "BondList.h"
+
+#include <algorithm>
+
+namespace md::env {
+
+    void BondList::add_bond(const ID id1, const ID id2, const double k, const double r0, const bool exclude) {
+        first.push_back(id1);
+        second.push_back(id2);
+        stiffness.push_back(k);
+        length.push_back(r0);
+        flags.push_back(exclude ? HARMONIC | EXCLUDED : HARMONIC);
+    }
+
+    void BondList::add_exclusion(const ID id1, const ID id2) {
+        first.push_back(id1);
+        second.push_back(id2);
+        stiffness.push_back(0);
+        length.push_back(0);
+        flags.push_back(EXCLUDED);
+    }
+
+    void BondList::replicate(const size_t num_particles, const unsigned int copies) {
+        const size_t originals = size();
+        for (unsigned int k = 1; k < copies; ++k) {
+            const size_t offset = k * num_particles;
+            for (size_t i = 0; i < originals; ++i) {
+                first.push_back(first[i] + offset);
+                second.push_back(second[i] + offset);
+                stiffness.push_back(stiffness[i]);
+                length.push_back(length[i]);
+                flags.push_back(flags[i]);
+            }
+        }
+    }
+
+    void BondList::init() {
+        // counting sort of the bond ends by particle id, the ends of a particle are then adjacent and ascending
+        ID max_id = 0;
+        for (size_t i = 0; i < size(); ++i) max_id = std::max({max_id, first[i] + 1, second[i] + 1});
+        std::vector<size_t> count(max_id + 1, 0);
+        for (size_t i = 0; i < size(); ++i) {
+            count[first[i] + 1]++;
+            count[second[i] + 1]++;
+        }
+        for (size_t id = 1; id < count.size(); ++id) count[id] += count[id - 1];
+
+        ends.assign(2 * size(), 0);
+        std::vector<size_t> next(count.begin(), count.end() - 1);
+        for (size_t i = 0; i < size(); ++i) {
+            ends[next[first[i]]++] = 2 * i;
+            ends[next[second[i]]++] = 2 * i + 1;
+        }
+
+        particles.clear();
+        offsets.clear();
+        for (ID id = 0; id + 1 < count.size(); ++id) {
+            if (count[id + 1] == count[id]) continue;
+            particles.push_back(id);
+            offsets.push_back(count[id]);
+        }
+        offsets.push_back(ends.size());
+        forces.assign(size(), vec3{});
+    }
+
+    size_t BondList::size() const {
+        return first.size();
+    }
+
+    bool BondList::empty() const {
+        return first.empty();
+    }
+
+    void BondList::memory_usage(utils::MemoryUsage& usage) const {
+        usage.add("bonds", utils::vector_bytes(first) + utils::vector_bytes(second) + utils::vector_bytes(stiffness) +
+                               utils::vector_bytes(length) + utils::vector_bytes(flags) +
+                               utils::vector_bytes(particles) + utils::vector_bytes(offsets) +
+                               utils::vector_bytes(ends) + utils::vector_bytes(forces));
+    }
+} // namespace md::env
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Common.h"
+#include "Particle.h"
+#include "utils/MemoryUtils.h"
+
+namespace md::env {
+
+    /**
+     * @brief Explicit list of the bonded interactions between specific particles, e.g. the springs of a membrane.
+     * The bonds are stored as compact arrays indexed by bond and evaluated independent of the linked cells, see
+     * Environment::apply_bonded_forces. A bond can exclude the pair from the nonbonded (type pair) forces.
+     */
+    class BondList {
+    public:
+        using ID = Particle::ID;
+
+        /**
+         * @brief Flags of a bond.
+         */
+        enum Flags : uint8_t {
+            HARMONIC = 0x1,  ///< A harmonic spring acts between the particles.
+            EXCLUDED = 0x2,  ///< The nonbonded force between the particles is excluded.
+        };
+
+        /**
+         * @brief Adds a harmonic bond between two particles. Each pair must only be added once.
+         * @param id1 The id of the first particle.
+         * @param id2 The id of the second particle.
+         * @param k The stiffness constant.
+         * @param r0 The rest length.
+         * @param exclude Whether the nonbonded force between the particles is excluded (default: false).
+         */
+        void add_bond(ID id1, ID id2, double k, double r0, bool exclude = false);
+
+        /**
+         * @brief Excludes the nonbonded force between two particles, without a bond. Each pair must only be added
+         * once.
+         * @param id1 The id of the first particle.
+         * @param id2 The id of the second particle.
+         */
+        void add_exclusion(ID id1, ID id2);
+
+        /**
+         * @brief Duplicates the bonds for copies of the particle set, see Environment::replicate. The particles of the
+         * k-th copy are expected to have the IDs of the originals shifted by k * num_particles.
+         * @param num_particles Number of particles of the original set.
+         * @param copies Total number of copies, including the original.
+         */
+        void replicate(size_t num_particles, unsigned int copies);
+
+        /**
+         * @brief Builds the lookup from the bonded particles to their bonds, has to be called once all bonds are added.
+         */
+        void init();
+
+        /**
+         * @brief Returns the number of bonds, exclusions included.
+         * @return The number of bonds.
+         */
+        [[nodiscard]] size_t size() const;
+
+        /**
+         * @brief Checks if there are any bonds.
+         * @return "true" if there are no bonds, "false" otherwise.
+         */
+        [[nodiscard]] bool empty() const;
+
+        /**
+         * @brief Adds the bytes allocated by the bond arrays.
+         * @param usage The memory usage to add to.
+         */
+        void memory_usage(utils::MemoryUsage& usage) const;
+
+        std::vector<ID> first;          ///< Id of the first particle of each bond.
+        std::vector<ID> second;         ///< Id of the second particle of each bond.
+        std::vector<double> stiffness;  ///< Stiffness constant of each bond, 0 for exclusions only.
+        std::vector<double> length;     ///< Rest length of each bond.
+        std::vector<uint8_t> flags;     ///< Flags of each bond.
+
+        std::vector<ID> particles;      ///< Ids of all bonded particles.
+        std::vector<size_t> offsets;    ///< Start of the bonds of each bonded particle in ends, one extra at the end.
+        std::vector<size_t> ends;       ///< Bond ends of the bonded particles, 2 * bond + 1 for the second particle.
+        std::vector<vec3> forces;       ///< Force on the second particle of each bond in the running step.
+    };
+} // namespace md::env
@@ -19,21 +19,6 @@ namespace md::env {
     /// -----------------------------------------
     /// \brief Helper methods
     /// -----------------------------------------
-    std::vector<int3> type_to_normals(const GridCell::Type type) {
-        // Assert type & GridCell::Boundary
-        std::vector<int3> ret;
-        ret.reserve(6);
-
-        if (type & GridCell::BOUNDARY_LEFT) ret.push_back(BoundaryNormal::LEFT);
-        if (type & GridCell::BOUNDARY_RIGHT) ret.push_back(BoundaryNormal::RIGHT);
-        if (type & GridCell::BOUNDARY_TOP) ret.push_back(BoundaryNormal::TOP);
-        if (type & GridCell::BOUNDARY_BOTTOM) ret.push_back(BoundaryNormal::BOTTOM);
-        if (type & GridCell::BOUNDARY_FRONT) ret.push_back(BoundaryNormal::FRONT);
-        if (type & GridCell::BOUNDARY_BACK) ret.push_back(BoundaryNormal::BACK);
-
-        return ret;
-    }
-
     int axis_from_normal(const int3 & normal) {
         ASSERT(
             (normal[0] == 0 || normal[0] == 1 || normal[0] == -1) &&
@@ -57,6 +42,12 @@ namespace md::env {
         return {-1, -1};
     }
 
+    const int3& Boundary::face_normal(const Face face) {
+        static const std::array normals = {BoundaryNormal::LEFT,  BoundaryNormal::RIGHT, BoundaryNormal::TOP,
+                                           BoundaryNormal::BOTTOM, BoundaryNormal::FRONT, BoundaryNormal::BACK};
+        return normals[face];
+    }
+
     Boundary::Face Boundary::normal_to_face(const int3& face_normal) {
         // Assert whether face_normal[i] is either 1, -1, or 0 for all i = 0,1,2
         ASSERT(
@@ -114,14 +105,12 @@ namespace md::env {
         this->force = force;
     }
 
-    void Boundary::apply_boundary(Particle & particle, const GridCell& current_cell, const GridCell& previous_cell) const {
+    bool Boundary::apply_boundary(Particle & particle, const GridCell& current_cell, const GridCell& previous_cell) const {
 
         // if particle is outside, we need to find out which boundary interface it passed through to apply the correct rule
         if (current_cell.type == GridCell::OUTSIDE) {
-            const std::vector<int3> normals = type_to_normals(previous_cell.type);
-
             // calculate which face particle traveled through if the cell has more than one face
-            if (normals.size() > 1) {
+            if (previous_cell.faces.size() > 1) {
                 const vec3 diff = particle.position - particle.old_position;
                 const vec3 pos = particle.old_position - origin;
 
@@ -137,34 +126,58 @@ namespace md::env {
                     (y[2] - pos[2]) / diff[2],
                 };
 
-                const std::array possible_normals = {
-                    diff[0] > 0 ? BoundaryNormal::RIGHT : BoundaryNormal::LEFT,
-                    diff[1] > 0 ? BoundaryNormal::TOP : BoundaryNormal::BOTTOM,
-                    diff[2] > 0 ? BoundaryNormal::FRONT : BoundaryNormal::BACK
+                const std::array possible_faces = {
+                    diff[0] > 0 ? RIGHT : LEFT,
+                    diff[1] > 0 ? TOP : BOTTOM,
+                    diff[2] > 0 ? FRONT : BACK
                 };
 
-                for (const auto& normal : possible_normals) {
-                    const int axis = axis_from_normal(normal);
+                for (const auto face : possible_faces) {
+                    const int axis = axis_from_normal(face_normal(face));
                     const auto non_axis = non_axis_indices(axis);
                     const vec3 intersection = t[axis] * diff + pos; // intersection of the particles path with the boundary
 
                     // check if intersection point is valid. if so apply rule
                     if (intersection[non_axis[0]] >= 0 && intersection[non_axis[0]] <= extent[non_axis[0]] &&
                         intersection[non_axis[1]] >= 0 && intersection[non_axis[1]] <= extent[non_axis[1]]) {
-                        apply_rule(normal, particle, current_cell);
-
-                        return;
+                        return apply_rule(face, particle, current_cell);
                     }
                 }
 
-            } else { // only one normal for the current cell i.e. only one boundary interface
-                apply_rule(normals[0], particle, current_cell);
-            }
-        }else {
-            // apply boundary conditions for each boundary of the cell
-            for (const auto &normal :  type_to_normals(current_cell.type)) {
-                apply_rule(normal, particle, current_cell);
+            } else if (!previous_cell.faces.empty()) { // only one boundary interface
+                return apply_rule(previous_cell.faces[0], particle, current_cell);
+            } else { // the particle was outside already, e.g. after crossing a periodic corner
+                constexpr std::array<std::array<Face, 2>, 3> axis_faces = {{{LEFT, RIGHT}, {BOTTOM, TOP}, {BACK, FRONT}}};
+                bool remove = false;
+                for (int axis = 0; axis < 3; axis++) {
+                    const double coord = particle.position[axis] - origin[axis];
+                    if (coord < 0) remove |= apply_rule(axis_faces[axis][0], particle, current_cell);
+                    else if (coord >= extent[axis]) remove |= apply_rule(axis_faces[axis][1], particle, current_cell);
+                }
+                return remove;
             }
+            return false;
+        }
+
+        // apply boundary conditions for each boundary of the cell
+        bool remove = false;
+        for (const auto face : current_cell.faces) {
+            remove |= apply_rule(face, particle, current_cell);
+        }
+        return remove;
+    }
+
+    void Boundary::apply_wall_force(const Face face, const GridCell& cell) const {
+        ASSERT(rules[face] == REPULSIVE_FORCE, "The face must have a repulsive force.");
+        const int3& normal = face_normal(face);
+        const int axis = axis_from_normal(normal);
+
+        // same as repulsive_force_rule with the face resolved once per cell
+        for (Particle* particle : cell.particles) {
+            if (particle->state != Particle::ALIVE) continue;
+            const double coord = particle->position[axis] - cell.origin[axis];
+            const double dist = normal[axis] == 1 ? cell.size[axis] - coord : coord;
+            if (dist != 0) particle->force[axis] -= force(dist) * normal[axis];
         }
     }
 
@@ -209,23 +222,22 @@ namespace md::env {
     }
 
 
-    void Boundary::apply_rule(const int3& normal, Particle& particle, const GridCell& current_cell) const {
-        switch (rules[normal_to_face(normal)]) {
-            case OUTFLOW: outflow_rule(particle, current_cell); break;
+    bool Boundary::apply_rule(const Face face, Particle& particle, const GridCell& current_cell) const {
+        const int3& normal = face_normal(face);
+        switch (rules[face]) {
+            case OUTFLOW: return outflow_rule(current_cell);
             case PERIODIC: periodic_rule(particle, normal, current_cell); break;
             case REPULSIVE_FORCE: repulsive_force_rule(particle, normal, current_cell); break;
             case VELOCITY_REFLECTION: velocity_reflection_rule(particle, normal, current_cell); break;
         }
+        return false;
     }
 
 
-    void Boundary::outflow_rule(Particle& particle, const GridCell& previous_cell) const {
+    bool Boundary::outflow_rule(const GridCell& current_cell) const {
         // this rule may be called when applying all boundary conditions of a cell, hence we need a check if
         // the particle is outside or inside
-        if (previous_cell.type == GridCell::OUTSIDE) {
-            particle.state = Particle::DEAD;
-            particle.update_grid();
-        }
+        return current_cell.type == GridCell::OUTSIDE;
     }
 
     void Boundary::periodic_rule(Particle& particle,const int3& normal, const GridCell& current_cell) const {
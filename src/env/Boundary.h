@@ -100,13 +100,29 @@ namespace md::env {
          */
         void set_boundary_force(const BoundaryForce &force);
 
+        /**
+         * @brief Returns the normal vector of a face.
+         * @param face The face.
+         * @return The face normal vector.
+         */
+        static const int3 & face_normal(Face face);
+
         /**
          * @brief Calculates the face and applies the boundary conditions to a particle.
          * @param particle The particle to which the conditions are applied.
          * @param current_cell The particle's current gird cell.
          * @param previous_cell The particle's previous gird cell.
+         * @return "true" if the particle left the domain through an outflow face and has to be removed by the caller,
+         * "false" otherwise.
          */
-        void apply_boundary(Particle &particle, const GridCell &current_cell, const GridCell &previous_cell) const;
+        bool apply_boundary(Particle &particle, const GridCell &current_cell, const GridCell &previous_cell) const;
+
+        /**
+         * @brief Applies the repulsive force of a face to the alive particles of a cell at that face.
+         * @param face The face, its rule must be REPULSIVE_FORCE.
+         * @param cell A boundary cell at the face.
+         */
+        void apply_wall_force(Face face, const GridCell &cell) const;
 
         [[nodiscard]] const std::array<BoundaryRule, 6> & boundary_rules() const;
 
@@ -137,19 +153,20 @@ namespace md::env {
     private:
         /**
          * @brief Applies a boundary rule to a particle based on the boundary face it interacts with.
-         * @param normal The normal vector of the boundary face.
+         * @param face The boundary face.
          * @param particle The particle to which the rule is applied.
          * @param current_cell The particle's current grid cell.
+         * @return "true" if the particle has to be removed, "false" otherwise.
          */
-        void apply_rule(const int3 &normal, Particle &particle, const GridCell &current_cell) const;
+        bool apply_rule(Face face, Particle &particle, const GridCell &current_cell) const;
 
         /**
          * @brief Implements the outflow rule.
          * (Particles that cross the boundary are removed).
-         * @param particle The particle in question.
-         * @param previous_cell The particle's previous cell.
+         * @param current_cell The particle's current cell.
+         * @return "true" if the particle is outside and has to be removed, "false" otherwise.
          */
-        void outflow_rule(Particle &particle, const GridCell &previous_cell) const;
+        bool outflow_rule(const GridCell &current_cell) const;
 
         /**
          * @brief Implements the periodic rule.
@@ -0,0 +1,175 @@
+#include "DirectSum.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <omp.h>
+
+#include "Environment.h"
+
+namespace md::env {
+
+    void DirectSum::init(const ForceManager& forces, const Boundary& boundary, const int dim) {
+        kind = NONE;
+        const std::vector<int> force_types = forces.types();
+        if (force_types.empty() || forces.has_localized_forces()) return;
+
+        // the nearest image is the only one within the cutoff if the periodic boundaries are wide enough
+        const auto& rules = boundary.boundary_rules();
+        const std::array<bool, 3> periodic = {rules[Boundary::LEFT] == PERIODIC, rules[Boundary::TOP] == PERIODIC,
+                                              dim == 3 && rules[Boundary::FRONT] == PERIODIC};
+        for (int k = 0; k < 3; k++) {
+            if (periodic[k] && boundary.extent[k] < 2 * forces.cutoff()) return;
+            period[k] = periodic[k] ? boundary.extent[k] : 0;
+            half_period[k] = periodic[k] ? boundary.extent[k] / 2 : std::numeric_limits<double>::infinity();
+        }
+
+        const size_t n_types = force_types.size();
+        type_index.clear();
+        for (size_t i = 0; i < n_types; i++) type_index[force_types[i]] = static_cast<uint32_t>(i);
+
+        table.assign(n_types * n_types, {});
+        Kind table_kind = NONE;
+        for (size_t i = 0; i < n_types; i++) {
+            for (size_t j = 0; j < n_types; j++) {
+                const ForceType& config = forces.pair_config(force_types[i], force_types[j]);
+                PairParameters& parameters = table[i * n_types + j];
+                Kind pair_kind;
+                if (const auto* lj = std::get_if<LennardJones>(&config)) {
+                    pair_kind = LENNARD_JONES;
+                    parameters = {24 * lj->epsilon, lj->sigma * lj->sigma, lj->cutoff * lj->cutoff};
+                } else if (const auto* is = std::get_if<InverseSquare>(&config)) {
+                    pair_kind = INVERSE_SQUARE;
+                    parameters = {is->pre_factor, 0, is->cutoff * is->cutoff};
+                } else {
+                    return;
+                }
+                if (table_kind != NONE && table_kind != pair_kind) return;
+                table_kind = pair_kind;
+            }
+        }
+        kind = table_kind;
+    }
+
+    bool DirectSum::supported() const {
+        return kind != NONE;
+    }
+
+    void DirectSum::gather(Environment& env) {
+        particles.clear();
+        x.clear();
+        y.clear();
+        z.clear();
+        mass.clear();
+        types.clear();
+        stationary.clear();
+
+        const auto states = static_cast<Particle::State>(Particle::ALIVE | Particle::STATIONARY);
+        for (auto& p : env.particles(GridCell::INSIDE, states)) {
+            particles.push_back(&p);
+            x.push_back(p.position[0]);
+            y.push_back(p.position[1]);
+            z.push_back(p.position[2]);
+            mass.push_back(p.mass);
+            types.push_back(type_index.at(p.type));
+            stationary.push_back(p.state == Particle::STATIONARY);
+        }
+    }
+
+    void DirectSum::compute(Environment& env, const bool parallel) {
+        gather(env);
+        const size_t n = particles.size();
+        const size_t tiles = (n + DIRECT_SUM_TILE - 1) / DIRECT_SUM_TILE;
+
+        int threads = 1;
+#ifdef _OPENMP
+        if (parallel) threads = omp_get_max_threads();
+#endif
+        buffers.assign(3 * n * threads, 0);
+
+#pragma omp parallel num_threads(threads) if (parallel)
+        {
+            int thread = 0;
+#ifdef _OPENMP
+            thread = omp_get_thread_num();
+#endif
+            double* fx = buffers.data() + 3 * n * thread;
+            double* fy = fx + n;
+            double* fz = fy + n;
+
+            // the rows get shorter towards the end of the triangle
+#pragma omp for schedule(dynamic)
+            for (size_t a = 0; a < tiles; a++) {
+                for (size_t b = a; b < tiles; b++) {
+                    if (kind == LENNARD_JONES) {
+                        tile<LENNARD_JONES>(a, b, fx, fy, fz);
+                    } else {
+                        tile<INVERSE_SQUARE>(a, b, fx, fy, fz);
+                    }
+                }
+            }
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            vec3 force{};
+            for (int t = 0; t < threads; t++) {
+                const double* f = buffers.data() + 3 * n * t;
+                force[0] += f[i];
+                force[1] += f[n + i];
+                force[2] += f[2 * n + i];
+            }
+            particles[i]->force = particles[i]->force + force;
+        }
+    }
+
+    template <DirectSum::Kind KIND>
+    void DirectSum::tile(const size_t a, const size_t b, double* fx, double* fy, double* fz) const {
+        const size_t n = particles.size();
+        const size_t n_types = type_index.size();
+        const size_t i_end = std::min((a + 1) * DIRECT_SUM_TILE, n);
+        const size_t j_end = std::min((b + 1) * DIRECT_SUM_TILE, n);
+
+        for (size_t i = a * DIRECT_SUM_TILE; i < i_end; i++) {
+            const size_t j_begin = a == b ? i + 1 : b * DIRECT_SUM_TILE;
+            const double xi = x[i], yi = y[i], zi = z[i], mi = mass[i];
+            const uint8_t stationary_i = stationary[i];
+            const PairParameters* row = &table[types[i] * n_types];
+            double fxi = 0, fyi = 0, fzi = 0;
+
+#pragma omp simd reduction(+ : fxi, fyi, fzi)
+            for (size_t j = j_begin; j < j_end; j++) {
+                // nearest image along the periodic axes, both particles are inside the domain
+                double dx = x[j] - xi;
+                double dy = y[j] - yi;
+                double dz = z[j] - zi;
+                dx -= period[0] * ((dx > half_period[0]) - (dx < -half_period[0]));
+                dy -= period[1] * ((dy > half_period[1]) - (dy < -half_period[1]));
+                dz -= period[2] * ((dz > half_period[2]) - (dz < -half_period[2]));
+
+                const double r2 = dx * dx + dy * dy + dz * dz;
+                const PairParameters& parameters = row[types[j]];
+                double scalar;
+                if constexpr (KIND == LENNARD_JONES) {
+                    const double inv_r2 = 1.0 / r2;
+                    const double sigma_r2 = parameters.sigma_sq * inv_r2;
+                    const double sigma_r6 = sigma_r2 * sigma_r2 * sigma_r2;
+                    scalar = parameters.factor * inv_r2 * (2.0 * sigma_r6 * sigma_r6 - sigma_r6);
+                } else {
+                    scalar = -parameters.factor * mi * mass[j] / (r2 * std::sqrt(r2));
+                }
+                scalar = r2 <= parameters.cutoff_sq && !(stationary_i & stationary[j]) ? scalar : 0.0;
+
+                // the force acts on j, its negative on i
+                fx[j] += scalar * dx;
+                fy[j] += scalar * dy;
+                fz[j] += scalar * dz;
+                fxi -= scalar * dx;
+                fyi -= scalar * dy;
+                fzi -= scalar * dz;
+            }
+            fx[i] += fxi;
+            fy[i] += fyi;
+            fz[i] += fzi;
+        }
+    }
+}  // namespace md::env
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Boundary.h"
+#include "Common.h"
+#include "Force.h"
+#include "Particle.h"
+#include "ankerl/unordered_dense.h"
+
+#define DIRECT_SUM_PAIR_RATIO 3  ///< Pairs of the direct sum per pair candidate of the linked cells it is preferred up to.
+#define DIRECT_SUM_TILE 256      ///< Particles per tile, the positions of two tiles fit into the L1 cache.
+
+namespace md::env {
+    class Environment;
+
+    /**
+     * @brief How the pair forces are computed.
+     */
+    enum class PairMethod {
+        AUTO,          ///< The direct sum if Environment::direct_sum_suitable, the linked cells otherwise.
+        LINKED_CELLS,  ///< Always the linked cells.
+        DIRECT_SUM,    ///< The direct sum if the DirectSum supports the forces and the boundary.
+    };
+
+    /**
+     * @brief Computes the pair forces of all particle pairs directly, without linked cells, hash sets or force
+     * functions. The positions are gathered into arrays per component and the pairs i < j are evaluated tile by tile,
+     * the loop over the particles of a tile is vectorized. With OpenMP, the tile rows are distributed over the threads,
+     * which sum up their forces in separate buffers.
+     * Supports Lennard-Jones or inverse square forces between all types, see supported, and periodic boundaries that
+     * are at least twice the cutoff wide, where the nearest image is used.
+     */
+    class DirectSum {
+    public:
+        /**
+         * @brief Builds the parameter table of the type pair forces.
+         * @param forces The initialized forces.
+         * @param boundary The boundary of the environment.
+         * @param dim The dimension of the particles, the z axis is ignored in 2D.
+         */
+        void init(const ForceManager& forces, const Boundary& boundary, int dim);
+
+        /**
+         * @brief Checks if the forces and the boundary can be evaluated by the direct sum.
+         * @return "true" if all type pairs interact with the same kind of force, Lennard-Jones or inverse square,
+         * there are no forces between specific particles and the periodic boundaries are wide enough.
+         */
+        [[nodiscard]] bool supported() const;
+
+        /**
+         * @brief Adds the pair forces of all alive and stationary particles inside the domain to their forces. The
+         * pairs of two stationary particles are skipped.
+         * @param env The environment.
+         * @param parallel Whether the tiles are evaluated in parallel.
+         */
+        void compute(Environment& env, bool parallel = false);
+
+    private:
+        /**
+         * @brief Kind of the force between all type pairs.
+         */
+        enum Kind { NONE, LENNARD_JONES, INVERSE_SQUARE };
+
+        /**
+         * @brief Parameters of the force between two types.
+         */
+        struct PairParameters {
+            double factor;     ///< 24 epsilon (Lennard-Jones) or the pre-factor (inverse square).
+            double sigma_sq;   ///< Sigma squared (Lennard-Jones).
+            double cutoff_sq;  ///< Cutoff radius squared.
+        };
+
+        /**
+         * @brief Copies the particles into the arrays.
+         * @param env The environment.
+         */
+        void gather(Environment& env);
+
+        /**
+         * @brief Evaluates the pairs between two tiles, or within a tile.
+         * @tparam KIND The kind of the force.
+         * @param a The index of the first tile.
+         * @param b The index of the second tile, not less than a.
+         * @param fx The x components of the forces of the thread.
+         * @param fy The y components of the forces of the thread.
+         * @param fz The z components of the forces of the thread.
+         */
+        template <Kind KIND>
+        void tile(size_t a, size_t b, double* fx, double* fy, double* fz) const;
+
+        Kind kind = NONE;                               ///< Kind of the force between all type pairs.
+        ankerl::unordered_dense::map<int, uint32_t> type_index;  ///< Row of each particle type in the table.
+        std::vector<PairParameters> table;              ///< Parameters of each type pair, row-major.
+        vec3 period{};                                  ///< Extent of each periodic axis, 0 if not periodic.
+        vec3 half_period{};                             ///< Half of period, infinite if not periodic.
+
+        std::vector<Particle*> particles;  ///< The gathered particles.
+        std::vector<double> x, y, z;       ///< Positions of the gathered particles.
+        std::vector<double> mass;          ///< Masses of the gathered particles.
+        std::vector<uint32_t> types;       ///< Table rows of the gathered particles.
+        std::vector<uint8_t> stationary;   ///< Whether each gathered particle is stationary.
+        std::vector<double> buffers;       ///< x, y and z forces of each thread, one after another.
+    };
+}  // namespace md::env
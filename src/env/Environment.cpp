@@ -1,10 +1,13 @@
 #include "Environment.h"
 
-#include <ranges>
+#include <algorithm>
 #include <cmath>
+#include <ranges>
 
+#include "core/PairCounters.h"
 #include "io/Logger/Logger.h"
 #include "utils/ArrayUtils.h"
+#include "utils/Debug.h"
 #include "utils/MaxwellBoltzmannDistribution.h"
 
 #define WARN_IF_INIT(msg)                                                                                     \
@@ -20,8 +23,8 @@ namespace md::env {
     /// \brief CreateInfo Constructors
     /// -----------------------------------------
     ParticleCreateInfo::ParticleCreateInfo(const vec3& position, const vec3& velocity, const double mass,
-                                           const int type, Particle::State state)
-        : position(position), velocity(velocity), mass(mass), type(type), state(state) {}
+                                           const int type, Particle::State state, const vec3& force)
+        : position(position), velocity(velocity), mass(mass), type(type), state(state), force(force) {}
 
     CuboidCreateInfo::CuboidCreateInfo(const vec3& origin, const vec3& initial_v, const uint3& num_particles,
                                        const double width, const double mass, const double thermal_v, const int type,
@@ -54,7 +57,7 @@ namespace md::env {
     /// Environment Class Methods
     /// -----------------------------------------
     Environment::Environment()
-        : dimension(Dimension::INFER), grid_constant(GRID_CONSTANT_AUTO), initialized(false), num_stat_particles(0) {}
+        : dimension(Dimension::INFER), grid_constant(GRID_CONSTANT_AUTO), initialized(false) {}
 
     /// -----------------------------------------
     ///  Methods for environment setup
@@ -74,6 +77,11 @@ namespace md::env {
         this->boundary = boundary;
     }
 
+    void Environment::set_cell_order(const CellOrder order) {
+        WARN_IF_INIT("set the cell order");
+        grid.set_cell_order(order);
+    }
+
     void Environment::set_dimension(const Dimension dim) {
         WARN_IF_INIT("set the dimension");
         dimension = dim;
@@ -81,7 +89,7 @@ namespace md::env {
 
     vec3 Environment::average_velocity() {
         vec3 v = {};
-        for (const auto& p : particle_storage) {
+        for (const auto& p : particles(GridCell::INSIDE, Particle::ALIVE)) {
             v = v + p.velocity;
         }
         return 1.0 / size(Particle::ALIVE) * v;
@@ -96,20 +104,44 @@ namespace md::env {
 
     size_t Environment::add_particle(const vec3& position, const vec3& velocity, double mass, int type,
                                    const Particle::State state, const vec3& force) {
-        WARN_IF_INIT("add particles");
+        // before the build, nothing points into the storage and the vector may grow on its own
+        if (initialized) reserve_particles(1);
 
-        size_t id = particle_storage.size();
+        const size_t id = id_to_index.size();
+        id_to_index.push_back(particle_storage.size());
         particle_storage.emplace_back(id, grid, position, velocity, mass, type, state, force);
-        if (state == Particle::STATIONARY) num_stat_particles++;
+        grid.add_particle(particle_storage.back());
         SPDLOG_TRACE("Particle added to env. Position: [{}, {}, {}], Velocity: [{}, {}, {}], Mass: {}, Type: {}",
                      position[0], position[1], position[2], velocity[0], velocity[1], velocity[2], mass, type);
         return id;
     }
 
-    void Environment::add_particles(const std::vector<ParticleCreateInfo>& particles) {
+    size_t Environment::add_particles(const std::vector<ParticleCreateInfo>& particles) {
+        const size_t first_id = id_to_index.size();
+        reserve_particles(particles.size());
+        id_to_index.reserve(id_to_index.size() + particles.size());
         for (auto& x : particles) {
-            add_particle(x.position, x.velocity, x.mass, x.type, x.state);
+            const size_t id = id_to_index.size();
+            id_to_index.push_back(particle_storage.size());
+            particle_storage.emplace_back(id, grid, x.position, x.velocity, x.mass, x.type, x.state, x.force);
+            grid.add_particle(particle_storage.back());
         }
+        SPDLOG_TRACE("{} particles added to env.", particles.size());
+        return first_id;
+    }
+
+    void Environment::reserve_particles(const size_t additional) {
+        const size_t required = particle_storage.size() + additional;
+        if (required <= particle_storage.capacity()) return;
+        if (!initialized) {
+            particle_storage.reserve(required);
+            return;
+        }
+
+        // inserting between steps has to stay amortized O(1) despite the relink
+        particle_storage.reserve(std::max(required, 2 * particle_storage.capacity()));
+        grid.relink(particle_storage);
+        SPDLOG_DEBUG("Particle storage grew to a capacity of {} particles.", particle_storage.capacity());
     }
 
     void Environment::add_cuboid(const CuboidCreateInfo& cuboid) {
@@ -181,7 +213,7 @@ namespace md::env {
     }
 
     void Environment::add_membrane(const vec3& origin, const vec3& velocity, const uint3& num_particles, const double width,
-        const double mass, double k, const double cutoff, const int type) {
+        const double mass, double k, const double, const int type, const bool exclude_bonded) {
 
         if (num_particles[0] == 0 || num_particles[1] == 0 || num_particles[2] == 0) {
             SPDLOG_ERROR("num_particles contains 0 particles in at least one direction");
@@ -208,27 +240,66 @@ namespace md::env {
             }
         }
 
-        // add forces
+        // add bonds, each neighbor pair once: right, top, top right and bottom right
+        constexpr std::array<std::array<int, 2>, 4> neighbors = {{{1, 0}, {0, 1}, {1, 1}, {1, -1}}};
         for (int x = 0; x < static_cast<int>(num_particles[0]); ++x) {
             for (int y = 0; y < static_cast<int>(num_particles[1]); ++y) {
                 size_t id1 = particle_ids[index(x, y)];
-                for (int dx = -1; dx <= 1; ++dx) {
-                    for (int dy = -1; dy <= 1; ++dy) {
-                        if (dx == 0 && dy == 0) continue;
-                        const int nx = x + dx;
-                        const int ny = y + dy;
-
-                        if (nx >= 0 && nx < static_cast<int>(num_particles[0]) && ny >= 0 && ny < static_cast<int>(num_particles[1])) {
-                            size_t id2 = particle_ids[index(nx, ny)];
-                            const double r0 = ArrayUtils::L2Norm(particle_storage[id1].position - particle_storage[id2].position);
-                            forces.add_force(Harmonic(k, r0, cutoff), {id1, id2});
-                        }
+                for (const auto [dx, dy] : neighbors) {
+                    const int nx = x + dx;
+                    const int ny = y + dy;
+
+                    if (nx >= 0 && nx < static_cast<int>(num_particles[0]) && ny >= 0 && ny < static_cast<int>(num_particles[1])) {
+                        size_t id2 = particle_ids[index(nx, ny)];
+                        const double r0 = ArrayUtils::L2Norm((*this)[id1].position - (*this)[id2].position);
+                        add_bond(id1, id2, k, r0, exclude_bonded);
                     }
                 }
             }
         }
     }
 
+    void Environment::add_bond(const size_t id1, const size_t id2, const double k, const double r0, const bool exclude) {
+        WARN_IF_INIT("add a bond");
+        bonds.add_bond(id1, id2, k, r0, exclude);
+    }
+
+    void Environment::exclude(const size_t id1, const size_t id2) {
+        WARN_IF_INIT("add an exclusion");
+        bonds.add_exclusion(id1, id2);
+    }
+
+
+    void Environment::replicate(const unsigned int copies) {
+        WARN_IF_INIT("replicate the particles");
+        if (copies <= 1) return;
+        if (boundary.extent[0] == MAX_EXTENT || !std::isfinite(boundary.extent[0] * copies)) {
+            SPDLOG_ERROR("Unable to replicate the scenario, the boundary has no finite extent along the x-axis.");
+            throw std::invalid_argument("Replication requires a finite boundary extent along the x-axis.");
+        }
+
+        // a centered origin would move with the new extent, hence it is fixed to the original box
+        if (boundary.origin[0] == CENTER_BOUNDARY_ORIGIN) {
+            boundary.origin[0] = -boundary.extent[0] / 2;
+        }
+
+        const size_t num_particles = particle_storage.size();
+        particle_storage.reserve(num_particles * copies);
+        for (unsigned int k = 1; k < copies; ++k) {
+            const vec3 shift = {k * boundary.extent[0], 0, 0};
+            for (size_t i = 0; i < num_particles; ++i) {
+                const Particle& original = particle_storage[i];
+                add_particle(original.position + shift, original.velocity, original.mass, original.type,
+                             original.state, original.force);
+            }
+        }
+        forces.replicate_localized(num_particles, copies);
+        bonds.replicate(num_particles, copies);
+        boundary.extent[0] *= copies;
+
+        SPDLOG_INFO("Replicated the scenario {} times along the x-axis, {} particles in total.", copies,
+                    particle_storage.size());
+    }
 
     void Environment::add_sphere(const SphereCreateInfo& sphere) {
         add_sphere(sphere.origin, sphere.initial_v, sphere.radius, sphere.width, sphere.mass, sphere.thermal_v,
@@ -270,6 +341,7 @@ namespace md::env {
         }
 
         forces.init();
+        bonds.init();
         // check if grid constant is ok
         if (grid_constant > 0 && grid_constant < forces.cutoff()) {
             SPDLOG_WARN(
@@ -297,16 +369,19 @@ namespace md::env {
         if (dimension == Dimension::INFER) {
             dimension = Dimension::TWO;
             for (auto& p : particle_storage) {
-                if (p.position[3] != 0 || p.velocity[3] != 0) {
+                if (p.position[2] != 0 || p.velocity[2] != 0) {
                     dimension = Dimension::THREE;
                     break;
                 }
             }
         }
 
-        grid.build(boundary, grid_constant, particle_storage, build_blocks);
+        grid.build(boundary, grid_constant, particle_storage, build_blocks, dim());
+        direct_sum.init(forces, boundary, dim());
         initialized = true;
+        if (grid.cell_order() != CellOrder::LINEAR) compact(true);
         SPDLOG_INFO("Environment successfully built.");
+        log_memory_usage("after build");
     }
 
     /// -----------------------------------------
@@ -317,9 +392,15 @@ namespace md::env {
         return (x2 + n) - x1;
     }
 
+    template <int DIM>
     vec3 Environment::force(const Particle& p1, const Particle& p2, const CellPair& pair) const {
-        if (p1.type == Particle::STATIONARY && p2.type == Particle::STATIONARY) return {};
-        vec3 diff = p2.position - p1.position;
+        if ((p1.state == Particle::STATIONARY && p2.state == Particle::STATIONARY) ||
+            ((p1.state | p2.state) & Particle::DEAD)) {
+            PAIR_COUNT_SKIPPED(pair.cell1.particles.size());
+            return {};
+        }
+        vec3 diff{};
+        for (int k = 0; k < DIM; k++) diff[k] = p2.position[k] - p1.position[k];
 
         // handle force wrap around
         if (pair.periodicity & CellPair::PERIODIC_X) {
@@ -328,40 +409,215 @@ namespace md::env {
         if (pair.periodicity & CellPair::PERIODIC_Y) {
             diff[1] = wrap_around_diff(p1.position[1], p2.position[1], boundary.extent[1]);
         }
-        if (pair.periodicity & CellPair::PERIODIC_Z) {
+        if (DIM == 3 && pair.periodicity & CellPair::PERIODIC_Z) {
             diff[2] = wrap_around_diff(p1.position[2], p2.position[2], boundary.extent[2]);
         }
 
+        PAIR_COUNT_CANDIDATE(pair.cell1.particles.size(), ArrayUtils::L2NormSquared(diff),
+                             forces.cutoff() * forces.cutoff());
         return forces.evaluate(diff, p1, p2);
     }
 
+    template vec3 Environment::force<2>(const Particle&, const Particle&, const CellPair&) const;
+    template vec3 Environment::force<3>(const Particle&, const Particle&, const CellPair&) const;
+
+    void Environment::apply_bonded_forces(const bool parallel, const uint8_t kinds) {
+        if (bonds.empty()) return;
+        const std::array<bool, 3> periodic = {boundary.boundary_rules()[Boundary::LEFT] == PERIODIC,
+                                              boundary.boundary_rules()[Boundary::TOP] == PERIODIC,
+                                              boundary.boundary_rules()[Boundary::FRONT] == PERIODIC};
+
+#pragma omp parallel for schedule(static) if (parallel)
+        for (size_t i = 0; i < bonds.size(); ++i) {
+            vec3 force{};
+            if (contains(bonds.first[i]) && contains(bonds.second[i])) {
+                const Particle& p1 = (*this)[bonds.first[i]];
+                const Particle& p2 = (*this)[bonds.second[i]];
+                // same pairs as skipped by force(), nothing to exclude
+                if (!(p1.state == Particle::STATIONARY && p2.state == Particle::STATIONARY) &&
+                    !((p1.state | p2.state) & Particle::DEAD)) {
+                    // bonds do not belong to a cell pair, the nearest periodic image is used instead
+                    vec3 diff = p2.position - p1.position;
+                    for (int k = 0; k < 3; ++k) {
+                        if (!periodic[k]) continue;
+                        if (diff[k] > boundary.extent[k] / 2) diff[k] -= boundary.extent[k];
+                        else if (diff[k] < -boundary.extent[k] / 2) diff[k] += boundary.extent[k];
+                    }
+
+                    if (bonds.flags[i] & kinds & BondList::HARMONIC) {
+                        const double dist = ArrayUtils::L2Norm(diff);
+                        force = -bonds.stiffness[i] * (dist - bonds.length[i]) / dist * diff;
+                    }
+                    if (bonds.flags[i] & kinds & BondList::EXCLUDED) {
+                        force = force - forces.evaluate(diff, p1, p2);
+                    }
+                }
+            }
+            bonds.forces[i] = force;
+        }
+
+#pragma omp parallel for schedule(static) if (parallel)
+        for (size_t j = 0; j < bonds.particles.size(); ++j) {
+            if (!contains(bonds.particles[j])) continue;
+            Particle& particle = (*this)[bonds.particles[j]];
+            for (size_t e = bonds.offsets[j]; e < bonds.offsets[j + 1]; ++e) {
+                const vec3& force = bonds.forces[bonds.ends[e] / 2];
+                particle.force = bonds.ends[e] % 2 ? particle.force + force : particle.force - force;
+            }
+        }
+    }
+
+    size_t Environment::bond_count() const {
+        return bonds.size();
+    }
+
+    bool Environment::direct_sum_supported() const {
+        return direct_sum.supported();
+    }
+
+    bool Environment::direct_sum_suitable() {
+        if (!direct_sum_supported()) return false;
+        const size_t n = size(static_cast<Particle::State>(Particle::ALIVE | Particle::STATIONARY));
+        return n * (n - 1) / 2 <= DIRECT_SUM_PAIR_RATIO * pair_candidates();
+    }
+
+    void Environment::apply_direct_sum(const bool parallel) {
+        direct_sum.compute(*this, parallel);
+    }
+
+    utils::MemoryUsage Environment::memory_usage() const {
+        utils::MemoryUsage usage;
+        usage.add("particles", utils::vector_bytes(particle_storage) + utils::vector_bytes(id_to_index));
+        grid.memory_usage(usage);
+        forces.memory_usage(usage);
+        bonds.memory_usage(usage);
+        return usage;
+    }
+
+    void Environment::log_memory_usage(const std::string& context) const {
+        // walking all cells is not free, skip it if the message would be dropped anyway
+        if (!spdlog::default_logger_raw()->should_log(spdlog::level::info)) return;
+        SPDLOG_INFO("Memory usage {} ({} particles):\n{}", context, particle_storage.size(),
+                    memory_usage().to_string(particle_storage.size()));
+    }
+
     size_t Environment::size(const Particle::State state) const {
-        if (state == Particle::DEAD)
-            return particle_storage.size() - grid.particle_count();
-        if (state == Particle::STATIONARY)
-            return num_stat_particles;
-        if (state == Particle::ALIVE)
-            return grid.particle_count() - num_stat_particles;
-        if (state == (Particle::ALIVE | Particle::STATIONARY))
-            return grid.particle_count();
-        if (state == (Particle::DEAD | Particle::ALIVE | Particle::STATIONARY))
-            return particle_storage.size();
-        SPDLOG_ERROR("invalid particle state or unsupported state combination in Environment::size: {}", static_cast<int>(state));
-        exit(3000);
+        size_t count = 0;
+        for (const auto s : {Particle::ALIVE, Particle::DEAD, Particle::STATIONARY}) {
+            if (state & s) count += grid.state_list(s).size();
+        }
+        return count;
+    }
+
+    size_t Environment::removed_count() const {
+        return removed;
+    }
+
+    size_t Environment::id_count() const {
+        return id_to_index.size();
+    }
+
+    bool Environment::occupied(const vec3& position, const double distance) const {
+        return grid.occupied(position, distance);
+    }
+
+    bool Environment::contains(const size_t id) const {
+        return id < id_to_index.size() && id_to_index[id] != REMOVED_PARTICLE;
+    }
+
+    size_t Environment::compact(const bool cell_order) {
+        const size_t dead = size(Particle::DEAD);
+        if (!initialized || (dead == 0 && !cell_order)) return 0;
+
+        std::vector<const Particle*> order;
+        order.reserve(particle_storage.size() - dead);
+        if (cell_order) {
+            for (const auto& idx : grid.get_cell_indices()) {
+                for (const Particle* particle : grid.get_cell(idx).particles) order.push_back(particle);
+            }
+        } else {
+            for (const auto& particle : particle_storage) {
+                if (particle.state != Particle::DEAD) order.push_back(&particle);
+            }
+        }
+
+        std::vector<Particle> packed;
+        packed.reserve(order.size());
+        std::ranges::fill(id_to_index, REMOVED_PARTICLE);
+        for (const Particle* particle : order) {
+            id_to_index[particle->id] = packed.size();
+            packed.push_back(*particle);
+        }
+        particle_storage = std::move(packed);
+        grid.relink(particle_storage);
+
+        removed += dead;
+        SPDLOG_DEBUG("Removed {} dead particles from the storage, {} particles left.", dead, particle_storage.size());
+        return dead;
     }
 
     const std::vector<CellPair>& Environment::linked_cells() {
         return grid.linked_cells();
     }
 
+    const std::vector<std::vector<CellPair>>& Environment::cell_shells() {
+        return grid.cell_shells();
+    }
+
     const std::vector<std::vector<Block>>& Environment::block_sets() {
         return grid.block_sets();
     }
 
+    size_t Environment::pair_candidates() {
+        size_t count = 0;
+        auto add_pairs = [&](const std::vector<CellPair>& cell_pairs) {
+            for (const auto& cell_pair : cell_pairs) {
+                const size_t n1 = cell_pair.cell1.particles.size();
+                if (cell_pair.cell1.id == cell_pair.cell2.id) {
+                    count += n1 * (n1 - 1) / 2;
+                } else {
+                    count += n1 * cell_pair.cell2.particles.size();
+                }
+            }
+        };
+
+        // with spatial decomposition the cell pairs are only stored in the blocks
+        add_pairs(grid.linked_cells());
+        for (const auto& set : grid.block_sets()) {
+            for (const auto& block : set) add_pairs(block.cell_pairs);
+        }
+        return count;
+    }
+
     void Environment::apply_boundary(Particle& particle) {
         const auto& current = grid.get_cell(particle.cell);
         const auto& previous = grid.get_cell(grid.what_cell(particle.old_position));
-        boundary.apply_boundary(particle, current, previous);
+        if (boundary.apply_boundary(particle, current, previous)) particle.set_state(Particle::DEAD);
+    }
+
+    void Environment::apply_boundary() {
+        const auto& rules = boundary.boundary_rules();
+        for (size_t face = 0; face < rules.size(); face++) {
+            if (rules[face] != REPULSIVE_FORCE) continue;
+            for (const GridCell* cell : grid.boundary_cells(static_cast<Boundary::Face>(face))) {
+                boundary.apply_wall_force(static_cast<Boundary::Face>(face), *cell);
+            }
+        }
+
+        // periodic and reflecting rules move the current particle out of the outside list, which swaps the last entry
+        // into its slot. Iterating backwards, that entry has already been visited.
+        const auto& outside = grid.outside_list().indices();
+        std::vector<Particle*> removed;
+        for (size_t i = outside.size(); i-- > 0;) {
+            Particle& particle = (*this)[outside[i]];
+            if (particle.state != Particle::ALIVE) continue;
+            const auto& current = grid.get_cell(particle.cell);
+            const auto& previous = grid.get_cell(grid.what_cell(particle.old_position));
+            if (boundary.apply_boundary(particle, current, previous)) removed.push_back(&particle);
+        }
+        for (Particle* particle : removed) {
+            particle->set_state(Particle::DEAD);
+        }
     }
 
     double Environment::temperature(const vec3& avg_vel) const {
@@ -384,14 +640,20 @@ namespace md::env {
     }
 
 
-    Particle& Environment::operator[](const size_t id) { return particle_storage[id]; }
+    Particle& Environment::operator[](const size_t id) {
+        ASSERT(contains(id), "The particle has been removed.");
+        return particle_storage[id_to_index[id]];
+    }
 
-    const Particle& Environment::operator[](const size_t id) const { return particle_storage[id]; }
+    const Particle& Environment::operator[](const size_t id) const {
+        ASSERT(contains(id), "The particle has been removed.");
+        return particle_storage[id_to_index[id]];
+    }
 
     bool Environment::filter_particles(const Particle& particle, const Particle::State state,
                                        const GridCell::Type type) const {
         const bool state_ok = particle.state & state;
-        const bool location_ok = grid.get_cell(particle).type & type;
+        const bool location_ok = grid.region(particle.id) & type;
         return state_ok && location_ok;
     }
 } // namespace md::env
@@ -1,16 +1,20 @@
 #pragma once
 
 #include <array>
+#include <limits>
 #include <ranges>
 #include <vector>
 
+#include "BondList.h"
 #include "Boundary.h"
 #include "Common.h"
+#include "DirectSum.h"
 #include "Force.h"
 #include "Particle.h"
 #include "ParticleGrid.h"
 
 #define GRID_CONSTANT_AUTO 0
+#define REMOVED_PARTICLE std::numeric_limits<size_t>::max()
 
 /**
  * @brief Contains classes and structures for managing the environment of the simulation.
@@ -37,13 +41,16 @@ namespace md::env {
          * @param mass Mass of particle (default: 0).
          * @param type Type of particle (default: 0).
          * @param state The state of the particles (default: ALIVE).
+         * @param force Initial force of the particle (default: {0, 0, 0}).
          */
-        ParticleCreateInfo(const vec3& position, const vec3& velocity, double mass, int type = 0,  Particle::State state = Particle::ALIVE);
+        ParticleCreateInfo(const vec3& position, const vec3& velocity, double mass, int type = 0,
+            Particle::State state = Particle::ALIVE, const vec3& force = {});
         vec3 position{};
         vec3 velocity{};
         double mass = 0;
         int type = 0;
         Particle::State state = Particle::ALIVE;
+        vec3 force{};
     };
 
     /**
@@ -140,26 +147,37 @@ namespace md::env {
          * @param boundary The boundary condition to be used.
          */
         void set_boundary(const Boundary& boundary);
+        /**
+         * @brief Sets the order of the grid cells, see ParticleGrid::set_cell_order. Along a space filling curve, the
+         * particle storage is also sorted in cell order once the environment is built.
+         * @param order The cell order.
+         */
+        void set_cell_order(CellOrder order);
         /**
         * @brief Sets the dimension of the environment.
         * @param dim The dimension.
         */
         void set_dimension(Dimension dim);
         /**
-         * @brief Adds a single particle to the environment.
+         * @brief Adds a single particle to the environment. After build(), the particle is inserted into the cell of
+         * its position right away, its type must have a force set before the build. The storage grows geometrically,
+         * if it is reallocated, references and pointers to particles are invalidated but ids stay valid.
          * @param position Position of the particle.
          * @param velocity Velocity of the particle.
          * @param mass Mass of the particle.
          * @param type Type of the particle.
          * @param state State of the particle (default: ALIVE).
          * @param force Initial force of the particle (default: {0, 0, 0}).
+         * @return The id of the particle, ids are handed out consecutively.
          */
         size_t add_particle(const vec3& position, const vec3& velocity, double mass, int type = 0, Particle::State state = Particle::ALIVE, const vec3& force = {});
         /**
-         * @brief Adds multiple particles to the environment.
+         * @brief Adds multiple particles to the environment, also after build(), see add_particle.
+         * The storage is reserved once up front, so this is the preferred way to insert large particle sets.
          * @param particles A ParticleCreateInfo vector describing the particles.
+         * @return The id of the first particle, the others follow consecutively.
          */
-        void add_particles(const std::vector<ParticleCreateInfo>& particles);
+        size_t add_particles(const std::vector<ParticleCreateInfo>& particles);
         /**
          * @brief Adds a cuboid to the environment.
          * @param cuboid A CuboidCreateInfo describing the cuboid.
@@ -201,39 +219,106 @@ namespace md::env {
             double thermal_v = 0, int type = 0, Dimension dimension = Dimension::INFER,
             Particle::State state = Particle::ALIVE);
         /**
-         * @brief Adds a membrane to the environment.
+         * @brief Adds a membrane to the environment. Direct and diagonal neighbors are connected by harmonic bonds,
+         * see add_bond.
          * @param origin Coordinates of the origin.
          * @param velocity Initial velocity of the particles.
          * @param num_particles Number of particles of the membrane.
          * @param width Distance between particles.
          * @param mass Mass of the particles.
          * @param k Stiffness constant.
-         * @param cutoff cutoff.
+         * @param cutoff Cutoff of the harmonic bonds, unused as bonds are evaluated independent of the grid.
          * @param type The type of the particles (default: 0).
+         * @param exclude_bonded Whether the nonbonded force between bonded neighbors is excluded (default: false).
          */
         void add_membrane(const vec3& origin, const vec3& velocity, const uint3& num_particles, double width,
-            double mass, double k, double cutoff, int type = 0);
+            double mass, double k, double cutoff, int type = 0, bool exclude_bonded = false);
+        /**
+         * @brief Adds a harmonic bond between two particles, evaluated in apply_bonded_forces every step no matter
+         * how far apart the particles are. Each pair must only be bonded once.
+         * @param id1 The id of the first particle.
+         * @param id2 The id of the second particle.
+         * @param k The stiffness constant.
+         * @param r0 The rest length.
+         * @param exclude Whether the nonbonded force between the particles is excluded (default: false).
+         */
+        void add_bond(size_t id1, size_t id2, double k, double r0, bool exclude = false);
+        /**
+         * @brief Excludes the nonbonded force between two particles that are not bonded, see add_bond.
+         * @param id1 The id of the first particle.
+         * @param id2 The id of the second particle.
+         */
+        void exclude(size_t id1, size_t id2);
+
+        /**
+         * @brief Replicates the scenario along the x-axis, e.g. to generate inputs for weak scaling runs.
+         * All particles (and the forces and bonds between specific particles) are copied and shifted by multiples of the boundary
+         * extent in x, after which the extent is scaled by the number of copies. Must be called after the boundary is
+         * set and before the environment is built.
+         * @param copies Total number of copies, including the original scenario.
+         * @throws std::invalid_argument if the boundary is unbounded along the x-axis.
+         */
+        void replicate(unsigned int copies);
 
 
 
         /**
          * @brief Computes the force between two particles.
+         * @tparam DIM The number of dimensions, the distance along the remaining axes is taken as 0 (default: 3).
          * @param p1 The first particle.
          * @param p2 The second particle.
          * @param pair The cellPair.
          * @return The force between the two particles.
          */
+        template <int DIM = 3>
         [[nodiscard]] vec3 force(const Particle& p1, const Particle& p2, const CellPair & pair) const;
         /**
-         * @brief Provides access to particles filtered by grid cell type and state.
+         * @brief Adds the bonded forces to the particles. The force of every bond is computed first, then each bonded
+         * particle sums up the forces of its bonds, so both loops run in parallel without locks and the result does
+         * not depend on the number of threads. Excluded pairs get the nonbonded force of the linked cells subtracted,
+         * which keeps the pair force loop free of exclusion lookups.
+         * @param parallel Whether the loops are run by all OpenMP threads.
+         * @param kinds The BondList::Flags to evaluate, the springs and exclusions can be applied separately as the
+         * exclusions belong to the pair forces, e.g. for r-RESPA (default: both).
+         */
+        void apply_bonded_forces(bool parallel = false, uint8_t kinds = BondList::HARMONIC | BondList::EXCLUDED);
+        /**
+         * @brief Returns the number of bonds and exclusions.
+         * @return The number of bonds.
+         */
+        [[nodiscard]] size_t bond_count() const;
+        /**
+         * @brief Checks if the DirectSum supports the forces and the boundary, see DirectSum::supported.
+         * @return "true" if the pair forces can be computed by the direct sum, "false" otherwise.
+         */
+        [[nodiscard]] bool direct_sum_supported() const;
+        /**
+         * @brief Checks if the pair forces are better computed by the direct sum than by the linked cells: the
+         * DirectSum supports the forces and the boundary, and it evaluates at most DIRECT_SUM_PAIR_RATIO times the pair
+         * candidates of the linked cells, e.g. for few cells or an unbounded domain in a single cell.
+         * @return "true" if the direct sum should be used, "false" otherwise.
+         */
+        [[nodiscard]] bool direct_sum_suitable();
+        /**
+         * @brief Adds the pair forces of all particle pairs to the particles, see DirectSum. Gives the same forces as
+         * the linked cells if direct_sum_suitable.
+         * @param parallel Whether the pairs are evaluated by all OpenMP threads.
+         */
+        void apply_direct_sum(bool parallel = false);
+        /**
+         * @brief Provides access to particles filtered by grid cell type and state. Only the index lists of the grid
+         * that can contain matching particles are visited, see ParticleGrid::particle_sources. The order of the
+         * particles is unspecified and the states and cells of the particles must not change during the iteration.
          * @param type The type to filter (default: GridCell::Inside).
          * @param state The state to filter (default: (GridCell::ALIVE).
          * @return A range of particles matching the specified type and state.
          */
         auto particles(GridCell::Type type = GridCell::INSIDE, Particle::State state = Particle::ALIVE) {
-            return particle_storage | std::ranges::views::filter([this, state, type](const Particle& particle) {
-                return filter_particles(particle, state, type);
-            });
+            return grid.particle_sources(type, state) | std::views::join |
+                   std::views::transform([this](const size_t id) -> Particle& { return (*this)[id]; }) |
+                   std::views::filter([this, state, type](const Particle& particle) {
+                       return filter_particles(particle, state, type);
+                   });
         }
         /**
         * @brief Provides access to particles filtered by grid cell type and state (const version).
@@ -243,9 +328,20 @@ namespace md::env {
         */
         [[nodiscard]] auto particles(GridCell::Type type = GridCell::INSIDE,
                                      Particle::State state = Particle::ALIVE) const {
-            return particle_storage | std::ranges::views::filter([this, state, type](const Particle& particle) {
-                return filter_particles(particle, state, type);
-            });
+            return grid.particle_sources(type, state) | std::views::join |
+                   std::views::transform([this](const size_t id) -> const Particle& { return (*this)[id]; }) |
+                   std::views::filter([this, state, type](const Particle& particle) {
+                       return filter_particles(particle, state, type);
+                   });
+        }
+        /**
+         * @brief Returns the ids of all particles of a state, e.g. for index based parallel loops. The order is
+         * unspecified.
+         * @param state A single state.
+         * @return The ids of the particles.
+         */
+        [[nodiscard]] const std::vector<size_t>& particle_ids(const Particle::State state) const {
+            return grid.state_list(state).indices();
         }
         /**
          * @brief Retrieves the linked grid cells in the simulation.
@@ -253,12 +349,24 @@ namespace md::env {
          */
         const std::vector<CellPair>& linked_cells();
 
+        /**
+         * @brief Retrieves the full neighbor shell of each grid cell, used for the evaluation without Newton's third law.
+         * @return A const reference to the vector of the shells, each a vector of cell pairs starting at its cell.
+         */
+        const std::vector<std::vector<CellPair>>& cell_shells();
+
         /**
          * @brief Retrieves the block sets of the simulation, used for spatial decomposition parallelization.
          * @return A vector of vectors of Block objects.
          */
         const std::vector<std::vector<Block>>& block_sets();
 
+        /**
+         * @brief Counts the particle pairs of the linked cells, including those of the blocks.
+         * @return The number of pair candidates.
+         */
+        [[nodiscard]] size_t pair_candidates();
+
 
         /**
          * @brief Applies the boundary conditions to a particle.
@@ -266,6 +374,13 @@ namespace md::env {
          */
         void apply_boundary(Particle& particle);
 
+        /**
+         * @brief Applies the boundary conditions to all alive particles, as done once per step. Repulsive forces are
+         * applied face by face to the particles of the boundary cells of that face, the other rules only concern the
+         * particles that left the domain. Particles leaving through an outflow face are removed after the pass.
+         */
+        void apply_boundary();
+
         /**
          * @brief Computes the average velocity of the particles.
          * @return The average velocity.
@@ -295,11 +410,60 @@ namespace md::env {
 
 
         /**
-         * Returns the number of particles of a certain state in the environment.
-         * @param state The state of the particles to count (default: Particle::ALIVE).
+         * @brief Removes the dead particles from the storage and repacks it, optionally in the order of the grid cells
+         * so that particles of the same cell are adjacent in memory. The ids of the particles do not change, only
+         * their storage index, hence ids held elsewhere (marked particles, localized forces, output) stay valid.
+         * References and pointers to particles are invalidated. Does nothing before the environment is built.
+         * @param cell_order Whether to repack the particles cell by cell instead of in their current order.
+         * @return The number of removed particles.
+         */
+        size_t compact(bool cell_order = false);
+
+        /**
+         * @brief Returns whether a particle with the given id is stored, i.e. has not been removed by compact().
+         * @param id The ID of the particle.
+         * @return "true" if the particle exists, "false" otherwise.
+         */
+        [[nodiscard]] bool contains(size_t id) const;
+
+        /**
+         * Returns the number of particles of a certain state in the environment in O(1). Dead particles removed by
+         * compact() are not counted.
+         * @param state The state or combination of states of the particles to count (default: Particle::ALIVE).
          * @return The number of particles.
          */
         [[nodiscard]] size_t size(Particle::State state = Particle::ALIVE) const;
+
+        /**
+         * @brief Returns the number of dead particles removed from the storage by compact().
+         * @return The number of removed particles.
+         */
+        [[nodiscard]] size_t removed_count() const;
+
+        /**
+         * @brief Returns the number of ids handed out so far, which is the id of the next added particle.
+         * @return The number of ids.
+         */
+        [[nodiscard]] size_t id_count() const;
+
+        /**
+         * @brief Checks whether an alive or stationary particle lies within a distance of a position, see
+         * ParticleGrid::occupied. The environment must be built.
+         * @param position The position, must be inside the domain.
+         * @param distance The distance.
+         * @return "true" if a particle is closer than the distance, "false" otherwise.
+         */
+        [[nodiscard]] bool occupied(const vec3& position, double distance) const;
+        /**
+         * @brief Returns the bytes allocated by the particles, the grid and the force tables.
+         * @return The memory usage per subsystem.
+         */
+        [[nodiscard]] utils::MemoryUsage memory_usage() const;
+        /**
+         * @brief Logs the memory usage per subsystem and per particle together with the resident set size.
+         * @param context Describes when the usage is logged, e.g. "after build".
+         */
+        void log_memory_usage(const std::string& context) const;
         /**
          * @brief Returns the dimension of the environment.
          * @return The dimension.
@@ -307,13 +471,13 @@ namespace md::env {
         [[nodiscard]] int dim() const;
 
         /**
-         * @brief Accesses particle by its ID.
+         * @brief Accesses particle by its ID. The particle must not have been removed by compact().
          * @param id The ID of the particle.
          * @return A reference to the particle.
          */
         Particle& operator[](size_t id);
         /**
-         * @brief Accesses particle by its ID (const version).
+         * @brief Accesses particle by its ID (const version). The particle must not have been removed by compact().
          * @param id The ID of the particle.
          * @return A reference to the particle.
          */
@@ -337,15 +501,25 @@ namespace md::env {
          */
         [[nodiscard]] bool filter_particles(const Particle& particle, Particle::State state, GridCell::Type type) const;
 
+        /**
+         * @brief Reserves storage for additional particles. After build(), the capacity grows at least geometrically
+         * and the grid is relinked if the storage is reallocated, as the cells point into it.
+         * @param additional The number of particles that will be added.
+         */
+        void reserve_particles(size_t additional);
+
         std::vector<Particle> particle_storage; ///< vector with all particles
+        std::vector<size_t> id_to_index;        ///< Storage index of each particle id, REMOVED_PARTICLE once compacted.
+        size_t removed = 0;                     ///< Number of dead particles removed by compact().
 
         Boundary boundary;     ///< Boundary conditions of the environment.
         ParticleGrid grid;     ///< Grid of the environment.
         ForceManager forces;   ///< Forces with which the particles interact.
+        BondList bonds;        ///< Bonds and exclusions between specific particles.
+        DirectSum direct_sum;  ///< All pairs evaluation of the forces.
 
         Dimension dimension;  ///< Dimension of the simulation
         double grid_constant; ///< Used grid Constant in the environment.
         bool initialized;     ///< Indicates whether the environment has been initialized.
-        unsigned num_stat_particles;   ///< Number of stationary particles.
     };
 } // namespace md::env
@@ -1,5 +1,6 @@
 #include "Force.h"
 
+#include <algorithm>
 #include <ranges>
 
 namespace md::env {
@@ -86,13 +87,17 @@ namespace md::env {
                 auto force1 = global_force_types[static_cast<int>(i)];
                 auto force2 = global_force_types[static_cast<int>(j)];
 
-                global_forces[{types[i], types[j]}] = mix_forces(force1, force2);
-                cutoff_radius = std::max(cutoff_radius, global_forces[{types[i], types[j]}].cutoff() );
+                ForceType mixed = mix_types(force1, force2);
+                global_forces[{types[i], types[j]}] = create_force(mixed);
+                const double cutoff = global_forces[{types[i], types[j]}].cutoff();
+                std::visit([cutoff](auto& config) { config.cutoff = cutoff; }, mixed);
+                global_configs[{types[i], types[j]}] = mixed;
+                cutoff_radius = std::max(cutoff_radius, cutoff);
             }
         }
 
         for (auto [particle_ids, force] : localized_force_types) {
-            localized_forces[particle_ids] = mix_forces(force, force);
+            localized_forces[particle_ids] = create_force(mix_types(force, force));
             cutoff_radius = std::max(cutoff_radius, localized_forces[particle_ids].cutoff() );
         }
 
@@ -109,6 +114,17 @@ namespace md::env {
         localized_force_types[particle_ids] = force;
     }
 
+    void ForceManager::replicate_localized(const size_t num_particles, const unsigned int copies) {
+        const std::vector<std::pair<ParticleIDPair, ForceType>> originals(localized_force_types.begin(),
+                                                                           localized_force_types.end());
+        for (unsigned int k = 1; k < copies; ++k) {
+            const size_t offset = k * num_particles;
+            for (const auto& [ids, force] : originals) {
+                localized_force_types[{ids.first + offset, ids.second + offset}] = force;
+            }
+        }
+    }
+
     vec3 ForceManager::evaluate(const vec3& diff, const Particle& p1, const Particle& p2) const {
         vec3 force = global_forces.at({p1.type, p2.type})(diff, p1, p2);
 
@@ -125,14 +141,39 @@ namespace md::env {
         return cutoff_radius;
     }
 
-    Force ForceManager::mix_forces(const ForceType& force1, const ForceType& force2) {
+    std::vector<int> ForceManager::types() const {
+        std::vector<int> types;
+        for (const auto& key : std::views::keys(global_configs)) {
+            if (key.first == key.second) types.push_back(key.first);
+        }
+        std::ranges::sort(types);
+        return types;
+    }
+
+    const ForceType& ForceManager::pair_config(const int type1, const int type2) const {
+        return global_configs.at({type1, type2});
+    }
+
+    bool ForceManager::has_localized_forces() const {
+        return !localized_forces.empty();
+    }
+
+    void ForceManager::memory_usage(utils::MemoryUsage& usage) const {
+        usage.add("type pair forces", utils::node_hash_bytes(global_force_types) +
+                                          utils::dense_hash_bytes(global_forces) +
+                                          utils::dense_hash_bytes(global_configs));
+        usage.add("localized forces",
+                  utils::node_hash_bytes(localized_force_types) + utils::dense_hash_bytes(localized_forces));
+    }
+
+    ForceType ForceManager::mix_types(const ForceType& force1, const ForceType& force2) {
         // Check if both are Lennard-Jones
         if (const auto* lj1 = std::get_if<LennardJones>(&force1)) {
             if (const auto* lj2 = std::get_if<LennardJones>(&force2)) {
                 const double eps = sqrt(lj1->epsilon * lj2->epsilon);
                 const double sigma = (lj1->sigma + lj2->sigma) / 2;
                 const double cutoff = std::max(lj1->cutoff, lj2->cutoff);
-                return LennardJonesForce(eps, sigma, cutoff);
+                return LennardJones(eps, sigma, cutoff);
             }
         }
         // Check if both are inverse square
@@ -140,7 +181,7 @@ namespace md::env {
             if (const auto* is2 = std::get_if<InverseSquare>(&force2)) {
                 const double G = sqrt(is1->pre_factor * is2->pre_factor);
                 const double cutoff = std::max(is1->cutoff, is2->cutoff);
-                return InverseSquareForce(G, cutoff);
+                return InverseSquare(G, cutoff);
             }
         }
 
@@ -150,11 +191,22 @@ namespace md::env {
                 const double r0 = (h1->r0 + h2->r0) / 2;
                 const double k = (h1->k + h2->k) / 2;
                 const double cutoff = std::max(h1->cutoff, h2->cutoff);
-                return HarmonicForce(k, r0, cutoff);
+                return Harmonic(k, r0, cutoff);
             }
         }
 
         // Unsupported combination
         throw std::invalid_argument("Unsupported force type combination.");
     }
+
+    Force ForceManager::create_force(const ForceType& force) {
+        if (const auto* lj = std::get_if<LennardJones>(&force)) {
+            return LennardJonesForce(lj->epsilon, lj->sigma, lj->cutoff);
+        }
+        if (const auto* is = std::get_if<InverseSquare>(&force)) {
+            return InverseSquareForce(is->pre_factor, is->cutoff);
+        }
+        const auto& h = std::get<Harmonic>(force);
+        return HarmonicForce(h.k, h.r0, h.cutoff);
+    }
 }
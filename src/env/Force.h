@@ -6,6 +6,7 @@
 #include <variant>
 #include "Common.h"
 #include "utils/ArrayUtils.h"
+#include "utils/MemoryUtils.h"
 #include "Particle.h"
 #include "ankerl/unordered_dense.h"
 
@@ -116,6 +117,32 @@ namespace md::env {
         ForceFunc force_func{}; ///< The force function used for the calculations.
     };
 
+    /**
+     * @brief Creates an inverse-square force.
+     * @param pre_factor The pre-factor of inverse square force.
+     * @param cutoff_radius The cutoff-radius, FORCE_CUTOFF_AUTO selects 10 * pre_factor.
+     * @return The force object.
+     */
+    Force InverseSquareForce(double pre_factor, double cutoff_radius);
+
+    /**
+     * @brief Creates a Lennard-Jones force.
+     * @param epsilon The lennard-jones epsilon.
+     * @param sigma The lennard-jones sigma.
+     * @param cutoff_radius The cutoff-radius, FORCE_CUTOFF_AUTO selects 3 * sigma.
+     * @return The force object.
+     */
+    Force LennardJonesForce(double epsilon, double sigma, double cutoff_radius);
+
+    /**
+     * @brief Creates a harmonic force.
+     * @param k The stiffness constant.
+     * @param r0 The average bond length.
+     * @param cutoff_radius The cutoff-radius, FORCE_CUTOFF_AUTO selects 2 * r0.
+     * @return The force object.
+     */
+    Force HarmonicForce(double k, double r0, double cutoff_radius);
+
 
     /**
      * @brief Manages forces of particles with different types.
@@ -163,8 +190,23 @@ namespace md::env {
          * @param particle_type The type of particle for which the force should apply.
          */
         void add_force(const ForceType& force, int particle_type);
+        /**
+         * @brief Adds a force between two specific particles on top of the type pair force. It is only evaluated if
+         * the particles are within the same or neighboring cells and every pair evaluation looks it up as long as
+         * there is any, springs should be added as bonds instead, see BondList.
+         * @param force The force configuration to add.
+         * @param particle_ids The ids of the particles, in the order of the pair evaluation.
+         */
         void add_force(const ForceType& force, const ParticleIDPair& particle_ids);
 
+        /**
+         * @brief Duplicates the forces between specific particles for copies of the particle set.
+         * The particles of the k-th copy are expected to have the IDs of the originals shifted by k * num_particles.
+         * @param num_particles Number of particles of the original set.
+         * @param copies Total number of copies, including the original.
+         */
+        void replicate_localized(size_t num_particles, unsigned int copies);
+
         /**
          * @brief Evaluates the force between two particles.
          * @param diff The difference of the particles.
@@ -180,19 +222,53 @@ namespace md::env {
          */
         double cutoff() const;
 
+        /**
+         * @brief Returns the particle types with a force, available after init.
+         * @return The types in ascending order.
+         */
+        [[nodiscard]] std::vector<int> types() const;
+
+        /**
+         * @brief Returns the mixed configuration of the force between two particle types, available after init. Its
+         * cutoff is the one of the evaluated force, i.e. FORCE_CUTOFF_AUTO is resolved.
+         * @param type1 The type of the first particle.
+         * @param type2 The type of the second particle.
+         * @return The configuration.
+         */
+        [[nodiscard]] const ForceType& pair_config(int type1, int type2) const;
+
+        /**
+         * @brief Returns whether forces between specific particles were added.
+         * @return "true" if there is any force between specific particles, "false" otherwise.
+         */
+        [[nodiscard]] bool has_localized_forces() const;
+
+        /**
+         * @brief Adds the bytes allocated by the force tables.
+         * @param usage The memory usage to add to.
+         */
+        void memory_usage(utils::MemoryUsage& usage) const;
+
     private:
         /**
-         * @brief Combines two forces into a single force object for two different types of forces.
+         * @brief Combines two force configurations into a single configuration for two different types of forces.
          * The Lorentz-Berthelot mixing rule is used.
          *
          * @param force1 The first force to combine.
          * @param force2 The second force to combine.
-         * @return A new "Force" object representing the combination of the two forces.
+         * @return The configuration of the combination of the two forces.
          *
          * @throws std::invalid_argument if the two forces are of incompatible types (e.g. one "Lennard-Jones" and
          * one "InverseSquare", as this is not supported.
          */
-        static Force mix_forces(const ForceType& force1, const ForceType& force2);
+        static ForceType mix_types(const ForceType& force1, const ForceType& force2);
+
+        /**
+         * @brief Creates the force object of a configuration.
+         * @param force The configuration.
+         * @return The force object.
+         */
+        static Force create_force(const ForceType& force);
 
         std::unordered_map<ParticleType, ForceType> global_force_types;
         ///< Map of particle types to force type.
@@ -200,6 +276,8 @@ namespace md::env {
         ///< Map of particle pairs to force configurations.
         ankerl::unordered_dense::map<ParticleTypePair, Force, ForceKeyHash> global_forces;
         ///< forces between particle types.
+        ankerl::unordered_dense::map<ParticleTypePair, ForceType, ForceKeyHash> global_configs;
+        ///< mixed configurations of the forces between particle types.
         ankerl::unordered_dense::map<ParticleIDPair, Force, ForceKeyHash> localized_forces;
         ///< forces between specific particles.
         double cutoff_radius; ///< The cutoff radius.
@@ -57,6 +57,10 @@ namespace md::env {
         cell = grid.what_cell(position);
     }
 
+    void Particle::set_state(const State new_state) {
+        grid.update_state(this, new_state);
+    }
+
     std::string Particle::to_string() const {
         std::stringstream stream;
         using ::operator<<;
@@ -65,6 +65,13 @@ namespace md::env {
          */
         void update_grid();
 
+        /**
+         * @brief Changes the state of the particle and updates the index lists and cells of the grid. The state must
+         * not be assigned directly once the particle belongs to an environment.
+         * @param new_state The new state.
+         */
+        void set_state(State new_state);
+
         /**
          * @brief Compares the particle to another regarding equality.
          * @param other The Particle object to compare with.
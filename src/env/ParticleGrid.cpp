@@ -1,6 +1,9 @@
 #include "ParticleGrid.h"
 
+#include <algorithm>
+#include <bit>
 #include <cmath>
+#include <numeric>
 #include <ranges>
 #include <sstream>
 #include <string>
@@ -8,6 +11,7 @@
 #include "io/Logger/Logger.h"
 #include "io/input/xml/molSimSchema.hxx"
 #include "utils/ArrayUtils.h"
+#include "utils/SpaceFillingCurve.h"
 
 #define DOUBLE_MIN std::numeric_limits<double>::min()
 #define DOUBLE_MAX std::numeric_limits<double>::max()
@@ -21,11 +25,65 @@
 namespace md::env {
     int GridCell::count = 0;
 
+    namespace {
+        /**
+         * @brief Returns the index of the list of a single state in ParticleGrid::state_lists.
+         */
+        size_t state_index(const Particle::State state) { return std::countr_zero(static_cast<unsigned>(state)); }
+
+        /// Number of distinct combinations of boundary faces of a cell.
+        constexpr size_t FACE_COMBINATIONS = 64;
+
+        /**
+         * @brief The faces of every combination of boundary bits of a cell type, in the order of Boundary::Face.
+         */
+        struct FaceTable {
+            std::array<std::array<Boundary::Face, 6>, FACE_COMBINATIONS> faces{};
+            std::array<size_t, FACE_COMBINATIONS> counts{};
+        };
+
+        /**
+         * @brief Returns the index of the face combination of a cell type in the face table.
+         */
+        constexpr size_t face_bits(const GridCell::Type type) {
+            return (static_cast<unsigned>(type) & static_cast<unsigned>(GridCell::BOUNDARY)) >> 4;
+        }
+
+        constexpr FaceTable make_face_table() {
+            constexpr std::array<std::pair<Boundary::Face, GridCell::Type>, 6> face_types = {{
+                {Boundary::LEFT, GridCell::BOUNDARY_LEFT},
+                {Boundary::RIGHT, GridCell::BOUNDARY_RIGHT},
+                {Boundary::TOP, GridCell::BOUNDARY_TOP},
+                {Boundary::BOTTOM, GridCell::BOUNDARY_BOTTOM},
+                {Boundary::FRONT, GridCell::BOUNDARY_FRONT},
+                {Boundary::BACK, GridCell::BOUNDARY_BACK},
+            }};
+
+            FaceTable table;
+            for (size_t bits = 0; bits < FACE_COMBINATIONS; ++bits) {
+                for (const auto& [face, type] : face_types) {
+                    if (bits & face_bits(type)) table.faces[bits][table.counts[bits]++] = face;
+                }
+            }
+            return table;
+        }
+
+        constexpr FaceTable FACE_TABLE = make_face_table();
+
+        /**
+         * @brief Returns the boundary faces of a cell type.
+         */
+        std::span<const Boundary::Face> faces_of(const GridCell::Type type) {
+            const size_t bits = face_bits(type);
+            return {FACE_TABLE.faces[bits].data(), FACE_TABLE.counts[bits]};
+        }
+    }  // namespace
+
     /// -----------------------------------------
     /// \brief Grid cell methods
     /// -----------------------------------------
     GridCell::GridCell(const vec3& coord, const vec3& size, Type type, const int3& idx)
-        : type(type), origin(coord), size(size), idx(idx), id(count++) {
+        : type(type), origin(coord), size(size), idx(idx), id(count++), faces(faces_of(type)) {
         particles.max_load_factor(0.8);
 #ifdef _OPENMP
         SPDLOG_TRACE("Lock initialized for cell {}", id);
@@ -86,8 +144,10 @@ namespace md::env {
     /// \brief ParticleGrid initilization methods
     /// -----------------------------------------
 void ParticleGrid::build(const Boundary & boundary, const double grid_const, std::vector<Particle>& particles,
-                         bool build_blocks) {
+                         bool build_blocks, const int dim) {
         this->boundary_origin = boundary.origin;
+        this->dimension = dim;
+        shells.clear();
         build_cells(boundary.extent, grid_const, particles);
 
         if (build_blocks) { // Build blocks as well, which are necessary for spatial decomposition parallelization
@@ -106,36 +166,30 @@ void ParticleGrid::build(const Boundary & boundary, const double grid_const, std
         cell_size = {extent[0] / num_x, extent[1] / num_y, extent[2] / num_z};
         size_t num_cells = num_x * num_y * num_z;
 
-        // create cells
-        for (size_t x = 0; x < num_x; x++) {
-            for (size_t y = 0; y < num_y; y++) {
-                for (size_t z = 0; z < num_z; z++) {
-                    auto type = GridCell::INNER;
-
-                    if (x==0) type |= GridCell::BOUNDARY_LEFT;
-                    if (y==0) type |= GridCell::BOUNDARY_BOTTOM;
-                    if (z==0) type |= GridCell::BOUNDARY_BACK;
-                    if (x==num_x-1) type |= GridCell::BOUNDARY_RIGHT;
-                    if (y==num_y-1) type |= GridCell::BOUNDARY_TOP;
-                    if (z==num_z-1) type |= GridCell::BOUNDARY_FRONT;
-
-                    int3 idx = {static_cast<INT_T>(x),static_cast<INT_T>(y),static_cast<INT_T>(z)};
-
-                    GridCell cell = {{cell_size[0] * static_cast<double>(x),
-                                      cell_size[1] * static_cast<double>(y),
-                                      cell_size[2] * static_cast<double>(z)},
-                                     cell_size,
-                                     type,
-                                     idx};
-                    cell.particles.reserve(4*particles.size()/num_cells);
-                    cells.emplace(idx, cell);
-
-
-                    if (type == GridCell::BOUNDARY) border_cells.push_back(&cells.at(idx));
-
-                    SPDLOG_TRACE("Grid Cell created. index: {} Cell: {}", idx, cell.to_string());
-                }
-            }
+        // create cells, their ids follow the cell order
+        for (const int3& idx : ordered_indices()) {
+            const auto x = static_cast<UINT_T>(idx[0]);
+            const auto y = static_cast<UINT_T>(idx[1]);
+            const auto z = static_cast<UINT_T>(idx[2]);
+            auto type = GridCell::INNER;
+
+            if (x==0) type |= GridCell::BOUNDARY_LEFT;
+            if (y==0) type |= GridCell::BOUNDARY_BOTTOM;
+            if (z==0) type |= GridCell::BOUNDARY_BACK;
+            if (x==num_x-1) type |= GridCell::BOUNDARY_RIGHT;
+            if (y==num_y-1) type |= GridCell::BOUNDARY_TOP;
+            if (z==num_z-1) type |= GridCell::BOUNDARY_FRONT;
+
+            GridCell cell = {{cell_size[0] * static_cast<double>(x),
+                              cell_size[1] * static_cast<double>(y),
+                              cell_size[2] * static_cast<double>(z)},
+                             cell_size,
+                             type,
+                             idx};
+            cell.particles.reserve(4*particles.size()/num_cells);
+            cells.emplace(idx, cell);
+
+            SPDLOG_TRACE("Grid Cell created. index: {} Cell: {}", idx, cell.to_string());
         }
 
         // create a cell representing the "outside"
@@ -143,12 +197,30 @@ void ParticleGrid::build(const Boundary & boundary, const double grid_const, std
         cells.emplace(OUTSIDE_CELL, outside);
         SPDLOG_TRACE("Grid Cell created. index: {} Cell: {}", OUTSIDE_CELL, outside.to_string());
 
-        // fill cells with particles
+        // the map stores the cells contiguously, so the pointers are only taken once all cells are inserted
+        border_cells.clear();
+        for (auto& list : face_cells) list.clear();
+        for (auto& [idx, cell] : cells) {
+            if (!(cell.type & GridCell::BOUNDARY)) continue;
+            border_cells.push_back(&cell);
+            for (const auto face : cell.faces) face_cells[face].push_back(&cell);
+        }
+
+        // fill cells and index lists with particles
+        for (auto& list : state_lists) list.clear();
+        boundary_particles.clear();
+        outside_particles.clear();
+        size_t max_id = 0;
+        for (const auto& p : particles) max_id = std::max(max_id, p.id);
+        regions.assign(particles.empty() ? 0 : max_id + 1, GridCell::OUTSIDE);
         for (auto& p : particles) {
+            state_lists[state_index(p.state)].insert(p.id);
             if (p.state == Particle::DEAD) continue;
             int3 idx = what_cell(p.position);
-            cells.at(idx).particles.emplace(&p);
+            auto& cell = cells.at(idx);
+            cell.particles.emplace(&p);
             p.cell = idx;
+            set_region(p.id, cell.type);
             SPDLOG_TRACE("Particle of type {} at position {} added to Cell {}", p.type, p.position, idx);
         }
     }
@@ -167,11 +239,59 @@ void ParticleGrid::build(const Boundary & boundary, const double grid_const, std
     }
 
 
+    void ParticleGrid::set_cell_order(const CellOrder cell_order) {
+        order = cell_order;
+    }
+
+    std::vector<int3> ParticleGrid::ordered_indices() const {
+        std::vector<int3> indices;
+        indices.reserve(static_cast<size_t>(cell_count[0]) * cell_count[1] * cell_count[2]);
+        for (UINT_T x = 0; x < cell_count[0]; x++) {
+            for (UINT_T y = 0; y < cell_count[1]; y++) {
+                for (UINT_T z = 0; z < cell_count[2]; z++) {
+                    indices.push_back({static_cast<INT_T>(x), static_cast<INT_T>(y), static_cast<INT_T>(z)});
+                }
+            }
+        }
+        if (order == CellOrder::LINEAR) return indices;
+
+        // the curves are defined on a cube with a power of two side length, the missing cells are skipped
+        const UINT_T max_count = std::max({cell_count[0], cell_count[1], cell_count[2]});
+        const int bits = std::max(1, static_cast<int>(std::bit_width(max_count - 1)));
+        const int dims = cell_count[2] == 1 ? 2 : 3;
+        auto key = [&](const int3& idx) {
+            const std::array<uint32_t, 3> u = {static_cast<uint32_t>(idx[0]), static_cast<uint32_t>(idx[1]),
+                                               static_cast<uint32_t>(idx[2])};
+            return order == CellOrder::MORTON ? utils::morton_key(u) : utils::hilbert_key(u, dims, bits);
+        };
+
+        std::vector<std::pair<uint64_t, int3>> keyed;
+        keyed.reserve(indices.size());
+        for (const auto& idx : indices) keyed.emplace_back(key(idx), idx);
+        std::ranges::sort(keyed, {}, &std::pair<uint64_t, int3>::first);
+        for (size_t i = 0; i < keyed.size(); i++) indices[i] = keyed[i].second;
+        return indices;
+    }
+
+    void ParticleGrid::sort_pairs(std::vector<CellPair>& pairs) {
+        std::vector<size_t> permutation(pairs.size());
+        std::iota(permutation.begin(), permutation.end(), 0);
+        std::ranges::stable_sort(permutation, {}, [&pairs](const size_t i) { return pairs[i].cell1.id; });
+
+        // the pairs hold references and cannot be assigned, hence they are copied in the new order
+        std::vector<CellPair> sorted;
+        sorted.reserve(pairs.size());
+        for (const size_t i : permutation) sorted.push_back(pairs[i]);
+        pairs.swap(sorted);
+    }
+
     std::vector<int3> ParticleGrid::compute_displacements() {
         std::vector<int3> displacements;
+        // 2D particles never leave their plane, so the z neighbors (and their periodic images) are not linked
+        const INT_T max_dz = dimension == 2 ? 0 : 1;
         for (INT_T dx = -1; dx <= 1; dx++) {
             for (INT_T dy = -1; dy <= 1; dy++) {
-                for (INT_T dz = -1; dz <= 1; dz++) {
+                for (INT_T dz = -max_dz; dz <= max_dz; dz++) {
                     if (dx == 0 && dy == 0 && dz == 0) continue;
                     displacements.push_back({dx, dy, dz});
                 }
@@ -218,6 +338,8 @@ void ParticleGrid::build(const Boundary & boundary, const double grid_const, std
                 }
             }
         }
+
+        if (order != CellOrder::LINEAR) sort_pairs(cell_pairs);
     }
 
     /// -----------------------------------------
@@ -396,6 +518,11 @@ void ParticleGrid::build(const Boundary & boundary, const double grid_const, std
                 }
             }
         }
+
+        if (order == CellOrder::LINEAR) return;
+        for (auto& set : blocks) {
+            for (auto& block : set) sort_pairs(block.cell_pairs);
+        }
     }
 
     /// -----------------------------------------
@@ -444,37 +571,187 @@ void ParticleGrid::build(const Boundary & boundary, const double grid_const, std
         return cell_pairs;
     }
 
+    const std::vector<std::vector<CellPair>>& ParticleGrid::cell_shells() {
+        if (!shells.empty() || cell_pairs.empty()) return shells;
+
+        // slot of each cell in the order of its first appearance in the linked cells
+        ankerl::unordered_dense::map<int, size_t> slots;
+        auto shell = [&](const GridCell& cell) -> std::vector<CellPair>& {
+            const auto [it, inserted] = slots.try_emplace(cell.id, shells.size());
+            if (inserted) shells.emplace_back();
+            return shells[it->second];
+        };
+
+        for (const auto& pair : cell_pairs) {
+            shell(pair.cell1).emplace_back(pair.cell1, pair.cell2, pair.periodicity);
+            if (pair.cell1.id != pair.cell2.id) {
+                shell(pair.cell2).emplace_back(pair.cell2, pair.cell1, pair.periodicity);
+            }
+        }
+        return shells;
+    }
+
     const std::vector<std::vector<Block>>& ParticleGrid::block_sets() {
         return blocks;
     }
 
+    void ParticleGrid::memory_usage(utils::MemoryUsage& usage) const {
+        size_t particle_sets = 0;
+        for (const auto& [idx, cell] : cells) {
+            particle_sets += utils::dense_hash_bytes(cell.particles);
+        }
+        size_t block_pairs = 0;
+        for (const auto& set : blocks) {
+            block_pairs += utils::vector_bytes(set);
+            for (const auto& block : set) block_pairs += utils::vector_bytes(block.cell_pairs);
+        }
+
+        size_t index_lists = boundary_particles.bytes() + outside_particles.bytes() + utils::vector_bytes(regions);
+        for (const auto& list : state_lists) index_lists += list.bytes();
+
+        size_t border = utils::vector_bytes(border_cells);
+        for (const auto& list : face_cells) border += utils::vector_bytes(list);
+
+        usage.add("grid cells", utils::dense_hash_bytes(cells) + border);
+        usage.add("cell particle sets", particle_sets);
+        size_t shell_pairs = utils::vector_bytes(shells);
+        for (const auto& shell : shells) shell_pairs += utils::vector_bytes(shell);
+
+        usage.add("cell pairs", utils::vector_bytes(cell_pairs) + shell_pairs);
+        usage.add("block cell pairs", block_pairs);
+        usage.add("particle index lists", index_lists);
+    }
+
     const std::vector<GridCell*> & ParticleGrid::boundary_cells() {
         return border_cells;
     }
 
+    const std::vector<GridCell*> & ParticleGrid::boundary_cells(const Boundary::Face face) const {
+        return face_cells[face];
+    }
+
     size_t ParticleGrid::particle_count() const {
-        size_t count = 0;
-        for (const auto& cell : cells | std::views::values) {
-            count += cell.particles.size();
+        return state_list(Particle::ALIVE).size() + state_list(Particle::STATIONARY).size();
+    }
+
+    void ParticleGrid::add_particle(Particle& particle) {
+        state_lists[state_index(particle.state)].insert(particle.id);
+        if (regions.size() <= particle.id) regions.resize(particle.id + 1, GridCell::INNER);
+        if (cells.empty()) return;  // sorted into the cells by build_cells
+
+        if (particle.state == Particle::DEAD) {
+            regions[particle.id] = GridCell::OUTSIDE;
+            return;
+        }
+        particle.cell = what_cell(particle.position);
+        auto& cell = cells.at(particle.cell);
+        cell.particles.insert(&particle);
+        set_region(particle.id, cell.type);
+    }
+
+    bool ParticleGrid::occupied(const vec3& position, const double distance) const {
+        const vec3 pos = position_in_grid(position);
+        int3 low{};
+        int3 high{};
+        for (int i = 0; i < 3; i++) {
+            const auto last = static_cast<INT_T>(cell_count[i]) - 1;
+            low[i] = std::clamp(static_cast<INT_T>(std::floor((pos[i] - distance) / cell_size[i])), 0, last);
+            high[i] = std::clamp(static_cast<INT_T>(std::floor((pos[i] + distance) / cell_size[i])), 0, last);
+        }
+
+        const double distance_sq = distance * distance;
+        for (INT_T x = low[0]; x <= high[0]; x++) {
+            for (INT_T y = low[1]; y <= high[1]; y++) {
+                for (INT_T z = low[2]; z <= high[2]; z++) {
+                    for (const Particle* particle : cells.at({x, y, z}).particles) {
+                        if (ArrayUtils::L2NormSquared(particle->position - position) < distance_sq) return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    void ParticleGrid::relink(std::vector<Particle>& particles) {
+        for (auto& [idx, cell] : cells) cell.particles.clear();
+        for (auto& list : state_lists) list.clear();
+        for (auto& p : particles) {
+            state_lists[state_index(p.state)].insert(p.id);
+            if (p.state != Particle::DEAD) cells.at(p.cell).particles.insert(&p);
+        }
+    }
+
+    void ParticleGrid::update_state(Particle* particle, const Particle::State state) {
+        const Particle::State old_state = particle->state;
+        if (old_state == state) return;
+
+        state_lists[state_index(old_state)].erase(particle->id);
+        state_lists[state_index(state)].insert(particle->id);
+        particle->state = state;
+        if (cells.empty()) return;  // not built yet
+
+        if (state == Particle::DEAD) {
+            cells.at(particle->cell).particles.erase(particle);
+            regions[particle->id] = GridCell::OUTSIDE;
+            boundary_particles.erase(particle->id);
+            outside_particles.erase(particle->id);
+        } else if (old_state == Particle::DEAD) {
+            particle->cell = what_cell(particle->position);
+            auto& cell = cells.at(particle->cell);
+            cell.particles.insert(particle);
+            set_region(particle->id, cell.type);
+        }
+    }
+
+    const utils::IndexList& ParticleGrid::state_list(const Particle::State state) const {
+        return state_lists[state_index(state)];
+    }
+
+    ParticleSources ParticleGrid::particle_sources(const GridCell::Type type, const Particle::State state) const {
+        ParticleSources sources;
+        // particles near or beyond the boundary are few, their lists are much shorter than the state lists
+        if (!cells.empty() && !(type & GridCell::INNER) && !(state & Particle::DEAD)) {
+            if (type & GridCell::BOUNDARY) sources.lists[sources.count++] = boundary_particles.indices();
+            if (type & GridCell::OUTSIDE) sources.lists[sources.count++] = outside_particles.indices();
+            return sources;
+        }
+        for (const auto s : {Particle::ALIVE, Particle::DEAD, Particle::STATIONARY}) {
+            if (state & s) sources.lists[sources.count++] = state_list(s).indices();
+        }
+        return sources;
+    }
+
+    void ParticleGrid::set_region(const size_t id, const GridCell::Type type) {
+        regions[id] = type;
+        if (type & GridCell::BOUNDARY) {
+            boundary_particles.insert(id);
+        } else {
+            boundary_particles.erase(id);
+        }
+        if (type == GridCell::OUTSIDE) {
+            outside_particles.insert(id);
+        } else {
+            outside_particles.erase(id);
         }
-        return count;
     }
 
     void ParticleGrid::update_cells(Particle* particle, const int3& old_cell, const int3& new_cell) {
+        // dead particles are in no cell
+        if (particle->state == Particle::DEAD) {
+            cells.at(old_cell).particles.erase(particle);
+            return;
+        }
+
         if (old_cell != new_cell) {
             auto& old = cells.at(old_cell);
             auto& current = cells.at(new_cell);
 
             old.particles.erase(particle);
             current.particles.insert(particle);
+            if (current.type != old.type) set_region(particle->id, current.type);
 
             SPDLOG_TRACE("Particle at {} changed cells from {} to {}", particle->position, old_cell, new_cell);
         }
-
-        if (particle->state == Particle::DEAD) {
-            auto& cell = cells.at(old_cell);
-            cell.particles.erase(particle);
-        }
     }
 
     vec3 ParticleGrid::position_in_grid(const vec3& abs_position) const {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <span>
 #include <string>
 #include <vector>
 #include <omp.h>
@@ -9,6 +11,7 @@
 #include "env/Particle.h"
 #include "env/Boundary.h"
 #include "utils/ContainerUtils.h"
+#include "utils/MemoryUtils.h"
 
 /**
  * @file ParticleGrid.cpp
@@ -86,6 +89,7 @@ namespace md::env {
         const vec3 size;   ///< The size of the grid cell.
         const int3 idx;    ///< The index of the grid cell
         int id;            ///< The id of the grid cell.
+        const std::span<const Boundary::Face> faces;  ///< The boundary faces of the cell, looked up by type.
 
         particle_container particles{}; ///< The set of particles inside the grid cell.
     private:
@@ -237,8 +241,32 @@ namespace md::env {
     };
 
 
+    /**
+     * @brief Index lists of particles selected for an iteration, see ParticleGrid::particle_sources.
+     */
+    struct ParticleSources {
+        std::array<std::span<const size_t>, 3> lists{};  ///< The selected lists.
+        size_t count = 0;                                ///< Number of selected lists.
+
+        [[nodiscard]] auto begin() const { return lists.begin(); }
+        [[nodiscard]] auto end() const { return lists.begin() + static_cast<std::ptrdiff_t>(count); }
+    };
+
+    /**
+     * @brief Order in which the cells are stored and the cell pairs are traversed.
+     */
+    enum class CellOrder {
+        LINEAR,   ///< Row-major order of the cell indices (x, then y, then z).
+        MORTON,   ///< Order along the Morton (Z-order) curve.
+        HILBERT,  ///< Order along the Hilbert curve.
+    };
+
     /**
      * @brief A class representing the particle grid.
+     *
+     * Besides the cells, the grid keeps the ids of the particles of each state and of the particles in boundary and
+     * outside cells in index lists, which are updated when a particle changes its state or its cell. This makes
+     * counting particles O(1) and lets loops over a subset of the particles visit only that subset.
      */
     class ParticleGrid {
        public:
@@ -249,8 +277,27 @@ namespace md::env {
          * @param boundary
          * @param grid_const The constant used to define grid cell size.
          * @param particles The particles that fill the cells.
+         * @param build_blocks Whether the blocks of the spatial decomposition are built instead of the linked cells.
+         * @param dim The dimension of the particles. In 2D, the cells are only linked within their xy-plane, with the
+         * 5 point half stencil instead of the 14 point one.
+         */
+        void build(const Boundary & boundary, double grid_const, std::vector<Particle>& particles, bool build_blocks = false,
+                   int dim = 3);
+
+        /**
+         * @brief Sets the order of the cells, must be called before the build. Along a space filling curve, the cells
+         * are created in curve order, so their ids and their storage follow the curve, and the cell pairs of the grid
+         * and of every block are traversed cell by cell in that order. Cell order compaction of the particle storage
+         * follows the same order.
+         * @param cell_order The order.
+         */
+        void set_cell_order(CellOrder cell_order);
+
+        /**
+         * @brief Returns the order of the cells.
+         * @return The order.
          */
-        void build(const Boundary & boundary, double grid_const, std::vector<Particle>& particles, bool build_blocks = false);
+        [[nodiscard]] CellOrder cell_order() const { return order; }
 
         /**
          * @brief Retrieves the grid cell corresponding the index.
@@ -299,6 +346,14 @@ namespace md::env {
          */
         const std::vector<CellPair> & linked_cells();
 
+        /**
+         * @brief Returns the full neighbor shell of each cell, built from the linked cells on the first call. A shell
+         * holds the self pair of its cell and every other pair the cell is part of, oriented such that the cell is
+         * cell1. Used to evaluate the pair forces without Newton's third law.
+         * @return A vector with the shell of each cell, in the order of the linked cells.
+         */
+        const std::vector<std::vector<CellPair>> & cell_shells();
+
         /**
          * @brief returns the block sets.
          *
@@ -312,6 +367,12 @@ namespace md::env {
          */
         const std::vector<std::vector<Block>> & block_sets();
 
+        /**
+         * @brief Adds the bytes allocated by the cells, their particle sets, the cell pairs and the blocks.
+         * @param usage The memory usage to add to.
+         */
+        void memory_usage(utils::MemoryUsage& usage) const;
+
         /**
          * @brief returns all cells at the boundary
          * @return A vector with GridCell pointers
@@ -319,11 +380,81 @@ namespace md::env {
         const std::vector<GridCell*> & boundary_cells();
 
         /**
-         * @brief Number of particles.
+         * @brief returns the cells at one face of the boundary
+         * @param face The face.
+         * @return A vector with GridCell pointers
+         */
+        [[nodiscard]] const std::vector<GridCell*> & boundary_cells(Boundary::Face face) const;
+
+        /**
+         * @brief Returns the ids of the alive or stationary particles outside the domain.
+         * @return The index list of the outside particles.
+         */
+        [[nodiscard]] const utils::IndexList& outside_list() const { return outside_particles; }
+
+        /**
+         * @brief Number of particles in the cells, i.e. of alive and stationary particles.
          * @return The number of particles.
          */
         size_t particle_count() const;
 
+        /**
+         * @brief Registers a particle added to the environment. Once the grid is built, the particle is also inserted
+         * into the cell of its position.
+         * @param particle The particle.
+         */
+        void add_particle(Particle& particle);
+
+        /**
+         * @brief Checks whether a particle lies within a distance of a position. Only the cells overlapping the
+         * sphere around the position are searched, periodic images are not considered.
+         * @param position The position, must be inside the domain.
+         * @param distance The distance.
+         * @return "true" if an alive or stationary particle is closer than the distance, "false" otherwise.
+         */
+        [[nodiscard]] bool occupied(const vec3& position, double distance) const;
+
+        /**
+         * @brief Registers the particles again after the storage was repacked: the cells are refilled with the new
+         * addresses and the state lists with the stored particles, ids of particles that are no longer stored are
+         * dropped. The cell of every particle must be up to date.
+         * @param particles The repacked particle storage.
+         */
+        void relink(std::vector<Particle>& particles);
+
+        /**
+         * @brief Changes the state of a particle. A particle that dies is removed from its cell, a particle that is
+         * revived is inserted into the cell of its position.
+         * @param particle Pointer to the particle.
+         * @param state The new state.
+         */
+        void update_state(Particle* particle, Particle::State state);
+
+        /**
+         * @brief Returns the ids of the particles of a state.
+         * @param state A single state.
+         * @return The index list of the state.
+         */
+        [[nodiscard]] const utils::IndexList& state_list(Particle::State state) const;
+
+        /**
+         * @brief Returns the type of the cell of a particle, OUTSIDE for dead particles and INNER before the grid is
+         * built.
+         * @param id The id of the particle.
+         * @return The cell type.
+         */
+        [[nodiscard]] GridCell::Type region(const size_t id) const { return regions[id]; }
+
+        /**
+         * @brief Selects the shortest index lists containing all particles of the given cell types and states: the
+         * boundary and outside lists if no inner or dead particles are requested, the state lists otherwise. The lists
+         * may contain other particles as well and must not be modified while they are iterated.
+         * @param type The cell types.
+         * @param state The states.
+         * @return The selected lists.
+         */
+        [[nodiscard]] ParticleSources particle_sources(GridCell::Type type, Particle::State state) const;
+
         /**
          * @brief Updates the relevant grid cells when a particle moves from one cell to another.
          * @param particle Pointer to the particle which moves.
@@ -343,7 +474,7 @@ namespace md::env {
 
     private:
         /**
-         * @brief Computes the displacements of cells in the environment.
+         * @brief Computes the displacements of the neighbor cells, without the ones along z in 2D.
          * @return A vector of displacements.
          */
         std::vector<int3> compute_displacements();
@@ -393,14 +524,42 @@ namespace md::env {
          */
         void build_cell_pairs_and_blocks(const std::array<BoundaryRule, 6> & rules);
 
+        /**
+         * @brief Returns the indices of the cells inside the domain in the order of the cell order.
+         * @return The cell indices.
+         */
+        [[nodiscard]] std::vector<int3> ordered_indices() const;
+
+        /**
+         * @brief Sorts cell pairs by their first cell along the cell order, pairs of the same cell keep their order.
+         * @param pairs The cell pairs.
+         */
+        static void sort_pairs(std::vector<CellPair>& pairs);
+
+        /**
+         * @brief Sets the cell type of a particle and updates the boundary and outside lists accordingly.
+         * @param id The id of the particle.
+         * @param type The type of the cell of the particle.
+         */
+        void set_region(size_t id, GridCell::Type type);
+
         ankerl::unordered_dense::map<int3, GridCell, Int3Hasher> cells{};  ///< A hash map storing the cells in the grid.
         std::vector<CellPair> cell_pairs{};                  ///< A vector of linked cell pairs.
+        std::vector<std::vector<CellPair>> shells{};         ///< The full neighbor shell of each cell, built lazily.
         std::vector<GridCell*> border_cells;                 ///< A vector of cells at the domain boundary
+        std::array<std::vector<GridCell*>, 6> face_cells;    ///< The boundary cells of each face.
         // [0]: normal blocks, [1]: communication_blocks_x, [2]: communication_blocks_y, [3]: communication_blocks_z
         std::vector<std::vector<Block>> blocks;
 
+        std::array<utils::IndexList, 3> state_lists;  ///< Particle ids per state (ALIVE, DEAD, STATIONARY).
+        utils::IndexList boundary_particles;          ///< Ids of the particles in boundary cells.
+        utils::IndexList outside_particles;           ///< Ids of the alive or stationary particles outside the domain.
+        std::vector<GridCell::Type> regions;          ///< Cell type of each particle, indexed by id.
+
         uint3 cell_count{};         ///< The number of cells in the grid along each dimension.
         vec3 cell_size{};           ///< The size of each grid cell.
         vec3 boundary_origin = {};  ///< The origin of the boundary.
+        CellOrder order = CellOrder::LINEAR;  ///< Order of the cells and the cell pair traversal.
+        int dimension = 3;          ///< The dimension of the particles.
     };
 }  // namespace md::env
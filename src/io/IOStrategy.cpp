@@ -3,13 +3,15 @@
 #include "IOStrategy.h"
 #include "io/input/txt/TXTFileReader.h"
 #include "io/input/xml/XMLFileReader.h"
+#include "io/input/xml/XMLStreamReader.h"
+#include "io/Output/TrajectoryWriter.h"
 #include "io/Output/VTKWriter.h"
 #include "io/Output/XYZWriter.h"
 #include "io/Logger/Logger.h"
 
 namespace md::io {
-    OutputWriterBase::OutputWriterBase(std::string file_name, const bool allow_delete)
-        : file_name(std::move(file_name)) {
+    OutputWriterBase::OutputWriterBase(std::string file_name, const bool allow_delete, OutputFilter filter)
+        : file_name(std::move(file_name)), filter(std::move(filter)) {
         if (!std::filesystem::exists(OUTPUT_DIR)) {
             std::filesystem::create_directories(OUTPUT_DIR);
         }
@@ -36,22 +38,40 @@ namespace md::io {
         return false;
     }
 
-    std::unique_ptr<OutputWriterBase> create_writer(const std::string& outputFileBaseName,const OutputFormat output_format, bool allow_delete) {
+    std::unique_ptr<OutputWriterBase> create_writer(const std::string& outputFileBaseName,const OutputFormat output_format, bool allow_delete,
+                                                    const OutputFilter& filter) {
         if (output_format == OutputFormat::VTK) {
-            return std::make_unique<VTKWriter>(VTKWriter(outputFileBaseName + "_vtk", allow_delete));
+            return std::make_unique<VTKWriter>(VTKWriter(outputFileBaseName + "_vtk", allow_delete, filter));
         }
-        return std::make_unique<XYZWriter>(XYZWriter(outputFileBaseName + "_xyz", allow_delete));
+        if (output_format == OutputFormat::XYZ_MULTI) {
+            return std::make_unique<XYZWriter>(outputFileBaseName + "_xyz", allow_delete, filter, true);
+        }
+        if (output_format == OutputFormat::TRJ) {
+            return std::make_unique<TrajectoryWriter>(outputFileBaseName + "_trj", allow_delete, filter);
+        }
+        return std::make_unique<XYZWriter>(outputFileBaseName + "_xyz", allow_delete, filter);
     }
 
     std::unique_ptr<CheckpointWriter> create_checkpoint_writer() {
         return std::make_unique<CheckpointWriter>(CheckpointWriter());
     }
 
+    void build_environment(ProgramArguments& args) {
+        if (args.strategy_override >= 0) {
+            args.parallel_strategy = args.strategy_override;
+        }
+        args.env.set_boundary(args.boundary);
+        args.env.set_cell_order(args.cell_order);
+        args.env.replicate(args.replicas);
+        args.env.build(args.parallel_strategy == 2);
+    }
+
     void read_file(const std::string& filename, ProgramArguments& args) {
         if (checkFormat(filename, ".txt")) {
             return read_file_txt(filename, args);
         }
         else if (checkFormat(filename, ".xml")) {
+            if (args.stream_input) return read_file_xml_stream(filename, args, args.validate_input);
             return read_file_xml(filename, args);
         }
 
@@ -2,14 +2,19 @@
 
 #include <filesystem>
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "env/Environment.h"
 #include "effects/Thermostat.h"
 #include "effects/ConstantForce.h"
+#include "effects/InflowSource.h"
+#include "core/PerformanceSuite.h"
+#include "core/ScalingSweep.h"
 #include "core/Statistics.h"
 #include "io/Logger/Logger.h"
 #include "io/Output/CheckpointWriter.h"
+#include "io/Output/OutputFilter.h"
 
 #define OUTPUT_DIR "output"
 
@@ -18,7 +23,7 @@
  */
 namespace md::io {
 
-    enum class OutputFormat { VTK, XYZ };
+    enum class OutputFormat { VTK, XYZ, XYZ_MULTI, TRJ };
 
     /**
      * @brief Struct used to manage arguments read from the input file.
@@ -29,18 +34,51 @@ namespace md::io {
         env::Thermostat thermostat;
         OutputFormat output_format;
         std::string output_baseName;
+        OutputFilter output_filter;     ///< Selects the particles and fields written by the output writer.
         bool benchmark;
         bool override;
+        bool stream_input = false;      ///< Read xml input in streaming (SAX) mode.
+        bool validate_input = false;    ///< Validate xml input against the schema.
+        unsigned int benchmark_warmup = 0;  ///< Number of steps excluded from the benchmark measurement.
+        std::string benchmark_report;   ///< Base path of the benchmark report files, none are written if empty.
+        bool benchmark_counters = false;    ///< Read hardware performance counters during the benchmark.
+        unsigned int load_report_freq = 0;  ///< Steps between two load imbalance reports, not monitored if 0.
+        std::string live_metrics;       ///< Shared memory segment of the live metrics, not published if empty.
+        unsigned int compact_freq = 0;  ///< Steps between two compactions of the particle storage, never if 0.
+        bool compact_cell_order = false;    ///< Repack the particle storage in the order of the grid cells.
+        env::CellOrder cell_order = env::CellOrder::LINEAR;  ///< Order of the grid cells, set before the build.
+        env::PairMethod pair_method = env::PairMethod::AUTO;  ///< How the pair forces are computed.
+        std::string input_file;         ///< Path of the input file.
+        std::optional<core::ScalingOptions> scaling;  ///< Set if a scaling sweep was requested instead of a run.
+        std::optional<core::SuiteOptions> suite;      ///< Set if the performance suite was requested instead of a run.
         double duration;
         double dt;
         double cutoff_radius;
         int write_freq;
         int parallel_strategy;
+        int strategy_override = -1;     ///< Replaces the parallel strategy of the input file if non-negative.
+        unsigned int respa_substeps = 1;    ///< Fast force substeps per step (r-RESPA), plain Störmer-Verlet if 1.
+        unsigned int replicas = 1;      ///< Number of copies of the scenario along the x-axis.
         unsigned int temp_adj_freq = std::numeric_limits<unsigned int>::max();
         std::vector<env::ConstantForce> external_forces;
+        std::vector<env::InflowSource> inflow_sources;  ///< Sources inserting particles during the run.
         std::unique_ptr<core::Statistics> stats = nullptr;
     };
 
+    /**
+     * @brief Returns the command line name of an output format.
+     * @param format The output format.
+     * @return The name of the format.
+     */
+    inline const char* output_format_name(const OutputFormat format) {
+        switch (format) {
+            case OutputFormat::XYZ: return "XYZ";
+            case OutputFormat::XYZ_MULTI: return "XYZ_MULTI";
+            case OutputFormat::TRJ: return "TRJ";
+            default: return "VTK";
+        }
+    }
+
     /**
      * @brief Logs general simulation info read from the input file.
      * @param args
@@ -59,8 +97,11 @@ namespace md::io {
                 "       parallelization:     {}",
                 args.duration, args.dt, args.write_freq, args.env.size(env::Particle::ALIVE | env::Particle::STATIONARY),
                 args.benchmark ? "true" : "false", args.override ? "true" : "false",
-                args.output_format == OutputFormat::XYZ ? "XYZ" : "VTK", args.output_baseName,
-                args.parallel_strategy == 1 ? "cell lock" : (args.parallel_strategy == 2 ? "spatial decomposition" : "none"));
+                output_format_name(args.output_format), args.output_baseName,
+                args.parallel_strategy == 1   ? "cell lock"
+                : args.parallel_strategy == 2 ? "spatial decomposition"
+                : args.parallel_strategy == 3 ? "newton3 off"
+                                              : "none");
     }
 
     /**
@@ -73,8 +114,9 @@ namespace md::io {
          * @brief Constructs an OutputWriter with a specified file name.
          * @param file_name The name of the output file.
          * @param allow_delete if output folder contains files, allow for deletion
+         * @param filter Selects the particles and fields that are written.
          */
-        explicit OutputWriterBase(std::string file_name, bool allow_delete);
+        explicit OutputWriterBase(std::string file_name, bool allow_delete, OutputFilter filter = {});
         virtual ~OutputWriterBase() = default;
 
         /**
@@ -86,6 +128,7 @@ namespace md::io {
 
        protected:
         const std::string file_name;
+        OutputFilter filter;
     };
 
     /**
@@ -99,11 +142,13 @@ namespace md::io {
     /**
      * @brief Create an output writer.
      * @param outputFileBaseName
-     * @param output_format A boolean flag indicating whether to use the VTK output format or XYZ.
+     * @param output_format The output format (VTK, XYZ or compressed trajectory).
      * @param allow_delete
+     * @param filter Selects the particles and fields that are written.
      * @return A pointer to an OutputWriter object.
      */
-    std::unique_ptr<OutputWriterBase> create_writer(const std::string& outputFileBaseName, OutputFormat output_format, bool allow_delete);
+    std::unique_ptr<OutputWriterBase> create_writer(const std::string& outputFileBaseName, OutputFormat output_format,
+                                                    bool allow_delete, const OutputFilter& filter = {});
 
     /**
      * @brief Create an checkpoint output writer.
@@ -111,6 +156,13 @@ namespace md::io {
      */
     std::unique_ptr<CheckpointWriter> create_checkpoint_writer();
 
+    /**
+     * @brief Builds the environment once the input file has been read. The strategy override and the replication of
+     * the scenario are applied beforehand, blocks for the spatial decomposition are only built if needed.
+     * @param args The ProgramArguments.
+     */
+    void build_environment(ProgramArguments& args);
+
     /**
      * @brief Reads an input file depending on its format.
      * @param filename The name of the file.
@@ -2,12 +2,10 @@
 #include "io/Logger/Logger.h"
 
 namespace md::io{
-CSVWriter::CSVWriter(int bins) : bins{bins} {
-   
-    file = std::ofstream{"statistics.csv"};
-    if (!file.is_open()) {
-       SPDLOG_ERROR("Failure while opening statistics.csv");
-        file.close();
+CSVWriter::CSVWriter(int bins, const std::string& file_name) : file(1 << 16), bins{bins} {
+
+    if (!file.open(file_name)) {
+       SPDLOG_ERROR("Failure while opening {}", file_name);
         exit(1);
     }
 
@@ -16,12 +14,13 @@ CSVWriter::CSVWriter(int bins) : bins{bins} {
     for(int i = 1; i <= bins; i++) {
         file << i;
         if(i<bins) {
-            file << ",";
+            file << ',';
         }
         else {
-            file << "\n";
+            file << '\n';
         }
     }
+    file.flush();
 }
 
 CSVWriter::~CSVWriter() {
@@ -29,27 +28,28 @@ CSVWriter::~CSVWriter() {
 }
 
 void CSVWriter::writeData(std::vector<double> &vel,std::vector<double> &dens, double time) {
-    file << time << ",";
-    file << "\n";
-    file <<"v" <<",";
+    file << time << ',';
+    file << '\n';
+    file << "v,";
     for(int i = 0; i < bins; i++) {
         file << vel[i];
         if(i < bins - 1) {
-            file << ",";
+            file << ',';
         }
         else {
-            file << "\n";
+            file << '\n';
         }
     }
-        file <<"d" <<",";
-         for(int i = 0; i < bins; i++) {
+    file << "d,";
+    for(int i = 0; i < bins; i++) {
         file << dens[i];
         if(i < bins - 1) {
-            file << ",";
+            file << ',';
         }
         else {
-            file << "\n";
+            file << '\n';
         }
     }
+    file.flush();
+}
 }
-}
\ No newline at end of file
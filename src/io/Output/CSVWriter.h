@@ -1,28 +1,34 @@
 #include <fstream>
+#include <string>
 #include <vector>
 
+#include "io/Output/OutputBuffer.h"
+
 namespace md::io{
 
 class CSVWriter {
 private:
-     std::ofstream file;
+     OutputBuffer file;
      int bins;
 
 public:
      /**
       * @brief  Creates a csv file and enables writing in it.
+      *
+      * @param bins Number of bins per row.
+      * @param file_name Path of the csv file (default: statistics.csv).
       */
-      CSVWriter(int bins);
+      explicit CSVWriter(int bins, const std::string& file_name = "statistics.csv");
      /**
       * @brief The file is closed after object is destructed.
       */
      ~CSVWriter();
      /**
-      * @brief Writes data for a current time in simulation.
+      * @brief Writes data for a current time in simulation. Each call results in a single write to the file.
       *
       * @param data Data of particles.
       * @param time The time for which the data is specified.
       */
      void writeData(std::vector<double>& vel,std::vector<double>& dens, double time);
 };
-};
\ No newline at end of file
+};
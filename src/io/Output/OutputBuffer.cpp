@@ -0,0 +1,86 @@
+#include "OutputBuffer.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "io/Logger/Logger.h"
+
+namespace md::io {
+    OutputBuffer::OutputBuffer(const size_t capacity) : capacity(std::max<size_t>(capacity, 64)) {}
+
+    OutputBuffer::~OutputBuffer() {
+        close();
+        // release the memory explicitly, this keeps destruction after a manual destructor call harmless
+        std::vector<char>().swap(buffer);
+    }
+
+    bool OutputBuffer::open(const std::string& file_name, const bool append) {
+        close();
+        fd = ::open(file_name.c_str(), O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC), 0644);
+        if (fd < 0) return false;
+        if (buffer.size() < capacity) buffer.resize(capacity);
+        return true;
+    }
+
+    void OutputBuffer::close() {
+        flush();
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+    }
+
+    void OutputBuffer::flush() {
+        const char* data = buffer.data();
+        size_t remaining = size;
+        while (fd >= 0 && remaining > 0) {
+            const ssize_t written = ::write(fd, data, remaining);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                SPDLOG_ERROR("Failed writing output: {}", std::strerror(errno));
+                break;
+            }
+            data += written;
+            remaining -= static_cast<size_t>(written);
+        }
+        size = 0;
+    }
+
+    void OutputBuffer::reserve(const size_t bytes) {
+        if (size + bytes <= buffer.size()) return;
+        flush();
+        if (bytes > buffer.size()) buffer.resize(std::max(bytes, capacity));
+    }
+
+    OutputBuffer& OutputBuffer::operator<<(const std::string_view str) {
+        reserve(str.size());
+        std::memcpy(buffer.data() + size, str.data(), str.size());
+        size += str.size();
+        return *this;
+    }
+
+    OutputBuffer& OutputBuffer::operator<<(const char c) {
+        reserve(1);
+        buffer[size++] = c;
+        return *this;
+    }
+
+    OutputBuffer& OutputBuffer::operator<<(const double value) {
+        // besides the digits: sign, decimal point and exponent or leading zeros
+        size_t bytes = std::max(32, precision + 10);
+        while (true) {
+            reserve(bytes);
+            char* const begin = buffer.data() + size;
+            char* const end = buffer.data() + buffer.size();
+            const auto [ptr, ec] = precision < 0 ? std::to_chars(begin, end, value)
+                                                 : std::to_chars(begin, end, value, std::chars_format::general, precision);
+            if (ec == std::errc()) {
+                size = static_cast<size_t>(ptr - buffer.data());
+                return *this;
+            }
+            bytes *= 2;
+        }
+    }
+}  // namespace md::io
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <charconv>
+#include <concepts>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define OUTPUT_BUFFER_CAPACITY (1 << 20)
+
+namespace md::io {
+
+    /**
+     * @brief Formatting layer for text output writers.
+     *
+     * Text is collected in a large, reusable buffer and numbers are formatted with std::to_chars, avoiding the locale
+     * and flag handling of iostreams. The buffer is only handed to the operating system when it is full or when
+     * flush() is called, so that a whole frame typically ends up in a single write system call.
+     */
+    class OutputBuffer {
+       public:
+        /**
+         * @brief Constructs an OutputBuffer that is not associated with a file yet.
+         * @param capacity Size of the buffer in bytes (default: OUTPUT_BUFFER_CAPACITY).
+         */
+        explicit OutputBuffer(size_t capacity = OUTPUT_BUFFER_CAPACITY);
+        ~OutputBuffer();
+
+        OutputBuffer(const OutputBuffer&) = delete;
+        OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+        /**
+         * @brief Opens a file for writing, flushing and closing a previously opened one.
+         * @param file_name The name of the file.
+         * @param append Append to the file instead of truncating it.
+         * @return "true" if the file could be opened, "false" otherwise.
+         */
+        bool open(const std::string& file_name, bool append = false);
+
+        /**
+         * @brief Writes the buffered data and closes the file. The buffer is kept for the next file.
+         */
+        void close();
+
+        /**
+         * @brief Writes the buffered data to the file.
+         */
+        void flush();
+
+        /**
+         * @brief Checks if a file is associated with the buffer.
+         * @return "true" if a file is open, "false" otherwise.
+         */
+        [[nodiscard]] bool is_open() const { return fd >= 0; }
+
+        /**
+         * @brief Sets the number of significant digits of floating point numbers (like std::ostream::precision).
+         * @param digits The number of significant digits, a negative value selects the shortest exact representation.
+         */
+        void set_precision(const int digits) { precision = digits; }
+
+        OutputBuffer& operator<<(std::string_view str);
+        OutputBuffer& operator<<(char c);
+        OutputBuffer& operator<<(double value);
+
+        template <std::integral T>
+        OutputBuffer& operator<<(const T value) {
+            reserve(24);
+            const auto [ptr, ec] = std::to_chars(buffer.data() + size, buffer.data() + buffer.size(), value);
+            size = static_cast<size_t>(ptr - buffer.data());
+            return *this;
+        }
+
+       private:
+        /**
+         * @brief Makes sure that at least the given number of bytes can be appended, flushing if necessary.
+         * @param bytes The number of bytes.
+         */
+        void reserve(size_t bytes);
+
+        std::vector<char> buffer;   ///< Formatted data not yet written.
+        size_t size = 0;            ///< Number of used bytes of the buffer.
+        size_t capacity;            ///< Size of the buffer once it is allocated.
+        int fd = -1;                ///< File descriptor of the open file.
+        int precision = 6;          ///< Significant digits of floating point numbers.
+    };
+}  // namespace md::io
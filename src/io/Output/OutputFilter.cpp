@@ -0,0 +1,48 @@
+#include "OutputFilter.h"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace md::io {
+    OutputFilter::Field OutputFilter::parse_fields(const std::string& field_names) {
+        std::istringstream stream(field_names);
+        std::string name;
+        Field result{};
+        while (stream >> name) {
+            if (name == "position") result |= POSITION;
+            else if (name == "velocity") result |= VELOCITY;
+            else if (name == "force") result |= FORCE;
+            else if (name == "mass") result |= MASS;
+            else if (name == "type") result |= TYPE;
+            else throw std::invalid_argument("Unknown output field: " + name);
+        }
+        if (result == Field{}) throw std::invalid_argument("Output field list is empty");
+        return result;
+    }
+
+    std::vector<const env::Particle*> OutputFilter::select(const env::Environment& environment) const {
+        std::vector<const env::Particle*> selected;
+        const bool unfiltered = regions.empty() && types.empty() && stride <= 1;
+        if (unfiltered) selected.reserve(environment.size(env::Particle::ALIVE | env::Particle::STATIONARY));
+
+        for (auto& particle : environment.particles(env::GridCell::INSIDE | env::GridCell::OUTSIDE,
+                                                    env::Particle::ALIVE | env::Particle::STATIONARY)) {
+            if (!types.empty() && std::ranges::find(types, particle.type) == types.end()) continue;
+            if (!regions.empty() &&
+                std::ranges::none_of(regions, [&](const env::ParticleMarker& region) { return region(particle); })) {
+                continue;
+            }
+            selected.push_back(&particle);
+        }
+
+        // the state lists are unordered, the stride and the writers rely on the order of the ids
+        std::ranges::sort(selected, {}, [](const env::Particle* particle) { return particle->id; });
+        if (stride > 1) {
+            size_t kept = 0;
+            for (size_t i = 0; i < selected.size(); i += stride) selected[kept++] = selected[i];
+            selected.resize(kept);
+        }
+        return selected;
+    }
+}  // namespace md::io
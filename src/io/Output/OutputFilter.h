@@ -0,0 +1,68 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "effects/ConstantForce.h"
+#include "env/Environment.h"
+
+namespace md::io {
+
+    /**
+     * @brief Selects which particles and which of their fields are written by an output writer.
+     *
+     * A particle is written if it lies within any of the regions (or no region is given) and has one of the types (or
+     * no type is given). Of the remaining particles only every stride-th is written. The filter is applied before any
+     * formatting takes place, hence the output volume and the time spent writing shrink accordingly.
+     */
+    struct OutputFilter {
+        /**
+         * @brief Enumeration of the particle fields that can be written.
+         */
+        enum Field {
+            POSITION = 0x01,
+            VELOCITY = 0x02,
+            FORCE = 0x04,
+            MASS = 0x08,
+            TYPE = 0x10,
+            ALL = POSITION | VELOCITY | FORCE | MASS | TYPE,
+        };
+
+        /**
+         * @brief Parses a whitespace separated list of field names (position, velocity, force, mass, type).
+         * @param field_names The list of field names.
+         * @return The combined fields.
+         *
+         * @throws std::invalid_argument if a field name is unknown or the list is empty.
+         */
+        static Field parse_fields(const std::string& field_names);
+
+        /**
+         * @brief Collects all alive and stationary particles that pass the filter, in ascending order of their id.
+         * @param environment The environment of the particles.
+         * @return Pointers to the selected particles.
+         */
+        [[nodiscard]] std::vector<const env::Particle*> select(const env::Environment& environment) const;
+
+        /**
+         * @brief Checks whether a field should be written.
+         * @param field The field to check.
+         * @return "true" if the field is selected, "false" otherwise.
+         */
+        [[nodiscard]] bool writes(Field field) const { return (fields & field) != 0; }
+
+        std::vector<env::ParticleMarker> regions;   ///< Regions of interest, e.g. created with env::MarkBox.
+        std::vector<int> types;                     ///< Particle types to write.
+        unsigned int stride = 1;                    ///< Only every stride-th selected particle is written.
+        Field fields = ALL;                         ///< Fields to write.
+    };
+
+    constexpr OutputFilter::Field operator|(const OutputFilter::Field lhs, const OutputFilter::Field rhs) {
+        return static_cast<OutputFilter::Field>(static_cast<int>(lhs) | static_cast<int>(rhs));
+    }
+
+    constexpr OutputFilter::Field& operator|=(OutputFilter::Field& lhs, const OutputFilter::Field rhs) {
+        lhs = lhs | rhs;
+        return lhs;
+    }
+}  // namespace md::io
@@ -0,0 +1,440 @@
+#include "TrajectoryWriter.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "io/Logger/Logger.h"
+
+#define TRAJECTORY_MAGIC "MDTRJ002"
+#define TRAJECTORY_INDEX_MAGIC "MDTRJIDX"
+#define MAGIC_SIZE 8
+// quotients of the Rice code that are at least this large are escaped and stored verbatim
+#define RICE_ESCAPE 24
+
+namespace md::io {
+    /// -----------------------------------------
+    /// \brief Bit level coding
+    /// -----------------------------------------
+    /**
+     * @brief Appends bits (LSB first) to a byte vector.
+     */
+    class BitWriter {
+       public:
+        explicit BitWriter(std::vector<uint8_t>& out) : out(out) {}
+
+        void write(uint64_t value, const unsigned bits) {
+            if (bits > 32) {
+                write(value & 0xFFFFFFFF, 32);
+                write(value >> 32, bits - 32);
+                return;
+            }
+            if (bits < 64) value &= (uint64_t{1} << bits) - 1;
+            acc |= value << n_bits;
+            n_bits += bits;
+            while (n_bits >= 8) {
+                out.push_back(static_cast<uint8_t>(acc));
+                acc >>= 8;
+                n_bits -= 8;
+            }
+        }
+
+        void flush() {
+            if (n_bits > 0) out.push_back(static_cast<uint8_t>(acc));
+            acc = 0;
+            n_bits = 0;
+        }
+
+       private:
+        std::vector<uint8_t>& out;
+        uint64_t acc = 0;
+        unsigned n_bits = 0;
+    };
+
+    /**
+     * @brief Reads bits (LSB first) from a byte range.
+     */
+    class BitReader {
+       public:
+        BitReader(const uint8_t* begin, const uint8_t* end) : it(begin), end(end) {}
+
+        uint64_t read(const unsigned bits) {
+            if (bits > 32) {
+                const uint64_t low = read(32);
+                return low | read(bits - 32) << 32;
+            }
+            while (n_bits < bits) {
+                if (it == end) throw std::runtime_error("Trajectory frame is truncated");
+                acc |= static_cast<uint64_t>(*it++) << n_bits;
+                n_bits += 8;
+            }
+            const uint64_t value = acc & ((uint64_t{1} << bits) - 1);
+            acc >>= bits;
+            n_bits -= bits;
+            return value;
+        }
+
+       private:
+        const uint8_t* it;
+        const uint8_t* end;
+        uint64_t acc = 0;
+        unsigned n_bits = 0;
+    };
+
+    /**
+     * @brief Adaptive Rice code (LOCO-I style): the parameter follows the running mean of the coded values.
+     */
+    struct AdaptiveRice {
+        [[nodiscard]] unsigned k() const {
+            unsigned k = 0;
+            while ((static_cast<uint64_t>(count) << k) < sum && k < 56) ++k;
+            return k;
+        }
+
+        void update(const uint64_t value) {
+            sum += value;
+            if (++count == 64) {
+                sum >>= 1;
+                count >>= 1;
+            }
+        }
+
+        void encode(BitWriter& writer, const uint64_t value) {
+            const unsigned param = k();
+            const uint64_t quotient = value >> param;
+            if (quotient < RICE_ESCAPE) {
+                writer.write((uint64_t{1} << quotient) - 1, static_cast<unsigned>(quotient) + 1);
+                writer.write(value, param);
+            } else {
+                const auto length = static_cast<unsigned>(std::bit_width(value));
+                writer.write((uint64_t{1} << RICE_ESCAPE) - 1, RICE_ESCAPE);
+                writer.write(length, 7);
+                writer.write(value, length);
+            }
+            update(value);
+        }
+
+        uint64_t decode(BitReader& reader) {
+            const unsigned param = k();
+            uint64_t quotient = 0;
+            while (quotient < RICE_ESCAPE && reader.read(1) == 1) ++quotient;
+            uint64_t value;
+            if (quotient < RICE_ESCAPE) {
+                value = quotient << param | reader.read(param);
+            } else {
+                value = reader.read(static_cast<unsigned>(reader.read(7)));
+            }
+            update(value);
+            return value;
+        }
+
+        uint64_t sum = 16;
+        uint32_t count = 1;
+    };
+
+    uint64_t zigzag(const int64_t value) { return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63); }
+    int64_t unzigzag(const uint64_t value) { return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1); }
+
+    // spreads the lower 21 bits of x so that there are two zero bits between each of them
+    uint64_t spread_bits(uint64_t x) {
+        x &= 0x1FFFFF;
+        x = (x | x << 32) & 0x1F00000000FFFF;
+        x = (x | x << 16) & 0x1F0000FF0000FF;
+        x = (x | x << 8) & 0x100F00F00F00F00F;
+        x = (x | x << 4) & 0x10C30C30C30C30C3;
+        x = (x | x << 2) & 0x1249249249249249;
+        return x;
+    }
+
+    template <typename T>
+    void write_raw(std::ostream& out, const T& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    T read_raw(const char*& it, const char* end) {
+        if (end - it < static_cast<std::ptrdiff_t>(sizeof(T))) throw std::runtime_error("Trajectory file is truncated");
+        T value;
+        std::memcpy(&value, it, sizeof(T));
+        it += sizeof(T);
+        return value;
+    }
+
+    /// -----------------------------------------
+    /// \brief TrajectoryWriter
+    /// -----------------------------------------
+    TrajectoryWriter::TrajectoryWriter(std::string file_base_name, const bool allow_delete, OutputFilter filter,
+                                       const double precision, const unsigned keyframe_interval)
+        : OutputWriterBase(std::move(file_base_name), allow_delete, std::move(filter)),
+          precision(precision),
+          keyframe_interval(std::max(1u, keyframe_interval)) {}
+
+    TrajectoryWriter::~TrajectoryWriter() = default;
+
+    void TrajectoryWriter::open() {
+        const std::string path = std::string(OUTPUT_DIR) + "/" + file_name;
+        data.open(path + TRAJECTORY_EXTENSION, std::ios::binary);
+        index.open(path + TRAJECTORY_INDEX_EXTENSION, std::ios::binary);
+        if (!data.is_open() || !index.is_open()) {
+            SPDLOG_ERROR("Failed opening trajectory file {}", path + TRAJECTORY_EXTENSION);
+            exit(-1);
+        }
+
+        data.write(TRAJECTORY_MAGIC, MAGIC_SIZE);
+        write_raw(data, precision);
+        write_raw(data, static_cast<uint32_t>(keyframe_interval));
+        index.write(TRAJECTORY_INDEX_MAGIC, MAGIC_SIZE);
+    }
+
+    void TrajectoryWriter::fit_grid(const std::vector<const env::Particle*>& particles) {
+        vec3 low{};
+        vec3 high{};
+        if (!particles.empty()) {
+            low = high = particles.front()->position;
+            for (const auto* p : particles) {
+                for (int d = 0; d < 3; ++d) {
+                    low[d] = std::min(low[d], p->position[d]);
+                    high[d] = std::max(high[d], p->position[d]);
+                }
+            }
+        }
+
+        // the margin leaves room for the particles to move until the next keyframe
+        constexpr double max_quanta = std::numeric_limits<uint32_t>::max() - 2.0 * TRAJECTORY_MARGIN - 1.0;
+        uint64_t max_extent = 0;
+        for (int d = 0; d < 3; ++d) {
+            const double extent = high[d] - low[d];
+            if (!std::isfinite(extent)) {
+                SPDLOG_ERROR("Unable to write the trajectory, particle positions are not finite");
+                exit(-1);
+            }
+            quantum[d] = std::max(precision, extent / max_quanta);
+            if (quantum[d] > precision) {
+                SPDLOG_WARN("Particles spread over {} along axis {}, quantizing the trajectory with {} instead of {}",
+                            extent, d, quantum[d], precision);
+            }
+            origin[d] = low[d] - TRAJECTORY_MARGIN * quantum[d];
+            max_extent = std::max(max_extent, static_cast<uint64_t>(std::ceil(extent / quantum[d])) + 2 * TRAJECTORY_MARGIN);
+        }
+        const auto bits = static_cast<uint32_t>(std::bit_width(max_extent));
+        morton_shift = bits > 21 ? bits - 21 : 0;
+    }
+
+    bool TrajectoryWriter::quantize(const vec3& position, std::array<uint32_t, 3>& q) const {
+        for (int d = 0; d < 3; ++d) {
+            const double scaled = std::round((position[d] - origin[d]) / quantum[d]);
+            // also false for NaN
+            if (!(scaled >= 0 && scaled <= static_cast<double>(UINT32_MAX))) return false;
+            q[d] = static_cast<uint32_t>(scaled);
+        }
+        return true;
+    }
+
+    void TrajectoryWriter::plot_particles(const env::Environment& environment, const int iteration) {
+        if (!data.is_open()) open();
+
+        // a delta frame is only possible if the particles are exactly the ones of the previous frame
+        const auto particles = filter.select(environment);
+        bool is_keyframe = frame_count == 0 || frame_count - keyframe >= keyframe_interval ||
+                           particles.size() != keyframe_ids.size();
+        for (size_t i = 0; !is_keyframe && i < particles.size(); ++i) {
+            is_keyframe = particles[i]->id != keyframe_ids[i];
+        }
+
+        // and if they are all still on the grid of the keyframe
+        std::vector<std::array<uint32_t, 3>> current;
+        if (!is_keyframe) {
+            current.resize(order.size());
+            for (size_t i = 0; !is_keyframe && i < order.size(); ++i) {
+                is_keyframe = !quantize(environment[order[i]].position, current[i]);
+            }
+        }
+
+        std::vector<uint8_t> payload;
+        payload.reserve(particles.size() * 4);
+        BitWriter writer(payload);
+        std::array<AdaptiveRice, 3> coder{};
+
+        if (is_keyframe) {
+            fit_grid(particles);
+            struct Entry {
+                uint64_t morton;
+                size_t id;
+                std::array<uint32_t, 3> q;
+            };
+            std::vector<Entry> entries;
+            entries.reserve(particles.size());
+            keyframe_ids.resize(particles.size());
+            for (size_t i = 0; i < particles.size(); ++i) {
+                const env::Particle& p = *particles[i];
+                keyframe_ids[i] = p.id;
+                std::array<uint32_t, 3> q{};
+                if (!quantize(p.position, q)) {
+                    SPDLOG_ERROR("Unable to quantize the position of particle {} for the trajectory", p.id);
+                    exit(-1);
+                }
+                const uint64_t morton = spread_bits(q[0] >> morton_shift) | spread_bits(q[1] >> morton_shift) << 1 |
+                                        spread_bits(q[2] >> morton_shift) << 2;
+                entries.push_back({morton, p.id, q});
+            }
+            std::ranges::sort(entries, {}, &Entry::morton);
+
+            order.resize(entries.size());
+            previous.resize(entries.size());
+            AdaptiveRice id_coder;
+            int64_t last_id = 0;
+            std::array<int64_t, 3> last_q{};
+            for (size_t i = 0; i < entries.size(); ++i) {
+                order[i] = entries[i].id;
+                previous[i] = entries[i].q;
+                id_coder.encode(writer, zigzag(static_cast<int64_t>(entries[i].id) - last_id));
+                last_id = static_cast<int64_t>(entries[i].id);
+                for (int d = 0; d < 3; ++d) {
+                    coder[d].encode(writer, zigzag(entries[i].q[d] - last_q[d]));
+                    last_q[d] = entries[i].q[d];
+                }
+            }
+            keyframe = frame_count;
+        } else {
+            for (size_t i = 0; i < order.size(); ++i) {
+                for (int d = 0; d < 3; ++d) {
+                    coder[d].encode(writer, zigzag(static_cast<int64_t>(current[i][d]) - previous[i][d]));
+                }
+                previous[i] = current[i];
+            }
+        }
+        writer.flush();
+
+        const auto offset = static_cast<uint64_t>(data.tellp());
+        write_raw(data, static_cast<int32_t>(iteration));
+        write_raw(data, static_cast<uint32_t>(order.size()));
+        write_raw(data, static_cast<uint8_t>(is_keyframe));
+        write_raw(data, static_cast<uint32_t>(payload.size()));
+        if (is_keyframe) {
+            write_raw(data, origin);
+            write_raw(data, quantum);
+        }
+        data.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+        data.flush();
+
+        write_raw(index, offset);
+        write_raw(index, static_cast<int32_t>(iteration));
+        write_raw(index, keyframe);
+        index.flush();
+
+        SPDLOG_DEBUG("Trajectory frame {} ({}): {} particles, {:.2f} bytes per particle", frame_count,
+                     is_keyframe ? "keyframe" : "delta", order.size(),
+                     order.empty() ? 0.0 : static_cast<double>(payload.size()) / static_cast<double>(order.size()));
+        frame_count++;
+    }
+
+    /// -----------------------------------------
+    /// \brief TrajectoryReader
+    /// -----------------------------------------
+    TrajectoryReader::TrajectoryReader(const std::string& file_name) : data(file_name) {
+        const std::string index_name =
+            file_name.ends_with(TRAJECTORY_EXTENSION)
+                ? file_name.substr(0, file_name.size() - std::strlen(TRAJECTORY_EXTENSION)) + TRAJECTORY_INDEX_EXTENSION
+                : file_name + ".idx";
+        const utils::MappedFile index_file(index_name);
+        if (!data.is_open() || !index_file.is_open()) {
+            throw std::runtime_error("Unable to open trajectory " + file_name);
+        }
+
+        const char* it = data.view().data();
+        const char* end = it + data.size();
+        if (data.size() < MAGIC_SIZE || std::memcmp(it, TRAJECTORY_MAGIC, MAGIC_SIZE) != 0) {
+            throw std::runtime_error("Not a trajectory file: " + file_name);
+        }
+        it += MAGIC_SIZE;
+        quantum = read_raw<double>(it, end);
+
+        const char* idx = index_file.view().data();
+        const char* idx_end = idx + index_file.size();
+        if (index_file.size() < MAGIC_SIZE || std::memcmp(idx, TRAJECTORY_INDEX_MAGIC, MAGIC_SIZE) != 0) {
+            throw std::runtime_error("Not a trajectory index: " + index_name);
+        }
+        idx += MAGIC_SIZE;
+        constexpr size_t entry_size = sizeof(uint64_t) + sizeof(int32_t) + sizeof(uint32_t);
+        while (static_cast<size_t>(idx_end - idx) >= entry_size) {
+            IndexEntry entry{};
+            entry.offset = read_raw<uint64_t>(idx, idx_end);
+            entry.iteration = read_raw<int32_t>(idx, idx_end);
+            entry.keyframe = read_raw<uint32_t>(idx, idx_end);
+            // ignore frames that were indexed but not completely written (e.g. after a crash)
+            if (entry.offset >= data.size()) break;
+            index.push_back(entry);
+        }
+    }
+
+    size_t TrajectoryReader::frame_count() const { return index.size(); }
+
+    int TrajectoryReader::iteration(const size_t frame) const { return index.at(frame).iteration; }
+
+    bool TrajectoryReader::is_keyframe(const size_t frame) const { return index.at(frame).keyframe == frame; }
+
+    double TrajectoryReader::precision() const { return quantum; }
+
+    TrajectoryFrame TrajectoryReader::read_frame(const size_t frame) const {
+        const IndexEntry& target = index.at(frame);
+        const char* const begin = data.view().data();
+        const char* const end = begin + data.size();
+
+        std::vector<size_t> ids;
+        std::vector<std::array<uint32_t, 3>> q;
+        vec3 origin{};
+        vec3 step{};
+
+        for (size_t f = target.keyframe; f <= frame; ++f) {
+            const char* it = begin + index[f].offset;
+            read_raw<int32_t>(it, end);
+            const auto n = read_raw<uint32_t>(it, end);
+            const bool is_keyframe = read_raw<uint8_t>(it, end) != 0;
+            const auto size = read_raw<uint32_t>(it, end);
+            if (is_keyframe) {
+                origin = read_raw<vec3>(it, end);
+                step = read_raw<vec3>(it, end);
+            }
+            if (end - it < static_cast<std::ptrdiff_t>(size)) throw std::runtime_error("Trajectory file is truncated");
+
+            BitReader reader(reinterpret_cast<const uint8_t*>(it), reinterpret_cast<const uint8_t*>(it + size));
+            std::array<AdaptiveRice, 3> coder{};
+            if (is_keyframe) {
+                ids.resize(n);
+                q.resize(n);
+                AdaptiveRice id_coder;
+                int64_t last_id = 0;
+                std::array<int64_t, 3> last_q{};
+                for (size_t i = 0; i < n; ++i) {
+                    last_id += unzigzag(id_coder.decode(reader));
+                    ids[i] = static_cast<size_t>(last_id);
+                    for (int d = 0; d < 3; ++d) {
+                        last_q[d] += unzigzag(coder[d].decode(reader));
+                        q[i][d] = static_cast<uint32_t>(last_q[d]);
+                    }
+                }
+            } else {
+                if (n != q.size()) throw std::runtime_error("Corrupt trajectory: delta frame does not match keyframe");
+                for (size_t i = 0; i < n; ++i) {
+                    for (int d = 0; d < 3; ++d) {
+                        q[i][d] = static_cast<uint32_t>(q[i][d] + unzigzag(coder[d].decode(reader)));
+                    }
+                }
+            }
+        }
+
+        TrajectoryFrame result;
+        result.iteration = target.iteration;
+        result.ids = std::move(ids);
+        result.positions.resize(q.size());
+        for (size_t i = 0; i < q.size(); ++i) {
+            for (int d = 0; d < 3; ++d) {
+                result.positions[i][d] = origin[d] + q[i][d] * step[d];
+            }
+        }
+        return result;
+    }
+}  // namespace md::io
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "io/IOStrategy.h"
+#include "utils/MappedFile.h"
+
+#define TRAJECTORY_EXTENSION ".mdtrj"
+#define TRAJECTORY_INDEX_EXTENSION ".mdtrj.idx"
+#define TRAJECTORY_MARGIN (1u << 20)  ///< Quanta the grid of a keyframe extends beyond the particles on each side.
+
+namespace md::io {
+
+    /**
+     * @brief A single frame of a compressed trajectory.
+     */
+    struct TrajectoryFrame {
+        int iteration = 0;              ///< Iteration the frame was written at.
+        std::vector<size_t> ids;        ///< IDs of the particles in the frame.
+        std::vector<vec3> positions;    ///< Positions of the particles, positions[i] belongs to ids[i].
+    };
+
+    /**
+     * @brief Writes particle positions into a single compressed trajectory file (XTC-like).
+     *
+     * Positions are quantized per axis relative to the bounding box of the particles at each keyframe, widened by
+     * TRAJECTORY_MARGIN quanta on each side. The box and the quantization steps are stored in the keyframe, a step is
+     * only coarser than the precision if the particles spread too far for 32 bit coordinates. Keyframes store the
+     * particles in Morton order of their quantized positions, each coordinate delta-coded against the previous
+     * particle. The following frames keep that particle order and delta-code every coordinate against the previous
+     * frame. All deltas are entropy-coded with an adaptive Rice code.
+     *
+     * A new keyframe is written every keyframe_interval frames, whenever the set of written particles changes and
+     * whenever a particle leaves the quantization grid of the last keyframe. An index file (TRAJECTORY_INDEX_EXTENSION)
+     * stores the offset and keyframe of every frame, so that a TrajectoryReader can seek to any frame by decoding at
+     * most keyframe_interval frames.
+     */
+    class TrajectoryWriter final : public OutputWriterBase {
+       public:
+        /**
+         * @brief Constructs a TrajectoryWriter.
+         * @param file_base_name The base name of the trajectory file.
+         * @param allow_delete If output folder contains files, allow for deletion.
+         * @param filter Selects the particles that are written (only positions are stored).
+         * @param precision Quantization step of the positions (default: 1e-3).
+         * @param keyframe_interval Maximum number of frames between two keyframes (default: 10).
+         */
+        explicit TrajectoryWriter(std::string file_base_name, bool allow_delete, OutputFilter filter = {},
+                                  double precision = 1e-3, unsigned keyframe_interval = 10);
+        ~TrajectoryWriter() override;
+
+        void plot_particles(const env::Environment& environment, int iteration) override;
+
+       private:
+        /**
+         * @brief Opens the trajectory and index file and writes their headers.
+         */
+        void open();
+
+        /**
+         * @brief Places the quantization grid of a keyframe around the particles.
+         * @param particles The particles of the keyframe.
+         */
+        void fit_grid(const std::vector<const env::Particle*>& particles);
+
+        /**
+         * @brief Quantizes a position on the grid of the last keyframe.
+         * @param position The position.
+         * @param q The quantized position.
+         * @return "false" if the position is outside the grid, "true" otherwise.
+         */
+        bool quantize(const vec3& position, std::array<uint32_t, 3>& q) const;
+
+        std::ofstream data;                                 ///< Trajectory file.
+        std::ofstream index;                                ///< Index file.
+        double precision;                                   ///< Requested quantization step.
+        unsigned keyframe_interval;                         ///< Maximum distance between two keyframes.
+        vec3 origin{};                                      ///< Origin of the quantization grid of the last keyframe.
+        vec3 quantum{};                                     ///< Quantization step of each axis of the last keyframe.
+        uint32_t morton_shift = 0;                          ///< Bits dropped before computing Morton codes.
+        uint32_t frame_count = 0;                           ///< Number of frames written so far.
+        uint32_t keyframe = 0;                              ///< Frame number of the last keyframe.
+        std::vector<size_t> keyframe_ids;                   ///< Ascending particle IDs of the last keyframe.
+        std::vector<size_t> order;                          ///< Particle IDs in the order of the last keyframe.
+        std::vector<std::array<uint32_t, 3>> previous;      ///< Quantized positions of the previous frame.
+    };
+
+    /**
+     * @brief Reads trajectories written by the TrajectoryWriter with random access to each frame.
+     */
+    class TrajectoryReader {
+       public:
+        /**
+         * @brief Opens a trajectory file and its index.
+         * @param file_name The path of the trajectory file (the index is expected next to it).
+         */
+        explicit TrajectoryReader(const std::string& file_name);
+
+        /**
+         * @brief Returns the number of frames in the trajectory.
+         * @return The number of frames.
+         */
+        [[nodiscard]] size_t frame_count() const;
+        /**
+         * @brief Returns the iteration a frame was written at, without decoding it.
+         * @param frame The frame number.
+         * @return The iteration.
+         */
+        [[nodiscard]] int iteration(size_t frame) const;
+        /**
+         * @brief Checks if a frame is a keyframe, without decoding it.
+         * @param frame The frame number.
+         * @return "true" if the frame is a keyframe, "false" if it is delta-coded.
+         */
+        [[nodiscard]] bool is_keyframe(size_t frame) const;
+        /**
+         * @brief Decodes a frame. Only the frames since the preceding keyframe are decoded.
+         * @param frame The frame number.
+         * @return The decoded frame.
+         */
+        [[nodiscard]] TrajectoryFrame read_frame(size_t frame) const;
+        /**
+         * @brief Returns the requested quantization step of the stored positions. Keyframes whose particles spread too
+         * far for 32 bit coordinates use a coarser step.
+         * @return The precision.
+         */
+        [[nodiscard]] double precision() const;
+
+       private:
+        struct IndexEntry {
+            uint64_t offset;     ///< Byte offset of the frame in the trajectory file.
+            int32_t iteration;   ///< Iteration the frame was written at.
+            uint32_t keyframe;   ///< Frame number of the keyframe the frame depends on.
+        };
+
+        utils::MappedFile data;             ///< Mapped trajectory file.
+        std::vector<IndexEntry> index;      ///< Index of all frames.
+        double quantum = 0;                 ///< Requested quantization step.
+    };
+}  // namespace md::io
@@ -19,13 +19,14 @@
 namespace md::io {
     using namespace env;
 
-    VTKWriter::VTKWriter(std::string file_base_name, const bool allow_delete)
-        : OutputWriterBase(std::move(file_base_name), allow_delete) {}
+    VTKWriter::VTKWriter(std::string file_base_name, const bool allow_delete, OutputFilter filter)
+        : OutputWriterBase(std::move(file_base_name), allow_delete, std::move(filter)) {}
 
     void VTKWriter::plot_particles(const Environment& environment, const int iteration) {
-        initializeOutput(static_cast<int>(environment.size(Particle::ALIVE|Particle::STATIONARY)));
-        for (auto& particle : environment.particles(GridCell::INSIDE|GridCell::OUTSIDE, Particle::ALIVE|Particle::STATIONARY)) {
-            plotParticle(particle);
+        const auto particles = filter.select(environment);
+        initializeOutput(static_cast<int>(particles.size()));
+        for (const auto* particle : particles) {
+            plotParticle(*particle);
         }
         writeFile(iteration);
     }
@@ -35,16 +36,20 @@ namespace md::io {
     void VTKWriter::initializeOutput(int numParticles) {
         vtkFile = new VTKFile_t("UnstructuredGrid");
 
-        // per point, we add type, position, velocity and force
+        // per point, we add the selected fields of type, velocity, force and mass
         PointData pointData;
-        DataArray_t mass(type::Float32, "mass", 1);
-        DataArray_t velocity(type::Float32, "velocity", 3);
-        DataArray_t forces(type::Float32, "force", 3);
-        DataArray_t type(type::Int32, "type", 1);
-        pointData.DataArray().push_back(mass);
-        pointData.DataArray().push_back(velocity);
-        pointData.DataArray().push_back(forces);
-        pointData.DataArray().push_back(type);
+        if (filter.writes(OutputFilter::MASS)) {
+            pointData.DataArray().push_back(DataArray_t(type::Float32, "mass", 1));
+        }
+        if (filter.writes(OutputFilter::VELOCITY)) {
+            pointData.DataArray().push_back(DataArray_t(type::Float32, "velocity", 3));
+        }
+        if (filter.writes(OutputFilter::FORCE)) {
+            pointData.DataArray().push_back(DataArray_t(type::Float32, "force", 3));
+        }
+        if (filter.writes(OutputFilter::TYPE)) {
+            pointData.DataArray().push_back(DataArray_t(type::Int32, "type", 1));
+        }
 
         CellData cellData;  // we don't have cell data => leave it empty
 
@@ -86,23 +91,28 @@ namespace md::io {
         PointData::DataArray_sequence& pointDataSequence = vtkFile->UnstructuredGrid()->Piece().PointData().DataArray();
         PointData::DataArray_iterator dataIterator = pointDataSequence.begin();
 
-        dataIterator->push_back(p.mass);
-        // cout << "Appended mass data in: " << dataIterator->Name();
+        if (filter.writes(OutputFilter::MASS)) {
+            dataIterator->push_back(p.mass);
+            ++dataIterator;
+        }
 
-        ++dataIterator;
-        dataIterator->push_back(p.velocity[0]);
-        dataIterator->push_back(p.velocity[1]);
-        dataIterator->push_back(p.velocity[2]);
-        // cout << "Appended velocity data in: " << dataIterator->Name();
+        if (filter.writes(OutputFilter::VELOCITY)) {
+            dataIterator->push_back(p.velocity[0]);
+            dataIterator->push_back(p.velocity[1]);
+            dataIterator->push_back(p.velocity[2]);
+            ++dataIterator;
+        }
 
-        ++dataIterator;
-        dataIterator->push_back(p.old_force[0]);
-        dataIterator->push_back(p.old_force[1]);
-        dataIterator->push_back(p.old_force[2]);
-        // cout << "Appended force data in: " << dataIterator->Name();
+        if (filter.writes(OutputFilter::FORCE)) {
+            dataIterator->push_back(p.old_force[0]);
+            dataIterator->push_back(p.old_force[1]);
+            dataIterator->push_back(p.old_force[2]);
+            ++dataIterator;
+        }
 
-        ++dataIterator;
-        dataIterator->push_back(p.type);
+        if (filter.writes(OutputFilter::TYPE)) {
+            dataIterator->push_back(p.type);
+        }
 
         Points::DataArray_sequence& pointsSequence = vtkFile->UnstructuredGrid()->Piece().Points().DataArray();
         Points::DataArray_iterator pointsIterator = pointsSequence.begin();
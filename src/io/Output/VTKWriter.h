@@ -19,8 +19,11 @@ namespace md::io {
        public:
         /**
          * @param filename the base name of the file to be written.
+         * @param allow_delete if output folder contains files, allow for deletion
+         * @param filter Selects the particles and point data fields that are written. The positions are always
+         * written, as they define the points of the grid.
          */
-        explicit VTKWriter(std::string file_base_name, bool allow_delete);
+        explicit VTKWriter(std::string file_base_name, bool allow_delete, OutputFilter filter = {});
         ~VTKWriter() override;
 
         void plot_particles(const env::Environment& environment, int iteration) override;
@@ -33,7 +36,7 @@ namespace md::io {
         void initializeOutput(int numParticles);
 
         /**
-         * @brief plot type, mass, position, velocity and force of a particle.
+         * @brief plot the position and the selected fields (type, mass, velocity, force) of a particle.
          *
          * @note: initializeOutput() must have been called before.
          */
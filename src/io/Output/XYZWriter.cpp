@@ -7,40 +7,41 @@
 
 #include "XYZWriter.h"
 
-#include <iomanip>
-#include <sstream>
 #include <utility>
 
+#include "io/Logger/Logger.h"
+
 namespace md::io {
-    XYZWriter::XYZWriter(std::string fileName, const bool allow_delete)
-        : OutputWriterBase(std::move(fileName), allow_delete) {}
+    XYZWriter::XYZWriter(std::string fileName, const bool allow_delete, OutputFilter filter, const bool multi_frame)
+        : OutputWriterBase(std::move(fileName), allow_delete, std::move(filter)), multi_frame(multi_frame) {}
     XYZWriter::~XYZWriter() = default;
 
     void XYZWriter::plot_particles(const env::Environment& env, int iteration) {
-        std::ofstream file;
-        std::stringstream strstr;
-
-        strstr << "output" << '/';
-        strstr << file_name << "_" << std::setfill('0') << std::setw(4) << iteration << ".xyz";
-
-        file.open(strstr.str().c_str());
-        file << env.size(env::Particle::ALIVE | env::Particle::STATIONARY) << std::endl;
-        file << "Generated by MolSim. See http://openbabel.org/wiki/XYZ_(format) for "
-                "file format doku."
-             << std::endl;
+        const std::string path = multi_frame ? fmt::format("{}/{}.xyz", OUTPUT_DIR, file_name)
+                                             : fmt::format("{}/{}_{:04}.xyz", OUTPUT_DIR, file_name, iteration);
+        if (!multi_frame || !buffer.is_open()) {
+            if (!buffer.open(path)) {
+                SPDLOG_ERROR("Failed opening output file {}", path);
+                exit(-1);
+            }
+        }
 
-        for (auto& particle : env.particles()) {
-            std::array<double, 3> x = particle.position;
-            file << "Ar ";
-            file.setf(std::ios_base::showpoint);
+        // the xyz format only stores positions, hence the field selection of the filter is ignored
+        const auto particles = filter.select(env);
 
-            for (auto& xi : x) {
-                file << xi << " ";
-            }
+        buffer << particles.size() << '\n';
+        buffer << "Generated by MolSim. See http://openbabel.org/wiki/XYZ_(format) for file format doku. Iteration "
+               << iteration << '\n';
 
-            file << std::endl;
+        for (const auto* particle : particles) {
+            buffer << "Ar " << particle->position[0] << ' ' << particle->position[1] << ' ' << particle->position[2]
+                   << '\n';
         }
 
-        file.close();
+        if (multi_frame) {
+            buffer.flush();
+        } else {
+            buffer.close();
+        }
     }
 }  // namespace md::io
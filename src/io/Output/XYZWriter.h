@@ -7,16 +7,31 @@
 
 #pragma once
 
-#include <fstream>
-
 #include "io/IOStrategy.h"
+#include "io/Output/OutputBuffer.h"
 
 namespace md::io {
+    /**
+     * @brief Writes particle positions in the xyz format.
+     *
+     * Either one file is written per frame, or all frames are appended to a single multi-frame xyz file, which most
+     * viewers (e.g. VMD, OVITO) read as a trajectory. Each frame is formatted into an OutputBuffer and written at once.
+     */
     class XYZWriter : public OutputWriterBase {
        public:
-        explicit XYZWriter(std::string fileName, bool allow_delete);
+        /**
+         * @param fileName the base name of the file(s) to be written.
+         * @param allow_delete if output folder contains files, allow for deletion
+         * @param filter Selects the particles that are written.
+         * @param multi_frame Append all frames to a single file instead of writing one file per frame.
+         */
+        explicit XYZWriter(std::string fileName, bool allow_delete, OutputFilter filter = {}, bool multi_frame = false);
         ~XYZWriter() override;
 
         void plot_particles(const env::Environment& env, int iteration) override;
+
+       private:
+        OutputBuffer buffer;   ///< Buffer the frames are formatted into.
+        bool multi_frame;      ///< Indicates whether all frames go into a single file.
     };
 }  // namespace md::io
@@ -2,21 +2,31 @@
 
 #include <algorithm>
 #include <cctype>
+#include <charconv>
+#include <chrono>
 #include <cstdlib>
-#include <fstream>
 #include <locale>
 #include <sstream>
 #include <array>
 #include <ranges>
+#include <string_view>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "env/Environment.h"
 #include "env/Boundary.h"
 #include "env/Force.h"
 #include "effects/ConstantForce.h"
 #include "io/Logger/Logger.h"
+#include "utils/MappedFile.h"
 #include "utils/Parse.h"
 #include "effects/Thermostat.h"
 
+// particle sections smaller than this are not worth splitting across threads
+#define MIN_PARTICLE_CHUNK_BYTES (1 << 16)
+
 namespace md::io {
     using namespace env;
     // code from https://stackoverflow.com/questions/216823/how-to-trim-a-stdstring
@@ -35,13 +45,40 @@ namespace md::io {
         ltrim(s);
     }
 
-    std::vector<double> parse_values(const std::string& line, size_t expected_size) {
-        std::istringstream data_stream(line);
-        std::vector<double> vals;
-        double num;
-        while (data_stream >> num) {
+    std::string_view trim(std::string_view s) {
+        while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front()))) s.remove_prefix(1);
+        while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back()))) s.remove_suffix(1);
+        return s;
+    }
+
+    // splits off the next line of text, returns false once text is exhausted
+    bool next_line(std::string_view& text, std::string_view& line) {
+        if (text.empty()) return false;
+        const size_t end = text.find('\n');
+        line = text.substr(0, end);
+        text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+        return true;
+    }
+
+    // parses whitespace separated numbers into vals (up to the first token that is not a number)
+    template <typename Container>
+    void parse_numbers(std::string_view line, Container& vals) {
+        const char* it = line.data();
+        const char* const end = line.data() + line.size();
+        while (true) {
+            while (it != end && std::isspace(static_cast<unsigned char>(*it))) ++it;
+            if (it == end) return;
+            double num;
+            const auto [ptr, ec] = std::from_chars(it, end, num);
+            if (ec != std::errc() || (ptr != end && !std::isspace(static_cast<unsigned char>(*ptr)))) return;
             vals.push_back(num);
+            it = ptr;
         }
+    }
+
+    std::vector<double> parse_values(const std::string& line, size_t expected_size) {
+        std::vector<double> vals;
+        parse_numbers(line, vals);
         if (vals.size() < expected_size) {
             SPDLOG_ERROR("Not enough numbers in line: {}", line);
             exit(-1);
@@ -52,33 +89,113 @@ namespace md::io {
     /// -----------------------------------------
     /// \brief Parse particle information
     /// -----------------------------------------
-    void parse_particle(const std::string& line, Environment& env) {
-        SPDLOG_DEBUG("Reading Particle:    {}", line);
+    /**
+     * Small fixed capacity buffer for the numbers of a single particle line, avoids a heap allocation per line.
+     */
+    struct ParticleValues {
+        void push_back(double val) {
+            if (count < vals.size()) vals[count] = val;
+            count++;
+        }
+        std::array<double, 12> vals{};
+        size_t count = 0;
+    };
 
+    // parses one particle line into out, returns false if the line holds too few values
+    bool parse_particle(std::string_view line, std::vector<ParticleCreateInfo>& out) {
         // Minimum required values: 3 (origin) + 3 (velocity) + 1 (mass) + 1 (type) + 1 (state) +  optional 3 (force)
-        auto vals = parse_values(line, 9);
-
-        vec3 origin = {vals[0], vals[1], vals[2]};
-        vec3 init_v = {vals[3], vals[4], vals[5]};
-        double mass = vals[6];
-        int type = static_cast<int>(vals[7]);
-        auto state = vals[8] == 0 ? env::Particle::STATIONARY : env::Particle::ALIVE;
+        ParticleValues values;
+        parse_numbers(line, values);
+        if (values.count < 9) return false;
 
+        const auto& vals = values.vals;
+        const auto state = vals[8] == 0 ? env::Particle::STATIONARY : env::Particle::ALIVE;
         vec3 force = {0, 0, 0};
-        if (vals.size() == 12) {
+        if (values.count == 12) {
             force = {vals[9], vals[10], vals[11]};
         }
 
-        env.add_particle({origin[0], origin[1], origin[2]}, {init_v[0], init_v[1], init_v[2]}, mass, type, state, force);
+        out.emplace_back(vec3{vals[0], vals[1], vals[2]}, vec3{vals[3], vals[4], vals[5]}, vals[6],
+                         static_cast<int>(vals[7]), state, force);
+        return true;
+    }
 
-        SPDLOG_DEBUG(
-            "Parsed Particle:\n"
-            "       Origin:           [{}, {}, {}]\n"
-            "       Initial Velocity: [{}, {}, {}]\n"
-            "       Mass:             {}\n"
-            "       Type:             {}\n"
-            "       Force:            [{}, {}, {}]",
-            origin[0], origin[1], origin[2], init_v[0], init_v[1], init_v[2], mass, type, force[0], force[1], force[2]);
+    // parses all particle lines of a contiguous particle section, returns the number of lines that failed to parse
+    size_t parse_particle_chunk(std::string_view chunk, std::vector<ParticleCreateInfo>& out,
+                                std::string_view& first_error) {
+        size_t errors = 0;
+        std::string_view line;
+        while (next_line(chunk, line)) {
+            line = trim(line);
+            if (line.empty() || line[0] == '#') continue;
+            if (!parse_particle(line, out) && errors++ == 0) {
+                first_error = line;
+            }
+        }
+        return errors;
+    }
+
+    /**
+     * @brief Parses a whole particle section and bulk inserts the particles into the environment.
+     * The section is split into line aligned chunks, which are parsed in parallel.
+     * The particle order (and hence the particle IDs) is the same as in the file.
+     * @param section The text of the particle section (without the section header).
+     * @param env The environment to insert the particles into.
+     */
+    void parse_particles(std::string_view section, Environment& env) {
+        const auto start = std::chrono::high_resolution_clock::now();
+
+        size_t n_chunks = 1;
+#ifdef _OPENMP
+        n_chunks = std::clamp<size_t>(section.size() / MIN_PARTICLE_CHUNK_BYTES, 1, 4 * omp_get_max_threads());
+#endif
+
+        // split the section into chunks at line boundaries
+        std::vector<std::string_view> chunks;
+        chunks.reserve(n_chunks);
+        size_t begin = 0;
+        for (size_t i = 1; i <= n_chunks && begin < section.size(); ++i) {
+            size_t end = i == n_chunks ? section.size() : std::max(begin, i * section.size() / n_chunks);
+            end = section.find('\n', end);
+            end = end == std::string_view::npos ? section.size() : end + 1;
+            chunks.push_back(section.substr(begin, end - begin));
+            begin = end;
+        }
+
+        std::vector<std::vector<ParticleCreateInfo>> parsed(chunks.size());
+        std::vector<size_t> errors(chunks.size(), 0);
+        std::vector<std::string_view> error_lines(chunks.size());
+
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            // rough estimate of the particle count, a particle line is rarely shorter than 32 chars
+            parsed[i].reserve(chunks[i].size() / 32);
+            errors[i] = parse_particle_chunk(chunks[i], parsed[i], error_lines[i]);
+        }
+
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            if (errors[i] > 0) {
+                SPDLOG_ERROR("Not enough numbers in line: {}", error_lines[i]);
+                exit(-1);
+            }
+        }
+
+        size_t total = 0;
+        for (const auto& chunk : parsed) total += chunk.size();
+
+        std::vector<ParticleCreateInfo> particles;
+        particles.reserve(total);
+        for (auto& chunk : parsed) {
+            particles.insert(particles.end(), chunk.begin(), chunk.end());
+            std::vector<ParticleCreateInfo>().swap(chunk);
+        }
+        env.add_particles(particles);
+
+        const double seconds =
+            std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        const double mbytes = static_cast<double>(section.size()) / (1024.0 * 1024.0);
+        SPDLOG_INFO("Parsed {} particles ({:.2f} MB) in {:.3f} s using {} chunks ({:.1f} MB/s)", total, mbytes,
+                    seconds, chunks.size(), seconds > 0 ? mbytes / seconds : 0.0);
     }
 
     /// -----------------------------------------
@@ -292,10 +409,7 @@ namespace md::io {
             args.boundary.set_boundary_rule(rules[vals[7 + i]], normals[i]);
         }
 
-        args.env.set_boundary(args.boundary);
-
-        bool build_blocks = args.parallel_strategy == 2 ? true : false;
-        args.env.build(build_blocks);
+        build_environment(args);
     }
 
     /// -----------------------------------------
@@ -319,16 +433,59 @@ namespace md::io {
     }
 
 
+    /// -----------------------------------------
+    /// \brief Parse inflow source information
+    /// -----------------------------------------
+    void parse_inflow(const std::string& line, ProgramArguments &args) {
+        SPDLOG_DEBUG("Reading Inflow:     {}", line);
+
+        // Minimum required values: 1 (rate) + 3 (origin) + 3 (extent) + 3 (velocity) + 1 (thermal_v) + 1 (mass)
+        // + 1 (type), optionally followed by start time, end time, minimal distance and seed
+        auto vals = parse_values(line, 13);
+        vals.resize(17, -1);
+
+        const vec3 origin = {vals[1], vals[2], vals[3]};
+        const vec3 extent = {vals[4], vals[5], vals[6]};
+        const vec3 velocity = {vals[7], vals[8], vals[9]};
+        const double start_time = vals[13] == -1 ? 0 : vals[13];
+        const double end_time = vals[14] == -1 ? std::numeric_limits<double>::max() : vals[14];
+        const double min_distance = vals[15] == -1 ? 0 : vals[15];
+        const auto seed = static_cast<unsigned int>(vals[16] == -1 ? 42 : vals[16]);
+
+        args.inflow_sources.emplace_back(vals[0], origin, extent, velocity, vals[10], vals[11],
+                                         static_cast<int>(vals[12]), start_time, end_time, min_distance, seed);
+
+        SPDLOG_DEBUG(
+                "Parsed Inflow:\n"
+                "       Rate:                {}\n"
+                "       Origin:              [{}, {}, {}]\n"
+                "       Extent:              [{}, {}, {}]\n"
+                "       Velocity:            [{}, {}, {}]\n"
+                "       Thermal Velocity:    {}\n"
+                "       Mass:                {}\n"
+                "       Type:                {}\n"
+                "       Time:                [{}, {}]\n"
+                "       Minimal distance:    {}",
+                vals[0], origin[0], origin[1], origin[2], extent[0], extent[1], extent[2], velocity[0], velocity[1],
+                velocity[2], vals[10], vals[11], vals[12], start_time, end_time, min_distance);
+    }
+
+
     /// -----------------------------------------
     /// \brief Parse statistics information
     /// -----------------------------------------
     void parse_statistics(const std::string& line, ProgramArguments &args) {
         SPDLOG_DEBUG("Reading Thermostats:     {}", line);
 
-        // Minimum required values: 1 (compute_freq) + 1 (n_bins)
+        // Minimum required values: 1 (compute_freq) + 1 (n_bins), optionally followed by the csv file name
         auto vals = parse_values(line, 2);
 
-        args.stats = std::make_unique<md::core::NanoFlowStatistics>(vals[0], vals[1]);
+        std::istringstream data_stream(line);
+        std::string file_name = STATISTICS_FILE;
+        double num;
+        data_stream >> num >> num >> file_name;
+
+        args.stats = std::make_unique<md::core::NanoFlowStatistics>(vals[0], vals[1], file_name);
 
         SPDLOG_DEBUG(fmt::format("Parsed stats: \n"
                                  "       compute_freq: {}\n"
@@ -367,26 +524,26 @@ namespace md::io {
         args.dt = vals[1];
         args.write_freq = vals[2];
         args.cutoff_radius = vals[3];
-        // parallel_strategy: [0] = no parallelization, [1] = cell lock, [2] = spatial decomposition
+        // parallel_strategy: [0] = no parallelization, [1] = cell lock, [2] = spatial decomposition, [3] = newton3 off
         args.parallel_strategy = vals[4];
         args.output_baseName = basename;
     }
 
 
     void read_file_txt(const std::string& file_name, ProgramArguments &args) {
-        std::ifstream infile(file_name);
-        if (!infile.is_open()) {
+        const utils::MappedFile file(file_name);
+        if (!file.is_open()) {
             SPDLOG_ERROR("Failed opening file {}", file_name);
             exit(-1);
         }
 
         SPDLOG_INFO("Start reading file {}", file_name);
 
-        std::string line;
-        enum Section { NONE, GENERAL, PARTICLES, CUBOIDS, SPHERES, FORCE, ENVIRONMENT, THERMOSTATS, MEMBRANE, STATISTICS}
+        enum Section { NONE, GENERAL, PARTICLES, CUBOIDS, SPHERES, FORCE, ENVIRONMENT, THERMOSTATS, MEMBRANE, STATISTICS,
+                      INFLOW}
                         section = NONE;
 
-        std::unordered_map<std::string, Section> sectionMap = {
+        const std::array<std::pair<std::string_view, Section>, 10> sectionMap = {{
                 {"general:", GENERAL},
                 {"particles:", PARTICLES},
                 {"cuboids:", CUBOIDS},
@@ -395,47 +552,65 @@ namespace md::io {
                 {"environment:", ENVIRONMENT},
                 {"thermostats:", THERMOSTATS},
                 {"membranes:", MEMBRANE},
-                {"statistics:", STATISTICS}
+                {"statistics:", STATISTICS},
+                {"inflow:", INFLOW}
+        }};
+
+        // returns the section a header line starts, NONE if the line is no section header
+        auto find_section = [&sectionMap](std::string_view line) {
+            if (line.empty() || !std::isalpha(static_cast<unsigned char>(line[0]))) return NONE;
+            for (const auto& [key, value] : sectionMap) {
+                if (line.starts_with(key)) return value;
+            }
+            return NONE;
         };
 
-        while (std::getline(infile, line)) {
-            trim(line);
+        std::string_view text = file.view();
+        std::string_view raw_line;
+        while (next_line(text, raw_line)) {
+            const std::string_view line = trim(raw_line);
 
             if (line.empty() || line[0] == '#') {
                 continue;
             }
 
-            bool sectionFound = false;
-            for (const auto& [key, value] : sectionMap) {
-                if (line.compare(0, key.size(), key) == 0) {
-                    section = value;
-                    sectionFound = true;
-                    break;
+            if (const Section found = find_section(line); found != NONE) {
+                section = found;
+
+                if (section == PARTICLES) {
+                    // the particle section extends up to the next section header and is parsed in bulk
+                    std::string_view rest = text;
+                    std::string_view next;
+                    while (next_line(rest, next) && find_section(trim(next)) == NONE) {
+                        text = rest;
+                    }
+                    const std::string_view block = file.view().substr(
+                        line.data() + line.size() - file.view().data(),
+                        text.data() - line.data() - line.size());
+                    parse_particles(block, args.env);
                 }
-            }
-
-            if (sectionFound) {
                 continue;
             }
 
+            const std::string line_str(line);
             if (section == GENERAL)
-                parse_general(line, args);
-            else if (section == PARTICLES)
-                parse_particle(line, args.env);
+                parse_general(line_str, args);
             else if (section == CUBOIDS)
-                parse_cuboid(line, args.env);
+                parse_cuboid(line_str, args.env);
             else if (section == SPHERES)
-                parse_sphere(line, args.env);
+                parse_sphere(line_str, args.env);
             else if (section == MEMBRANE)
-                parse_membrane(line, args);
+                parse_membrane(line_str, args);
             else if (section == FORCE)
-                parse_force(line, args);
+                parse_force(line_str, args);
             else if (section == ENVIRONMENT)
-                parse_environment(line, args);
+                parse_environment(line_str, args);
             else if (section == THERMOSTATS)
-                parse_thermostats(line, args);
+                parse_thermostats(line_str, args);
             else if (section == STATISTICS)
-                parse_statistics(line, args);
+                parse_statistics(line_str, args);
+            else if (section == INFLOW)
+                parse_inflow(line_str, args);
         }
 
         SPDLOG_INFO("File successfully read: {}", file_name);
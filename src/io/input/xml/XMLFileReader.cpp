@@ -29,7 +29,9 @@ namespace md::io {
 
             SPDLOG_INFO("Start reading file {}", file_name);
 
-            auto simulation = simulation_(file, xml_schema::flags::dont_validate);
+            xml_schema::properties properties;
+            properties.no_namespace_schema_location(MOLSIM_SCHEMA_FILE);
+            auto simulation = simulation_(file, args.validate_input ? 0 : xml_schema::flags::dont_validate, properties);
 
 
             /// -----------------------------------------
@@ -37,19 +39,59 @@ namespace md::io {
             /// -----------------------------------------
             args.output_baseName = static_cast<std::string>(simulation->output().base_name());
             args.write_freq = simulation->output().write_frequency();
+
+            for (const auto& region : simulation->output().region()) {
+                args.output_filter.regions.push_back(
+                    env::MarkBox({region.MarkBoxVec1()[0], region.MarkBoxVec1()[1], region.MarkBoxVec1()[2]},
+                                 {region.MarkBoxVec2()[0], region.MarkBoxVec2()[1], region.MarkBoxVec2()[2]}));
+            }
+            for (const auto& type : simulation->output().type()) {
+                args.output_filter.types.push_back(type);
+            }
+            if (simulation->output().stride().present()) {
+                if (simulation->output().stride().get() < 1) {
+                    ERROR_AND_EXIT(fmt::format("Invalid output stride: {}", simulation->output().stride().get()));
+                }
+                args.output_filter.stride = simulation->output().stride().get();
+            }
+            if (simulation->output().fields().present()) {
+                try {
+                    args.output_filter.fields = OutputFilter::parse_fields(simulation->output().fields().get());
+                } catch (const std::invalid_argument& e) {
+                    ERROR_AND_EXIT(std::string(e.what()));
+                }
+            }
             args.duration = simulation->parameters().end_t();
             args.dt = simulation->parameters().delta_t();
             args.cutoff_radius = simulation->parameters().cutoff_radius();
 
             std::string strategy = simulation->parameters().parallel_strategy();
-            if (strategy != "NONE" && strategy != "CELL_LOCK" && strategy != "SPATIAL_DECOMPOSITION") {
+            if (strategy != "NONE" && strategy != "CELL_LOCK" && strategy != "SPATIAL_DECOMPOSITION" &&
+                strategy != "NEWTON3_OFF") {
                 ERROR_AND_EXIT(fmt::format("Invalid parallelization strategy: {}", strategy));
             }
             if (strategy == "CELL_LOCK") args.parallel_strategy = 1;
             else if (strategy == "SPATIAL_DECOMPOSITION") args.parallel_strategy = 2;
+            else if (strategy == "NEWTON3_OFF") args.parallel_strategy = 3;
             else args.parallel_strategy = 0;
 
-            bool build_blocks = args.parallel_strategy == 2 ? true : false;
+            if (simulation->parameters().respa_substeps().present()) {
+                if (simulation->parameters().respa_substeps().get() < 1) {
+                    ERROR_AND_EXIT(fmt::format("Invalid number of RESPA substeps: {}",
+                                               simulation->parameters().respa_substeps().get()));
+                }
+                args.respa_substeps = simulation->parameters().respa_substeps().get();
+            }
+
+            if (simulation->parameters().pair_method().present()) {
+                const std::string method = simulation->parameters().pair_method().get();
+                if (method != "AUTO" && method != "LINKED_CELLS" && method != "DIRECT_SUM") {
+                    ERROR_AND_EXIT(fmt::format("Invalid pair force method: {}", method));
+                }
+                if (method == "LINKED_CELLS") args.pair_method = env::PairMethod::LINKED_CELLS;
+                else if (method == "DIRECT_SUM") args.pair_method = env::PairMethod::DIRECT_SUM;
+                else args.pair_method = env::PairMethod::AUTO;
+            }
 
             /// -----------------------------------------
             ///  Parse particle information
@@ -301,8 +343,7 @@ namespace md::io {
                 }
             }
 
-            args.env.set_boundary(args.boundary);
-            args.env.build(build_blocks);
+            build_environment(args);
 
 
             /// -----------------------------------------
@@ -326,8 +367,10 @@ namespace md::io {
             ///  Parse Statistics
             /// -----------------------------------------
             if (simulation->statistics()) {
-                args.stats = std::make_unique<md::core::NanoFlowStatistics>(simulation->statistics()->compute_freq(),
-                                                                            simulation->statistics()->n_bins());
+                args.stats = std::make_unique<md::core::NanoFlowStatistics>(
+                    simulation->statistics()->compute_freq(), simulation->statistics()->n_bins(),
+                    simulation->statistics()->file() ? std::string(simulation->statistics()->file().get())
+                                                     : std::string(STATISTICS_FILE));
 
                 SPDLOG_DEBUG(fmt::format("Parsed stats: \n"
                              "       compute_freq: {}\n"
@@ -1,6 +1,11 @@
 #pragma once
 #include "utils/Parse.h"
 
+// location of the simulation schema, used when validating input files
+#ifndef MOLSIM_SCHEMA_FILE
+#define MOLSIM_SCHEMA_FILE "src/io/input/xml/molSimSchema.xsd"
+#endif
+
 namespace md::io {
     struct ProgramArguments;
     /**
@@ -0,0 +1,393 @@
+#include "XMLStreamReader.h"
+
+#include <xercesc/sax/SAXParseException.hpp>
+#include <xercesc/sax2/Attributes.hpp>
+#include <xercesc/sax2/DefaultHandler.hpp>
+#include <xercesc/sax2/SAX2XMLReader.hpp>
+#include <xercesc/sax2/XMLReaderFactory.hpp>
+#include <xercesc/util/PlatformUtils.hpp>
+#include <xercesc/util/XMLString.hpp>
+#include <xercesc/util/XMLUni.hpp>
+
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "XMLFileReader.h"
+#include "env/Environment.h"
+#include "io/IOStrategy.h"
+#include "io/Logger/Logger.h"
+
+// number of single particles collected before they are handed to the environment
+#define PARTICLE_BATCH_SIZE 4096
+
+namespace md::io {
+    using namespace env;
+    using namespace xercesc;
+
+    std::string transcode(const XMLCh* const str) {
+        char* c_str = XMLString::transcode(str);
+        std::string result(c_str);
+        XMLString::release(&c_str);
+        return result;
+    }
+
+    /**
+     * @brief SAX handler that turns the elements of a simulation file into calls on the ProgramArguments.
+     *
+     * Elements are tracked by their depth: depth 1 is the simulation element, depth 2 the sections (output,
+     * parameters, particles, ...) and depth 3 the values of a section. The values of a section are collected as text
+     * and processed as soon as the section is closed.
+     */
+    class SimulationHandler final : public DefaultHandler {
+       public:
+        explicit SimulationHandler(ProgramArguments& args) : args(args) {}
+
+        void startElement(const XMLCh* const, const XMLCh* const local_name, const XMLCh* const,
+                          const Attributes& attrs) override {
+            depth++;
+            const std::string name = transcode(local_name);
+            if (depth == 2) {
+                section = name;
+                fields.clear();
+                if (section == "Boundary") parse_boundary(attributes(attrs));
+            } else if (depth == 3) {
+                text.clear();
+                if (name == "Force") parse_force(attributes(attrs));
+                else if (name == "ConstantForce") parse_constant_force(attributes(attrs));
+                else if (section == "output" && name == "region") parse_output_region(attributes(attrs));
+            }
+        }
+
+        void endElement(const XMLCh* const, const XMLCh* const local_name, const XMLCh* const) override {
+            if (depth == 3) {
+                const std::string name = transcode(local_name);
+                // the output section may list several types to write
+                if (section == "output" && name == "type") args.output_filter.types.push_back(to_int(trim(text)));
+                else fields[name] = trim(text);
+            } else if (depth == 2) {
+                end_section();
+            }
+            depth--;
+        }
+
+        void characters(const XMLCh* const chars, const XMLSize_t length) override {
+            if (depth != 3) return;
+            std::vector<XMLCh> buffer(chars, chars + length);
+            buffer.push_back(0);
+            text += transcode(buffer.data());
+        }
+
+        void endDocument() override { flush_particles(); }
+
+        /**
+         * @brief Builds the environment once the whole document has been read and applies the thermostat.
+         */
+        void finish() const {
+            build_environment(args);
+
+            if (thermostat) {
+                args.thermostat.init(init_T, target_T, temp_dT);
+                args.thermostat.set_initial_temperature(args.env);
+            }
+        }
+
+        void warning(const SAXParseException& e) override {
+            SPDLOG_WARN("XML warning at line {}, column {}: {}", e.getLineNumber(), e.getColumnNumber(),
+                        transcode(e.getMessage()));
+        }
+
+        void error(const SAXParseException& e) override {
+            throw std::invalid_argument(fmt::format("line {}, column {}: {}", e.getLineNumber(), e.getColumnNumber(),
+                                                    transcode(e.getMessage())));
+        }
+
+        void fatalError(const SAXParseException& e) override { error(e); }
+
+       private:
+        using Fields = std::unordered_map<std::string, std::string>;
+
+        static Fields attributes(const Attributes& attrs) {
+            Fields result;
+            for (XMLSize_t i = 0; i < attrs.getLength(); ++i) {
+                result[transcode(attrs.getLocalName(i))] = trim(transcode(attrs.getValue(i)));
+            }
+            return result;
+        }
+
+        static std::string trim(const std::string& str) {
+            const size_t first = str.find_first_not_of(" \t\n\r");
+            if (first == std::string::npos) return {};
+            return str.substr(first, str.find_last_not_of(" \t\n\r") - first + 1);
+        }
+
+        /// -----------------------------------------
+        /// \brief Typed access to the collected values
+        /// -----------------------------------------
+        static const std::string& get(const Fields& values, const std::string& name) {
+            const auto it = values.find(name);
+            if (it == values.end()) throw std::invalid_argument(fmt::format("missing value '{}'", name));
+            return it->second;
+        }
+
+        static const std::string& get(const Fields& values, const std::string& name, const std::string& fallback) {
+            const auto it = values.find(name);
+            return it == values.end() || it->second.empty() ? fallback : it->second;
+        }
+
+        template <size_t N>
+        static std::array<double, N> to_doubles(const std::string& str) {
+            std::array<double, N> result{};
+            const char* it = str.data();
+            const char* const end = str.data() + str.size();
+            for (size_t i = 0; i < N; ++i) {
+                while (it != end && std::isspace(static_cast<unsigned char>(*it))) ++it;
+                const auto [ptr, ec] = std::from_chars(it, end, result[i]);
+                if (ec != std::errc()) throw std::invalid_argument(fmt::format("invalid number list '{}'", str));
+                it = ptr;
+            }
+            return result;
+        }
+
+        static double to_double(const std::string& str) { return to_doubles<1>(str)[0]; }
+        static int to_int(const std::string& str) { return static_cast<int>(to_double(str)); }
+        static uint3 to_uint3(const std::string& str) {
+            const auto vals = to_doubles<3>(str);
+            return {static_cast<UINT_T>(vals[0]), static_cast<UINT_T>(vals[1]), static_cast<UINT_T>(vals[2])};
+        }
+
+        static Particle::State to_state(const std::string& str) {
+            if (str == "ALIVE") return Particle::ALIVE;
+            if (str == "STATIONARY") return Particle::STATIONARY;
+            throw std::invalid_argument(fmt::format("Invalid particle state {}", str));
+        }
+
+        static Dimension to_dimension(const std::string& str, const bool allow_infer = false) {
+            const int dim = to_int(str);
+            if (dim != 2 && dim != 3 && !(allow_infer && dim == -1)) {
+                throw std::invalid_argument(fmt::format("Invalid dimension parameter {}", dim));
+            }
+            return static_cast<Dimension>(dim);
+        }
+
+        static BoundaryRule to_boundary_rule(const std::string& type) {
+            if (type == "OUTFLOW") return OUTFLOW;
+            if (type == "VELOCITY_REFLECTION") return VELOCITY_REFLECTION;
+            if (type == "REPULSIVE_FORCE") return REPULSIVE_FORCE;
+            if (type == "PERIODIC") return PERIODIC;
+            throw std::invalid_argument("Unknown boundary type: " + type);
+        }
+
+        /// -----------------------------------------
+        /// \brief Section handlers
+        /// -----------------------------------------
+        void end_section() {
+            if (section == "output") {
+                args.output_baseName = get(fields, "base_name");
+                args.write_freq = to_int(get(fields, "write_frequency"));
+                if (fields.contains("stride")) {
+                    const int stride = to_int(get(fields, "stride"));
+                    if (stride < 1) throw std::invalid_argument(fmt::format("Invalid output stride: {}", stride));
+                    args.output_filter.stride = stride;
+                }
+                if (fields.contains("fields")) {
+                    args.output_filter.fields = OutputFilter::parse_fields(get(fields, "fields"));
+                }
+            } else if (section == "parameters") {
+                args.duration = to_double(get(fields, "end_t"));
+                args.dt = to_double(get(fields, "delta_t"));
+                args.cutoff_radius = to_double(get(fields, "cutoff_radius"));
+                const std::string& strategy = get(fields, "parallel_strategy");
+                if (strategy == "CELL_LOCK") args.parallel_strategy = 1;
+                else if (strategy == "SPATIAL_DECOMPOSITION") args.parallel_strategy = 2;
+                else if (strategy == "NEWTON3_OFF") args.parallel_strategy = 3;
+                else if (strategy == "NONE") args.parallel_strategy = 0;
+                else throw std::invalid_argument(fmt::format("Invalid parallelization strategy: {}", strategy));
+                if (fields.contains("respa_substeps")) {
+                    const int substeps = to_int(get(fields, "respa_substeps"));
+                    if (substeps < 1) {
+                        throw std::invalid_argument(fmt::format("Invalid number of RESPA substeps: {}", substeps));
+                    }
+                    args.respa_substeps = substeps;
+                }
+                if (fields.contains("pair_method")) {
+                    const std::string& method = get(fields, "pair_method");
+                    if (method == "LINKED_CELLS") args.pair_method = env::PairMethod::LINKED_CELLS;
+                    else if (method == "DIRECT_SUM") args.pair_method = env::PairMethod::DIRECT_SUM;
+                    else if (method == "AUTO") args.pair_method = env::PairMethod::AUTO;
+                    else throw std::invalid_argument(fmt::format("Invalid pair force method: {}", method));
+                }
+            } else if (section == "particles") {
+                const auto origin = to_doubles<3>(get(fields, "origin"));
+                const auto velocity = to_doubles<3>(get(fields, "velocity"));
+                pending_particles.emplace_back(origin, velocity, to_double(get(fields, "mass")),
+                                               to_int(get(fields, "type")), to_state(get(fields, "state", "ALIVE")));
+                if (pending_particles.size() >= PARTICLE_BATCH_SIZE) flush_particles();
+            } else if (section == "cuboids") {
+                flush_particles();
+                args.env.add_cuboid(to_doubles<3>(get(fields, "origin")), to_doubles<3>(get(fields, "velocity")),
+                                    to_uint3(get(fields, "numPart")), to_double(get(fields, "width")),
+                                    to_double(get(fields, "mass")), to_double(get(fields, "thermal_v", "0")),
+                                    to_int(get(fields, "type", "0")), to_dimension(get(fields, "dimension"), true),
+                                    to_state(get(fields, "state", "ALIVE")));
+                SPDLOG_DEBUG("Streamed cuboid with {} particles", args.env.size(Particle::ALIVE | Particle::STATIONARY));
+            } else if (section == "spheres") {
+                flush_particles();
+                args.env.add_sphere(to_doubles<3>(get(fields, "origin")), to_doubles<3>(get(fields, "velocity")),
+                                    to_int(get(fields, "radius")), to_double(get(fields, "width")),
+                                    to_double(get(fields, "mass")), to_double(get(fields, "thermal_v", "0")),
+                                    to_int(get(fields, "type", "0")), to_dimension(get(fields, "dimension")),
+                                    to_state(get(fields, "state", "ALIVE")));
+            } else if (section == "membranes") {
+                flush_particles();
+                args.env.add_membrane(to_doubles<3>(get(fields, "origin")), to_doubles<3>(get(fields, "velocity")),
+                                      to_uint3(get(fields, "numPart")), to_double(get(fields, "width")),
+                                      to_double(get(fields, "mass")), to_double(get(fields, "k")),
+                                      to_double(get(fields, "cutoff")), to_int(get(fields, "type", "0")));
+            } else if (section == "Thermostat") {
+                thermostat = true;
+                args.temp_adj_freq = to_int(get(fields, "n_thermostats"));
+                init_T = to_double(get(fields, "init_T"));
+                target_T = to_double(get(fields, "target_T", "-1"));
+                temp_dT = to_double(get(fields, "temp_dT", "1000"));
+                if (temp_dT == -1) temp_dT = std::numeric_limits<double>::infinity();
+            } else if (section == "statistics") {
+                args.stats = std::make_unique<core::NanoFlowStatistics>(to_int(get(fields, "compute_freq")),
+                                                                        to_int(get(fields, "n_bins")),
+                                                                        get(fields, "file", STATISTICS_FILE));
+            }
+        }
+
+        void parse_boundary(const Fields& attrs) {
+            args.boundary.extent = to_doubles<3>(get(attrs, "extent"));
+            args.boundary.origin = to_doubles<3>(get(attrs, "origin"));
+
+            args.boundary.set_boundary_rule(to_boundary_rule(get(attrs, "typeFRONT")), BoundaryNormal::FRONT);
+            args.boundary.set_boundary_rule(to_boundary_rule(get(attrs, "typeBACK")), BoundaryNormal::BACK);
+            args.boundary.set_boundary_rule(to_boundary_rule(get(attrs, "typeRIGHT")), BoundaryNormal::RIGHT);
+            args.boundary.set_boundary_rule(to_boundary_rule(get(attrs, "typeTOP")), BoundaryNormal::TOP);
+            args.boundary.set_boundary_rule(to_boundary_rule(get(attrs, "typeLEFT")), BoundaryNormal::LEFT);
+            args.boundary.set_boundary_rule(to_boundary_rule(get(attrs, "typeBOTTOM")), BoundaryNormal::BOTTOM);
+
+            if (attrs.contains("force_type")) {
+                const std::string& force_type = get(attrs, "force_type");
+                if (force_type == "lennardJones") {
+                    args.boundary.set_boundary_force(Boundary::LennardJonesForce(
+                        to_double(get(attrs, "force_arg1")), to_double(get(attrs, "force_arg2"))));
+                } else if (force_type == "inverseSquare") {
+                    args.boundary.set_boundary_force(
+                        Boundary::InverseDistanceForce(args.cutoff_radius, to_double(get(attrs, "force_arg1"))));
+                } else {
+                    throw std::invalid_argument("Parsing boundary force failed");
+                }
+            }
+
+            args.env.set_grid_constant(to_double(get(attrs, "grid_constant")));
+        }
+
+        void parse_force(const Fields& attrs) const {
+            const std::string& type = get(attrs, "type");
+            const int particle_type = to_int(get(attrs, "partType"));
+            if (type == "lennardJones") {
+                args.env.set_force(LennardJones(to_double(get(attrs, "arg1")), to_double(get(attrs, "arg2")),
+                                                args.cutoff_radius), particle_type);
+            } else if (type == "inverseSquare") {
+                args.env.set_force(InverseSquare(to_double(get(attrs, "arg1")), args.cutoff_radius), particle_type);
+            } else {
+                throw std::invalid_argument(fmt::format("Invalid force type: {}", type));
+            }
+        }
+
+        void parse_constant_force(const Fields& attrs) const {
+            const std::string& type = get(attrs, "type");
+            const auto direction = to_doubles<3>(get(attrs, "direction"));
+            const double strength = to_double(get(attrs, "strength"));
+            if (type == "gravity") {
+                args.external_forces.push_back(Gravity(strength, direction));
+            } else if (type == "pullForce") {
+                const std::string& const_acc = get(attrs, "const_acc", "false");
+                args.external_forces.emplace_back(
+                    direction, strength,
+                    MarkBox(to_doubles<3>(get(attrs, "MarkBoxVec1")), to_doubles<3>(get(attrs, "MarkBoxVec2"))),
+                    to_double(get(attrs, "start_t", "0")), to_double(get(attrs, "end_t", "0")),
+                    const_acc == "true" || const_acc == "1");
+            } else {
+                throw std::invalid_argument(fmt::format("Invalid Constant Force type: {}", type));
+            }
+        }
+
+        void parse_output_region(const Fields& attrs) const {
+            args.output_filter.regions.push_back(
+                MarkBox(to_doubles<3>(get(attrs, "MarkBoxVec1")), to_doubles<3>(get(attrs, "MarkBoxVec2"))));
+        }
+
+        void flush_particles() {
+            if (pending_particles.empty()) return;
+            args.env.add_particles(pending_particles);
+            pending_particles.clear();
+        }
+
+        ProgramArguments& args;
+        int depth = 0;                                   ///< Nesting depth of the current element.
+        std::string section;                             ///< Name of the current top level section.
+        std::string text;                                ///< Character data of the current value element.
+        Fields fields;                                   ///< Values collected for the current section.
+        std::vector<ParticleCreateInfo> pending_particles;  ///< Single particles not yet added to the environment.
+
+        bool thermostat = false;
+        double init_T = 0;
+        double target_T = -1;
+        double temp_dT = 1000;
+    };
+
+    void read_file_xml_stream(const std::string& file_name, ProgramArguments& args, const bool validate) {
+        SPDLOG_INFO("Start streaming file {}{}", file_name, validate ? " (validating)" : "");
+
+        try {
+            XMLPlatformUtils::Initialize();
+        } catch (const XMLException& e) {
+            SPDLOG_ERROR("Xerces initialization failed: {}", transcode(e.getMessage()));
+            exit(-1);
+        }
+
+        {
+            const std::unique_ptr<SAX2XMLReader> parser(XMLReaderFactory::createXMLReader());
+            parser->setFeature(XMLUni::fgSAX2CoreNameSpaces, true);
+            parser->setFeature(XMLUni::fgSAX2CoreValidation, validate);
+            parser->setFeature(XMLUni::fgXercesSchema, validate);
+            parser->setFeature(XMLUni::fgXercesLoadSchema, validate);
+            parser->setFeature(XMLUni::fgXercesLoadExternalDTD, false);
+            XMLCh* schema_location = XMLString::transcode(MOLSIM_SCHEMA_FILE);
+            if (validate) {
+                parser->setFeature(XMLUni::fgXercesDynamic, false);
+                parser->setFeature(XMLUni::fgXercesSchemaFullChecking, true);
+                parser->setProperty(XMLUni::fgXercesSchemaExternalNoNameSpaceSchemaLocation, schema_location);
+            }
+
+            SimulationHandler handler(args);
+            parser->setContentHandler(&handler);
+            parser->setErrorHandler(&handler);
+
+            try {
+                parser->parse(file_name.c_str());
+            } catch (const std::invalid_argument& e) {
+                SPDLOG_ERROR("XML parsing error in {}: {}", file_name, e.what());
+                exit(-1);
+            } catch (const XMLException& e) {
+                SPDLOG_ERROR("XML parsing error in {}: {}", file_name, transcode(e.getMessage()));
+                exit(-1);
+            }
+            XMLString::release(&schema_location);
+            handler.finish();
+        }
+
+        XMLPlatformUtils::Terminate();
+        SPDLOG_INFO("File successfully read: {}", file_name);
+    }
+}  // namespace md::io
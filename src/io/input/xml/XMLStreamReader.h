@@ -0,0 +1,15 @@
+#pragma once
+#include <string>
+
+namespace md::io {
+    struct ProgramArguments;
+    /**
+    * @brief Reads a xml file in streaming (SAX) mode.
+    * In contrast to read_file_xml no document tree is built: particles, cuboids, spheres and membranes are handed to
+    * the environment as soon as their element is closed, so memory use does not grow with the size of the input file.
+    * @param file_name The name of the file.
+    * @param args The ProgramArguments.
+    * @param validate Validate the file against the simulation schema while reading it.
+    */
+    void read_file_xml_stream(const std::string& file_name, ProgramArguments& args, bool validate = false);
+} // namespace md::io
@@ -338,6 +338,51 @@ operator= (value v)
 }
 
 
+// PairMethodType
+// 
+
+PairMethodType::
+PairMethodType (value v)
+: ::xml_schema::string (_xsd_PairMethodType_literals_[v])
+{
+}
+
+PairMethodType::
+PairMethodType (const char* v)
+: ::xml_schema::string (v)
+{
+}
+
+PairMethodType::
+PairMethodType (const ::std::string& v)
+: ::xml_schema::string (v)
+{
+}
+
+PairMethodType::
+PairMethodType (const ::xml_schema::string& v)
+: ::xml_schema::string (v)
+{
+}
+
+PairMethodType::
+PairMethodType (const PairMethodType& v,
+                ::xml_schema::flags f,
+                ::xml_schema::container* c)
+: ::xml_schema::string (v, f, c)
+{
+}
+
+PairMethodType& PairMethodType::
+operator= (value v)
+{
+  static_cast< ::xml_schema::string& > (*this) = 
+  ::xml_schema::string (_xsd_PairMethodType_literals_[v]);
+
+  return *this;
+}
+
+
 // Force
 // 
 
@@ -926,6 +971,58 @@ force_arg2 (const force_arg2_optional& x)
 }
 
 
+// OutputRegion
+// 
+
+const OutputRegion::MarkBoxVec1_type& OutputRegion::
+MarkBoxVec1 () const
+{
+  return this->MarkBoxVec1_.get ();
+}
+
+OutputRegion::MarkBoxVec1_type& OutputRegion::
+MarkBoxVec1 ()
+{
+  return this->MarkBoxVec1_.get ();
+}
+
+void OutputRegion::
+MarkBoxVec1 (const MarkBoxVec1_type& x)
+{
+  this->MarkBoxVec1_.set (x);
+}
+
+void OutputRegion::
+MarkBoxVec1 (::std::auto_ptr< MarkBoxVec1_type > x)
+{
+  this->MarkBoxVec1_.set (x);
+}
+
+const OutputRegion::MarkBoxVec2_type& OutputRegion::
+MarkBoxVec2 () const
+{
+  return this->MarkBoxVec2_.get ();
+}
+
+OutputRegion::MarkBoxVec2_type& OutputRegion::
+MarkBoxVec2 ()
+{
+  return this->MarkBoxVec2_.get ();
+}
+
+void OutputRegion::
+MarkBoxVec2 (const MarkBoxVec2_type& x)
+{
+  this->MarkBoxVec2_.set (x);
+}
+
+void OutputRegion::
+MarkBoxVec2 (::std::auto_ptr< MarkBoxVec2_type > x)
+{
+  this->MarkBoxVec2_.set (x);
+}
+
+
 // simulation
 // 
 
@@ -1221,6 +1318,96 @@ write_frequency (const write_frequency_type& x)
   this->write_frequency_.set (x);
 }
 
+const output::region_sequence& output::
+region () const
+{
+  return this->region_;
+}
+
+output::region_sequence& output::
+region ()
+{
+  return this->region_;
+}
+
+void output::
+region (const region_sequence& s)
+{
+  this->region_ = s;
+}
+
+const output::type_sequence& output::
+type () const
+{
+  return this->type_;
+}
+
+output::type_sequence& output::
+type ()
+{
+  return this->type_;
+}
+
+void output::
+type (const type_sequence& s)
+{
+  this->type_ = s;
+}
+
+const output::stride_optional& output::
+stride () const
+{
+  return this->stride_;
+}
+
+output::stride_optional& output::
+stride ()
+{
+  return this->stride_;
+}
+
+void output::
+stride (const stride_type& x)
+{
+  this->stride_.set (x);
+}
+
+void output::
+stride (const stride_optional& x)
+{
+  this->stride_ = x;
+}
+
+const output::fields_optional& output::
+fields () const
+{
+  return this->fields_;
+}
+
+output::fields_optional& output::
+fields ()
+{
+  return this->fields_;
+}
+
+void output::
+fields (const fields_type& x)
+{
+  this->fields_.set (x);
+}
+
+void output::
+fields (const fields_optional& x)
+{
+  this->fields_ = x;
+}
+
+void output::
+fields (::std::auto_ptr< fields_type > x)
+{
+  this->fields_.set (x);
+}
+
 
 // parameters
 // 
@@ -1303,6 +1490,60 @@ parallel_strategy (::std::auto_ptr< parallel_strategy_type > x)
   this->parallel_strategy_.set (x);
 }
 
+const parameters::respa_substeps_optional& parameters::
+respa_substeps () const
+{
+  return this->respa_substeps_;
+}
+
+parameters::respa_substeps_optional& parameters::
+respa_substeps ()
+{
+  return this->respa_substeps_;
+}
+
+void parameters::
+respa_substeps (const respa_substeps_type& x)
+{
+  this->respa_substeps_.set (x);
+}
+
+void parameters::
+respa_substeps (const respa_substeps_optional& x)
+{
+  this->respa_substeps_ = x;
+}
+
+const parameters::pair_method_optional& parameters::
+pair_method () const
+{
+  return this->pair_method_;
+}
+
+parameters::pair_method_optional& parameters::
+pair_method ()
+{
+  return this->pair_method_;
+}
+
+void parameters::
+pair_method (const pair_method_type& x)
+{
+  this->pair_method_.set (x);
+}
+
+void parameters::
+pair_method (const pair_method_optional& x)
+{
+  this->pair_method_ = x;
+}
+
+void parameters::
+pair_method (::std::auto_ptr< pair_method_type > x)
+{
+  this->pair_method_.set (x);
+}
+
 
 // Forces
 // 
@@ -2205,6 +2446,36 @@ n_bins (const n_bins_type& x)
   this->n_bins_.set (x);
 }
 
+const statistics::file_optional& statistics::
+file () const
+{
+  return this->file_;
+}
+
+statistics::file_optional& statistics::
+file ()
+{
+  return this->file_;
+}
+
+void statistics::
+file (const file_type& x)
+{
+  this->file_.set (x);
+}
+
+void statistics::
+file (const file_optional& x)
+{
+  this->file_ = x;
+}
+
+void statistics::
+file (::std::auto_ptr< file_type > x)
+{
+  this->file_.set (x);
+}
+
 
 #include <xsd/cxx/xml/dom/parsing-source.hxx>
 
@@ -2777,11 +3048,11 @@ _xsd_ParallelType_convert () const
   ::xsd::cxx::tree::enum_comparator< char > c (_xsd_ParallelType_literals_);
   const value* i (::std::lower_bound (
                     _xsd_ParallelType_indexes_,
-                    _xsd_ParallelType_indexes_ + 3,
+                    _xsd_ParallelType_indexes_ + 4,
                     *this,
                     c));
 
-  if (i == _xsd_ParallelType_indexes_ + 3 || _xsd_ParallelType_literals_[*i] != *this)
+  if (i == _xsd_ParallelType_indexes_ + 4 || _xsd_ParallelType_literals_[*i] != *this)
   {
     throw ::xsd::cxx::tree::unexpected_enumerator < char > (*this);
   }
@@ -2790,21 +3061,95 @@ _xsd_ParallelType_convert () const
 }
 
 const char* const ParallelType::
-_xsd_ParallelType_literals_[3] =
+_xsd_ParallelType_literals_[4] =
 {
   "NONE",
   "CELL_LOCK",
-  "SPATIAL_DECOMPOSITION"
+  "SPATIAL_DECOMPOSITION",
+  "NEWTON3_OFF"
 };
 
 const ParallelType::value ParallelType::
-_xsd_ParallelType_indexes_[3] =
+_xsd_ParallelType_indexes_[4] =
 {
   ::ParallelType::CELL_LOCK,
+  ::ParallelType::NEWTON3_OFF,
   ::ParallelType::NONE,
   ::ParallelType::SPATIAL_DECOMPOSITION
 };
 
+// PairMethodType
+//
+
+PairMethodType::
+PairMethodType (const ::xercesc::DOMElement& e,
+                ::xml_schema::flags f,
+                ::xml_schema::container* c)
+: ::xml_schema::string (e, f, c)
+{
+  _xsd_PairMethodType_convert ();
+}
+
+PairMethodType::
+PairMethodType (const ::xercesc::DOMAttr& a,
+                ::xml_schema::flags f,
+                ::xml_schema::container* c)
+: ::xml_schema::string (a, f, c)
+{
+  _xsd_PairMethodType_convert ();
+}
+
+PairMethodType::
+PairMethodType (const ::std::string& s,
+                const ::xercesc::DOMElement* e,
+                ::xml_schema::flags f,
+                ::xml_schema::container* c)
+: ::xml_schema::string (s, e, f, c)
+{
+  _xsd_PairMethodType_convert ();
+}
+
+PairMethodType* PairMethodType::
+_clone (::xml_schema::flags f,
+        ::xml_schema::container* c) const
+{
+  return new class PairMethodType (*this, f, c);
+}
+
+PairMethodType::value PairMethodType::
+_xsd_PairMethodType_convert () const
+{
+  ::xsd::cxx::tree::enum_comparator< char > c (_xsd_PairMethodType_literals_);
+  const value* i (::std::lower_bound (
+                    _xsd_PairMethodType_indexes_,
+                    _xsd_PairMethodType_indexes_ + 3,
+                    *this,
+                    c));
+
+  if (i == _xsd_PairMethodType_indexes_ + 3 || _xsd_PairMethodType_literals_[*i] != *this)
+  {
+    throw ::xsd::cxx::tree::unexpected_enumerator < char > (*this);
+  }
+
+  return *i;
+}
+
+const char* const PairMethodType::
+_xsd_PairMethodType_literals_[3] =
+{
+  "AUTO",
+  "LINKED_CELLS",
+  "DIRECT_SUM"
+};
+
+const PairMethodType::value PairMethodType::
+_xsd_PairMethodType_indexes_[3] =
+{
+  ::PairMethodType::AUTO,
+  ::PairMethodType::DIRECT_SUM,
+  ::PairMethodType::LINKED_CELLS
+};
+
 // Force
 //
 
@@ -3364,6 +3709,106 @@ Boundary::
 {
 }
 
+// OutputRegion
+//
+
+OutputRegion::
+OutputRegion (const MarkBoxVec1_type& MarkBoxVec1,
+              const MarkBoxVec2_type& MarkBoxVec2)
+: ::xml_schema::type (),
+  MarkBoxVec1_ (MarkBoxVec1, this),
+  MarkBoxVec2_ (MarkBoxVec2, this)
+{
+}
+
+OutputRegion::
+OutputRegion (const OutputRegion& x,
+              ::xml_schema::flags f,
+              ::xml_schema::container* c)
+: ::xml_schema::type (x, f, c),
+  MarkBoxVec1_ (x.MarkBoxVec1_, f, this),
+  MarkBoxVec2_ (x.MarkBoxVec2_, f, this)
+{
+}
+
+OutputRegion::
+OutputRegion (const ::xercesc::DOMElement& e,
+              ::xml_schema::flags f,
+              ::xml_schema::container* c)
+: ::xml_schema::type (e, f | ::xml_schema::flags::base, c),
+  MarkBoxVec1_ (this),
+  MarkBoxVec2_ (this)
+{
+  if ((f & ::xml_schema::flags::base) == 0)
+  {
+    ::xsd::cxx::xml::dom::parser< char > p (e, false, false, true);
+    this->parse (p, f);
+  }
+}
+
+void OutputRegion::
+parse (::xsd::cxx::xml::dom::parser< char >& p,
+       ::xml_schema::flags f)
+{
+  while (p.more_attributes ())
+  {
+    const ::xercesc::DOMAttr& i (p.next_attribute ());
+    const ::xsd::cxx::xml::qualified_name< char > n (
+      ::xsd::cxx::xml::dom::name< char > (i));
+
+    if (n.name () == "MarkBoxVec1" && n.namespace_ ().empty ())
+    {
+      this->MarkBoxVec1_.set (MarkBoxVec1_traits::create (i, f, this));
+      continue;
+    }
+
+    if (n.name () == "MarkBoxVec2" && n.namespace_ ().empty ())
+    {
+      this->MarkBoxVec2_.set (MarkBoxVec2_traits::create (i, f, this));
+      continue;
+    }
+  }
+
+  if (!MarkBoxVec1_.present ())
+  {
+    throw ::xsd::cxx::tree::expected_attribute< char > (
+      "MarkBoxVec1",
+      "");
+  }
+
+  if (!MarkBoxVec2_.present ())
+  {
+    throw ::xsd::cxx::tree::expected_attribute< char > (
+      "MarkBoxVec2",
+      "");
+  }
+}
+
+OutputRegion* OutputRegion::
+_clone (::xml_schema::flags f,
+        ::xml_schema::container* c) const
+{
+  return new class OutputRegion (*this, f, c);
+}
+
+OutputRegion& OutputRegion::
+operator= (const OutputRegion& x)
+{
+  if (this != &x)
+  {
+    static_cast< ::xml_schema::type& > (*this) = x;
+    this->MarkBoxVec1_ = x.MarkBoxVec1_;
+    this->MarkBoxVec2_ = x.MarkBoxVec2_;
+  }
+
+  return *this;
+}
+
+OutputRegion::
+~OutputRegion ()
+{
+}
+
 // simulation
 //
 
@@ -3673,7 +4118,11 @@ output (const base_name_type& base_name,
         const write_frequency_type& write_frequency)
 : ::xml_schema::type (),
   base_name_ (base_name, this),
-  write_frequency_ (write_frequency, this)
+  write_frequency_ (write_frequency, this),
+  region_ (this),
+  type_ (this),
+  stride_ (this),
+  fields_ (this)
 {
 }
 
@@ -3683,7 +4132,11 @@ output (const output& x,
         ::xml_schema::container* c)
 : ::xml_schema::type (x, f, c),
   base_name_ (x.base_name_, f, this),
-  write_frequency_ (x.write_frequency_, f, this)
+  write_frequency_ (x.write_frequency_, f, this),
+  region_ (x.region_, f, this),
+  type_ (x.type_, f, this),
+  stride_ (x.stride_, f, this),
+  fields_ (x.fields_, f, this)
 {
 }
 
@@ -3693,7 +4146,11 @@ output (const ::xercesc::DOMElement& e,
         ::xml_schema::container* c)
 : ::xml_schema::type (e, f | ::xml_schema::flags::base, c),
   base_name_ (this),
-  write_frequency_ (this)
+  write_frequency_ (this),
+  region_ (this),
+  type_ (this),
+  stride_ (this),
+  fields_ (this)
 {
   if ((f & ::xml_schema::flags::base) == 0)
   {
@@ -3737,6 +4194,50 @@ parse (::xsd::cxx::xml::dom::parser< char >& p,
       }
     }
 
+    // region
+    //
+    if (n.name () == "region" && n.namespace_ ().empty ())
+    {
+      ::std::auto_ptr< region_type > r (
+        region_traits::create (i, f, this));
+
+      this->region_.push_back (r);
+      continue;
+    }
+
+    // type
+    //
+    if (n.name () == "type" && n.namespace_ ().empty ())
+    {
+      this->type_.push_back (type_traits::create (i, f, this));
+      continue;
+    }
+
+    // stride
+    //
+    if (n.name () == "stride" && n.namespace_ ().empty ())
+    {
+      if (!this->stride_)
+      {
+        this->stride_.set (stride_traits::create (i, f, this));
+        continue;
+      }
+    }
+
+    // fields
+    //
+    if (n.name () == "fields" && n.namespace_ ().empty ())
+    {
+      ::std::auto_ptr< fields_type > r (
+        fields_traits::create (i, f, this));
+
+      if (!this->fields_)
+      {
+        this->fields_.set (r);
+        continue;
+      }
+    }
+
     break;
   }
 
@@ -3770,6 +4271,10 @@ operator= (const output& x)
     static_cast< ::xml_schema::type& > (*this) = x;
     this->base_name_ = x.base_name_;
     this->write_frequency_ = x.write_frequency_;
+    this->region_ = x.region_;
+    this->type_ = x.type_;
+    this->stride_ = x.stride_;
+    this->fields_ = x.fields_;
   }
 
   return *this;
@@ -3792,7 +4297,9 @@ parameters (const end_t_type& end_t,
   end_t_ (end_t, this),
   delta_t_ (delta_t, this),
   cutoff_radius_ (cutoff_radius, this),
-  parallel_strategy_ (parallel_strategy, this)
+  parallel_strategy_ (parallel_strategy, this),
+  respa_substeps_ (this),
+  pair_method_ (this)
 {
 }
 
@@ -3804,7 +4311,9 @@ parameters (const parameters& x,
   end_t_ (x.end_t_, f, this),
   delta_t_ (x.delta_t_, f, this),
   cutoff_radius_ (x.cutoff_radius_, f, this),
-  parallel_strategy_ (x.parallel_strategy_, f, this)
+  parallel_strategy_ (x.parallel_strategy_, f, this),
+  respa_substeps_ (x.respa_substeps_, f, this),
+  pair_method_ (x.pair_method_, f, this)
 {
 }
 
@@ -3816,7 +4325,9 @@ parameters (const ::xercesc::DOMElement& e,
   end_t_ (this),
   delta_t_ (this),
   cutoff_radius_ (this),
-  parallel_strategy_ (this)
+  parallel_strategy_ (this),
+  respa_substeps_ (this),
+  pair_method_ (this)
 {
   if ((f & ::xml_schema::flags::base) == 0)
   {
@@ -3882,6 +4393,31 @@ parse (::xsd::cxx::xml::dom::parser< char >& p,
       }
     }
 
+    // respa_substeps
+    //
+    if (n.name () == "respa_substeps" && n.namespace_ ().empty ())
+    {
+      if (!this->respa_substeps_)
+      {
+        this->respa_substeps_.set (respa_substeps_traits::create (i, f, this));
+        continue;
+      }
+    }
+
+    // pair_method
+    //
+    if (n.name () == "pair_method" && n.namespace_ ().empty ())
+    {
+      ::std::auto_ptr< pair_method_type > r (
+        pair_method_traits::create (i, f, this));
+
+      if (!this->pair_method_)
+      {
+        this->pair_method_.set (r);
+        continue;
+      }
+    }
+
     break;
   }
 
@@ -3931,6 +4467,8 @@ operator= (const parameters& x)
     this->delta_t_ = x.delta_t_;
     this->cutoff_radius_ = x.cutoff_radius_;
     this->parallel_strategy_ = x.parallel_strategy_;
+    this->respa_substeps_ = x.respa_substeps_;
+    this->pair_method_ = x.pair_method_;
   }
 
   return *this;
@@ -5303,7 +5841,8 @@ statistics (const compute_freq_type& compute_freq,
             const n_bins_type& n_bins)
 : ::xml_schema::type (),
   compute_freq_ (compute_freq, this),
-  n_bins_ (n_bins, this)
+  n_bins_ (n_bins, this),
+  file_ (this)
 {
 }
 
@@ -5313,7 +5852,8 @@ statistics (const statistics& x,
             ::xml_schema::container* c)
 : ::xml_schema::type (x, f, c),
   compute_freq_ (x.compute_freq_, f, this),
-  n_bins_ (x.n_bins_, f, this)
+  n_bins_ (x.n_bins_, f, this),
+  file_ (x.file_, f, this)
 {
 }
 
@@ -5323,7 +5863,8 @@ statistics (const ::xercesc::DOMElement& e,
             ::xml_schema::container* c)
 : ::xml_schema::type (e, f | ::xml_schema::flags::base, c),
   compute_freq_ (this),
-  n_bins_ (this)
+  n_bins_ (this),
+  file_ (this)
 {
   if ((f & ::xml_schema::flags::base) == 0)
   {
@@ -5364,6 +5905,20 @@ parse (::xsd::cxx::xml::dom::parser< char >& p,
       }
     }
 
+    // file
+    //
+    if (n.name () == "file" && n.namespace_ ().empty ())
+    {
+      ::std::auto_ptr< file_type > r (
+        file_traits::create (i, f, this));
+
+      if (!this->file_)
+      {
+        this->file_.set (r);
+        continue;
+      }
+    }
+
     break;
   }
 
@@ -5397,6 +5952,7 @@ operator= (const statistics& x)
     static_cast< ::xml_schema::type& > (*this) = x;
     this->compute_freq_ = x.compute_freq_;
     this->n_bins_ = x.n_bins_;
+    this->file_ = x.file_;
   }
 
   return *this;
@@ -5871,6 +6427,25 @@ operator<< (::xml_schema::list_stream& l,
   l << static_cast< const ::xml_schema::string& > (i);
 }
 
+void
+operator<< (::xercesc::DOMElement& e, const PairMethodType& i)
+{
+  e << static_cast< const ::xml_schema::string& > (i);
+}
+
+void
+operator<< (::xercesc::DOMAttr& a, const PairMethodType& i)
+{
+  a << static_cast< const ::xml_schema::string& > (i);
+}
+
+void
+operator<< (::xml_schema::list_stream& l,
+            const PairMethodType& i)
+{
+  l << static_cast< const ::xml_schema::string& > (i);
+}
+
 void
 operator<< (::xercesc::DOMElement& e, const Force& i)
 {
@@ -6160,6 +6735,34 @@ operator<< (::xercesc::DOMElement& e, const Boundary& i)
   }
 }
 
+void
+operator<< (::xercesc::DOMElement& e, const OutputRegion& i)
+{
+  e << static_cast< const ::xml_schema::type& > (i);
+
+  // MarkBoxVec1
+  //
+  {
+    ::xercesc::DOMAttr& a (
+      ::xsd::cxx::xml::dom::create_attribute (
+        "MarkBoxVec1",
+        e));
+
+    a << i.MarkBoxVec1 ();
+  }
+
+  // MarkBoxVec2
+  //
+  {
+    ::xercesc::DOMAttr& a (
+      ::xsd::cxx::xml::dom::create_attribute (
+        "MarkBoxVec2",
+        e));
+
+    a << i.MarkBoxVec2 ();
+  }
+}
+
 void
 simulation_ (::std::ostream& o,
              const ::simulation& s,
@@ -6478,6 +7081,58 @@ operator<< (::xercesc::DOMElement& e, const output& i)
 
     s << i.write_frequency ();
   }
+
+  // region
+  //
+  for (output::region_const_iterator
+       b (i.region ().begin ()), n (i.region ().end ());
+       b != n; ++b)
+  {
+    ::xercesc::DOMElement& s (
+      ::xsd::cxx::xml::dom::create_element (
+        "region",
+        e));
+
+    s << *b;
+  }
+
+  // type
+  //
+  for (output::type_const_iterator
+       b (i.type ().begin ()), n (i.type ().end ());
+       b != n; ++b)
+  {
+    ::xercesc::DOMElement& s (
+      ::xsd::cxx::xml::dom::create_element (
+        "type",
+        e));
+
+    s << *b;
+  }
+
+  // stride
+  //
+  if (i.stride ())
+  {
+    ::xercesc::DOMElement& s (
+      ::xsd::cxx::xml::dom::create_element (
+        "stride",
+        e));
+
+    s << *i.stride ();
+  }
+
+  // fields
+  //
+  if (i.fields ())
+  {
+    ::xercesc::DOMElement& s (
+      ::xsd::cxx::xml::dom::create_element (
+        "fields",
+        e));
+
+    s << *i.fields ();
+  }
 }
 
 void
@@ -6528,6 +7183,30 @@ operator<< (::xercesc::DOMElement& e, const parameters& i)
 
     s << i.parallel_strategy ();
   }
+
+  // respa_substeps
+  //
+  if (i.respa_substeps ())
+  {
+    ::xercesc::DOMElement& s (
+      ::xsd::cxx::xml::dom::create_element (
+        "respa_substeps",
+        e));
+
+    s << *i.respa_substeps ();
+  }
+
+  // pair_method
+  //
+  if (i.pair_method ())
+  {
+    ::xercesc::DOMElement& s (
+      ::xsd::cxx::xml::dom::create_element (
+        "pair_method",
+        e));
+
+    s << *i.pair_method ();
+  }
 }
 
 void
@@ -7010,6 +7689,18 @@ operator<< (::xercesc::DOMElement& e, const statistics& i)
 
     s << i.n_bins ();
   }
+
+  // file
+  //
+  if (i.file ())
+  {
+    ::xercesc::DOMElement& s (
+      ::xsd::cxx::xml::dom::create_element (
+        "file",
+        e));
+
+    s << *i.file ();
+  }
 }
 
 #include <xsd/cxx/post.hxx>
@@ -258,9 +258,11 @@ class ConstantForceType;
 class BoundaryType;
 class ParticleStateType;
 class ParallelType;
+class PairMethodType;
 class Force;
 class ConstantForce;
 class Boundary;
+class OutputRegion;
 class simulation;
 class output;
 class parameters;
@@ -692,7 +694,8 @@ class ParallelType: public ::xml_schema::string
   {
     NONE,
     CELL_LOCK,
-    SPATIAL_DECOMPOSITION
+    SPATIAL_DECOMPOSITION,
+    NEWTON3_OFF
   };
 
   ParallelType (value v);
@@ -738,8 +741,65 @@ class ParallelType: public ::xml_schema::string
   _xsd_ParallelType_convert () const;
 
   public:
-  static const char* const _xsd_ParallelType_literals_[3];
-  static const value _xsd_ParallelType_indexes_[3];
+  static const char* const _xsd_ParallelType_literals_[4];
+  static const value _xsd_ParallelType_indexes_[4];
+};
+
+class PairMethodType: public ::xml_schema::string
+{
+  public:
+  enum value
+  {
+    AUTO,
+    LINKED_CELLS,
+    DIRECT_SUM
+  };
+
+  PairMethodType (value v);
+
+  PairMethodType (const char* v);
+
+  PairMethodType (const ::std::string& v);
+
+  PairMethodType (const ::xml_schema::string& v);
+
+  PairMethodType (const ::xercesc::DOMElement& e,
+                  ::xml_schema::flags f = 0,
+                  ::xml_schema::container* c = 0);
+
+  PairMethodType (const ::xercesc::DOMAttr& a,
+                  ::xml_schema::flags f = 0,
+                  ::xml_schema::container* c = 0);
+
+  PairMethodType (const ::std::string& s,
+                  const ::xercesc::DOMElement* e,
+                  ::xml_schema::flags f = 0,
+                  ::xml_schema::container* c = 0);
+
+  PairMethodType (const PairMethodType& x,
+                  ::xml_schema::flags f = 0,
+                  ::xml_schema::container* c = 0);
+
+  virtual PairMethodType*
+  _clone (::xml_schema::flags f = 0,
+          ::xml_schema::container* c = 0) const;
+
+  PairMethodType&
+  operator= (value v);
+
+  virtual
+  operator value () const
+  {
+    return _xsd_PairMethodType_convert ();
+  }
+
+  protected:
+  value
+  _xsd_PairMethodType_convert () const;
+
+  public:
+  static const char* const _xsd_PairMethodType_literals_[3];
+  static const value _xsd_PairMethodType_indexes_[3];
 };
 
 class Force: public ::xml_schema::type
@@ -1297,6 +1357,78 @@ class Boundary: public ::xml_schema::type
   force_arg2_optional force_arg2_;
 };
 
+class OutputRegion: public ::xml_schema::type
+{
+  public:
+  // MarkBoxVec1
+  //
+  typedef ::Vec3Type MarkBoxVec1_type;
+  typedef ::xsd::cxx::tree::traits< MarkBoxVec1_type, char > MarkBoxVec1_traits;
+
+  const MarkBoxVec1_type&
+  MarkBoxVec1 () const;
+
+  MarkBoxVec1_type&
+  MarkBoxVec1 ();
+
+  void
+  MarkBoxVec1 (const MarkBoxVec1_type& x);
+
+  void
+  MarkBoxVec1 (::std::auto_ptr< MarkBoxVec1_type > p);
+
+  // MarkBoxVec2
+  //
+  typedef ::Vec3Type MarkBoxVec2_type;
+  typedef ::xsd::cxx::tree::traits< MarkBoxVec2_type, char > MarkBoxVec2_traits;
+
+  const MarkBoxVec2_type&
+  MarkBoxVec2 () const;
+
+  MarkBoxVec2_type&
+  MarkBoxVec2 ();
+
+  void
+  MarkBoxVec2 (const MarkBoxVec2_type& x);
+
+  void
+  MarkBoxVec2 (::std::auto_ptr< MarkBoxVec2_type > p);
+
+  // Constructors.
+  //
+  OutputRegion (const MarkBoxVec1_type&,
+                const MarkBoxVec2_type&);
+
+  OutputRegion (const ::xercesc::DOMElement& e,
+                ::xml_schema::flags f = 0,
+                ::xml_schema::container* c = 0);
+
+  OutputRegion (const OutputRegion& x,
+                ::xml_schema::flags f = 0,
+                ::xml_schema::container* c = 0);
+
+  virtual OutputRegion*
+  _clone (::xml_schema::flags f = 0,
+          ::xml_schema::container* c = 0) const;
+
+  OutputRegion&
+  operator= (const OutputRegion& x);
+
+  virtual 
+  ~OutputRegion ();
+
+  // Implementation.
+  //
+  protected:
+  void
+  parse (::xsd::cxx::xml::dom::parser< char >&,
+         ::xml_schema::flags);
+
+  protected:
+  ::xsd::cxx::tree::one< MarkBoxVec1_type > MarkBoxVec1_;
+  ::xsd::cxx::tree::one< MarkBoxVec2_type > MarkBoxVec2_;
+};
+
 class simulation: public ::xml_schema::type
 {
   public:
@@ -1580,6 +1712,79 @@ class output: public ::xml_schema::type
   void
   write_frequency (const write_frequency_type& x);
 
+  // region
+  //
+  typedef ::OutputRegion region_type;
+  typedef ::xsd::cxx::tree::sequence< region_type > region_sequence;
+  typedef region_sequence::iterator region_iterator;
+  typedef region_sequence::const_iterator region_const_iterator;
+  typedef ::xsd::cxx::tree::traits< region_type, char > region_traits;
+
+  const region_sequence&
+  region () const;
+
+  region_sequence&
+  region ();
+
+  void
+  region (const region_sequence& s);
+
+  // type
+  //
+  typedef ::xml_schema::int_ type_type;
+  typedef ::xsd::cxx::tree::sequence< type_type > type_sequence;
+  typedef type_sequence::iterator type_iterator;
+  typedef type_sequence::const_iterator type_const_iterator;
+  typedef ::xsd::cxx::tree::traits< type_type, char > type_traits;
+
+  const type_sequence&
+  type () const;
+
+  type_sequence&
+  type ();
+
+  void
+  type (const type_sequence& s);
+
+  // stride
+  //
+  typedef ::xml_schema::int_ stride_type;
+  typedef ::xsd::cxx::tree::optional< stride_type > stride_optional;
+  typedef ::xsd::cxx::tree::traits< stride_type, char > stride_traits;
+
+  const stride_optional&
+  stride () const;
+
+  stride_optional&
+  stride ();
+
+  void
+  stride (const stride_type& x);
+
+  void
+  stride (const stride_optional& x);
+
+  // fields
+  //
+  typedef ::xml_schema::string fields_type;
+  typedef ::xsd::cxx::tree::optional< fields_type > fields_optional;
+  typedef ::xsd::cxx::tree::traits< fields_type, char > fields_traits;
+
+  const fields_optional&
+  fields () const;
+
+  fields_optional&
+  fields ();
+
+  void
+  fields (const fields_type& x);
+
+  void
+  fields (const fields_optional& x);
+
+  void
+  fields (::std::auto_ptr< fields_type > p);
+
   // Constructors.
   //
   output (const base_name_type&,
@@ -1613,6 +1818,10 @@ class output: public ::xml_schema::type
   protected:
   ::xsd::cxx::tree::one< base_name_type > base_name_;
   ::xsd::cxx::tree::one< write_frequency_type > write_frequency_;
+  region_sequence region_;
+  type_sequence type_;
+  stride_optional stride_;
+  fields_optional fields_;
 };
 
 class parameters: public ::xml_schema::type
@@ -1677,6 +1886,45 @@ class parameters: public ::xml_schema::type
   void
   parallel_strategy (::std::auto_ptr< parallel_strategy_type > p);
 
+  // respa_substeps
+  //
+  typedef ::xml_schema::int_ respa_substeps_type;
+  typedef ::xsd::cxx::tree::optional< respa_substeps_type > respa_substeps_optional;
+  typedef ::xsd::cxx::tree::traits< respa_substeps_type, char > respa_substeps_traits;
+
+  const respa_substeps_optional&
+  respa_substeps () const;
+
+  respa_substeps_optional&
+  respa_substeps ();
+
+  void
+  respa_substeps (const respa_substeps_type& x);
+
+  void
+  respa_substeps (const respa_substeps_optional& x);
+
+  // pair_method
+  //
+  typedef ::PairMethodType pair_method_type;
+  typedef ::xsd::cxx::tree::optional< pair_method_type > pair_method_optional;
+  typedef ::xsd::cxx::tree::traits< pair_method_type, char > pair_method_traits;
+
+  const pair_method_optional&
+  pair_method () const;
+
+  pair_method_optional&
+  pair_method ();
+
+  void
+  pair_method (const pair_method_type& x);
+
+  void
+  pair_method (const pair_method_optional& x);
+
+  void
+  pair_method (::std::auto_ptr< pair_method_type > p);
+
   // Constructors.
   //
   parameters (const end_t_type&,
@@ -1714,6 +1962,8 @@ class parameters: public ::xml_schema::type
   ::xsd::cxx::tree::one< delta_t_type > delta_t_;
   ::xsd::cxx::tree::one< cutoff_radius_type > cutoff_radius_;
   ::xsd::cxx::tree::one< parallel_strategy_type > parallel_strategy_;
+  respa_substeps_optional respa_substeps_;
+  pair_method_optional pair_method_;
 };
 
 class Forces: public ::xml_schema::type
@@ -2669,6 +2919,27 @@ class statistics: public ::xml_schema::type
   void
   n_bins (const n_bins_type& x);
 
+  // file
+  //
+  typedef ::xml_schema::string file_type;
+  typedef ::xsd::cxx::tree::optional< file_type > file_optional;
+  typedef ::xsd::cxx::tree::traits< file_type, char > file_traits;
+
+  const file_optional&
+  file () const;
+
+  file_optional&
+  file ();
+
+  void
+  file (const file_type& x);
+
+  void
+  file (const file_optional& x);
+
+  void
+  file (::std::auto_ptr< file_type > p);
+
   // Constructors.
   //
   statistics (const compute_freq_type&,
@@ -2702,6 +2973,7 @@ class statistics: public ::xml_schema::type
   protected:
   ::xsd::cxx::tree::one< compute_freq_type > compute_freq_;
   ::xsd::cxx::tree::one< n_bins_type > n_bins_;
+  file_optional file_;
 };
 
 #include <iosfwd>
@@ -2911,6 +3183,16 @@ void
 operator<< (::xml_schema::list_stream&,
             const ParallelType&);
 
+void
+operator<< (::xercesc::DOMElement&, const PairMethodType&);
+
+void
+operator<< (::xercesc::DOMAttr&, const PairMethodType&);
+
+void
+operator<< (::xml_schema::list_stream&,
+            const PairMethodType&);
+
 void
 operator<< (::xercesc::DOMElement&, const Force&);
 
@@ -2920,6 +3202,9 @@ operator<< (::xercesc::DOMElement&, const ConstantForce&);
 void
 operator<< (::xercesc::DOMElement&, const Boundary&);
 
+void
+operator<< (::xercesc::DOMElement&, const OutputRegion&);
+
 // Serialize to std::ostream.
 //
 
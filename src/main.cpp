@@ -1,4 +1,5 @@
 #include "core/IntegratorFactory.h"
+#include "core/LocalityComparison.h"
 #include "io/IOStrategy.h"
 #include "utils/Parse.h"
 #include "io/Logger/Logger.h"
@@ -16,13 +17,39 @@ int main(const int argc, char* argv[]) {
             exit(-1);
         default:;
     };
-    
+
+    if (args.scaling) {
+        return core::run_scaling_sweep(*args.scaling).empty() ? -1 : 0;
+    }
+    if (args.suite) {
+        return core::run_suite(*args.suite) == 0 ? 0 : -1;
+    }
+
     auto simulator = md::Integrator::create_simulator(args);
+    if (args.load_report_freq > 0) {
+        simulator->monitor_load(args.load_report_freq);
+    }
+    if (args.compact_freq > 0) {
+        simulator->compact_storage(args.compact_freq, args.compact_cell_order);
+    }
+    if (!args.live_metrics.empty()) {
+        if (simulator->enable_live_metrics(args.live_metrics)) {
+            SPDLOG_INFO("Publishing live metrics in shared memory segment {}", args.live_metrics);
+        } else {
+            SPDLOG_WARN("Could not create shared memory segment {}, continuing without live metrics",
+                        args.live_metrics);
+        }
+    }
 
     if (!args.benchmark) {
         simulator->simulate(0, args.duration, args.dt, args.write_freq, args.temp_adj_freq);
     } else {
-        simulator->benchmark(0, args.duration, args.dt);
+        simulator->benchmark(0, args.duration, args.dt, args.temp_adj_freq, args.benchmark_warmup,
+                             args.benchmark_report, args.benchmark_counters);
+        if (args.cell_order != env::CellOrder::LINEAR) {
+            core::compare_cell_orders({args.input_file, args.cell_order, args.benchmark_warmup, args.compact_freq,
+                                       args.compact_cell_order, args.stream_input});
+        }
     }
     return 0;
 }
@@ -1,4 +1,6 @@
 #pragma once
+#include <cstddef>
+#include <functional>
 #include <vector>
 
 namespace md::utils {
@@ -129,4 +131,59 @@ namespace md::utils {
         Container& inner_container;
         Container& outer_container;
     };
+
+    /**
+     * @brief Unordered list of indices with O(1) insertion, removal, membership test and size.
+     *
+     * Removing an index moves the last index into its place, so the order of the indices changes and the list must not
+     * be modified while it is iterated.
+     */
+    class IndexList {
+       public:
+        /**
+         * @brief Adds an index, does nothing if it is already contained.
+         * @param index The index.
+         */
+        void insert(const size_t index) {
+            if (contains(index)) return;
+            if (index >= slots.size()) slots.resize(index + 1, NONE);
+            slots[index] = items.size();
+            items.push_back(index);
+        }
+
+        /**
+         * @brief Removes an index, does nothing if it is not contained.
+         * @param index The index.
+         */
+        void erase(const size_t index) {
+            if (!contains(index)) return;
+            const size_t slot = slots[index];
+            items[slot] = items.back();
+            slots[items[slot]] = slot;
+            items.pop_back();
+            slots[index] = NONE;
+        }
+
+        [[nodiscard]] bool contains(const size_t index) const { return index < slots.size() && slots[index] != NONE; }
+        [[nodiscard]] size_t size() const { return items.size(); }
+        [[nodiscard]] bool empty() const { return items.empty(); }
+        [[nodiscard]] const std::vector<size_t>& indices() const { return items; }
+        [[nodiscard]] std::vector<size_t>::const_iterator begin() const { return items.begin(); }
+        [[nodiscard]] std::vector<size_t>::const_iterator end() const { return items.end(); }
+
+        void clear() {
+            items.clear();
+            slots.clear();
+        }
+
+        /**
+         * @brief Returns the bytes allocated by the list.
+         */
+        [[nodiscard]] size_t bytes() const { return (items.capacity() + slots.capacity()) * sizeof(size_t); }
+
+       private:
+        static constexpr size_t NONE = static_cast<size_t>(-1);  ///< Slot of an index that is not contained.
+        std::vector<size_t> items;  ///< The indices.
+        std::vector<size_t> slots;  ///< Position of each index in items, NONE if not contained.
+    };
 }  // namespace md::utils
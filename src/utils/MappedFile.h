@@ -0,0 +1,76 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+#include <string_view>
+
+namespace md::utils {
+
+    /**
+     * @brief Read-only memory mapping of a whole file.
+     *
+     * The mapping is released when the object goes out of scope. Empty files are valid and yield an empty view.
+     */
+    class MappedFile {
+       public:
+        /**
+         * @brief Maps the file with the given name into memory.
+         * @param file_name The name of the file to map.
+         */
+        explicit MappedFile(const std::string& file_name) {
+            const int fd = ::open(file_name.c_str(), O_RDONLY);
+            if (fd < 0) return;
+
+            struct stat st {};
+            if (::fstat(fd, &st) == 0) {
+                opened = true;
+                length = static_cast<size_t>(st.st_size);
+                if (length > 0) {
+                    void* ptr = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (ptr == MAP_FAILED) {
+                        opened = false;
+                        length = 0;
+                    } else {
+                        mapping = static_cast<const char*>(ptr);
+                        ::madvise(ptr, length, MADV_SEQUENTIAL);
+                    }
+                }
+            }
+            ::close(fd);
+        }
+
+        ~MappedFile() {
+            if (mapping) ::munmap(const_cast<char*>(mapping), length);
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief Checks if the file was opened and mapped successfully.
+         * @return "true" if the file is accessible, "false" otherwise.
+         */
+        [[nodiscard]] bool is_open() const { return opened; }
+
+        /**
+         * @brief Returns the mapped file content.
+         * @return A view of the whole file.
+         */
+        [[nodiscard]] std::string_view view() const { return {mapping, length}; }
+
+        /**
+         * @brief Returns the size of the mapped file.
+         * @return The size in bytes.
+         */
+        [[nodiscard]] size_t size() const { return length; }
+
+       private:
+        const char* mapping = nullptr;  ///< Start of the mapping.
+        size_t length = 0;              ///< Length of the mapping in bytes.
+        bool opened = false;            ///< Indicates whether the file could be opened.
+    };
+}  // namespace md::utils
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "io/Logger/Logger.h"
+
+namespace md::utils {
+
+    /**
+     * @brief Bytes allocated by a std::vector, including unused capacity.
+     * @param vector The vector.
+     * @return The number of bytes.
+     */
+    template <typename Vector>
+    size_t vector_bytes(const Vector& vector) {
+        return vector.capacity() * sizeof(typename Vector::value_type);
+    }
+
+    /**
+     * @brief Bytes allocated by an ankerl::unordered_dense map or set (value vector and bucket array).
+     * @param hash The map or set.
+     * @return The number of bytes.
+     */
+    template <typename DenseHash>
+    size_t dense_hash_bytes(const DenseHash& hash) {
+        return vector_bytes(hash.values()) + hash.bucket_count() * sizeof(typename DenseHash::bucket_type);
+    }
+
+    /**
+     * @brief Estimated bytes allocated by a node based std::unordered_map or set (one node per element with the value
+     * and the next pointer plus the cached hash, and one pointer per bucket).
+     * @param hash The map or set.
+     * @return The number of bytes.
+     */
+    template <typename NodeHash>
+    size_t node_hash_bytes(const NodeHash& hash) {
+        return hash.size() * (sizeof(typename NodeHash::value_type) + 2 * sizeof(void*)) +
+               hash.bucket_count() * sizeof(void*);
+    }
+
+    /**
+     * @brief Returns the peak resident set size of the process in bytes, 0 if unknown.
+     */
+    inline size_t peak_rss() {
+        rusage usage{};
+        if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+        return static_cast<size_t>(usage.ru_maxrss) * 1024;  // kilobytes on Linux
+    }
+
+    /**
+     * @brief Returns the current resident set size of the process in bytes, 0 if unknown.
+     */
+    inline size_t current_rss() {
+        FILE* file = std::fopen("/proc/self/statm", "r");
+        if (!file) return 0;
+        long pages = 0;
+        long resident = 0;
+        const int read = std::fscanf(file, "%ld %ld", &pages, &resident);
+        std::fclose(file);
+        return read == 2 ? static_cast<size_t>(resident) * static_cast<size_t>(sysconf(_SC_PAGESIZE)) : 0;
+    }
+
+    /**
+     * @brief Formats a number of bytes with a binary unit, e.g. "1.50 MiB".
+     * @param bytes The number of bytes.
+     * @return The formatted string.
+     */
+    inline std::string format_bytes(const size_t bytes) {
+        constexpr const char* units[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+        auto value = static_cast<double>(bytes);
+        size_t unit = 0;
+        while (value >= 1024 && unit + 1 < std::size(units)) {
+            value /= 1024;
+            unit++;
+        }
+        return unit == 0 ? fmt::format("{} B", bytes) : fmt::format("{:.2f} {}", value, units[unit]);
+    }
+
+    /**
+     * @brief Bytes allocated by the subsystems of the simulation.
+     */
+    struct MemoryUsage {
+        std::vector<std::pair<std::string, size_t>> subsystems;  ///< Name and bytes of each subsystem.
+
+        /**
+         * @brief Adds the bytes of a subsystem.
+         * @param name The name of the subsystem.
+         * @param bytes The number of bytes.
+         */
+        void add(std::string name, const size_t bytes) { subsystems.emplace_back(std::move(name), bytes); }
+
+        /**
+         * @brief Returns the bytes of all subsystems.
+         */
+        [[nodiscard]] size_t total() const {
+            return std::accumulate(subsystems.begin(), subsystems.end(), size_t{0},
+                                   [](const size_t sum, const auto& subsystem) { return sum + subsystem.second; });
+        }
+
+        /**
+         * @brief Creates a table of the subsystems with bytes per particle, followed by the resident set size.
+         * @param particles The number of particles.
+         * @return The table.
+         */
+        [[nodiscard]] std::string to_string(const size_t particles) const {
+            auto per_particle = [&](const size_t bytes) {
+                return particles > 0 ? static_cast<double>(bytes) / static_cast<double>(particles) : 0.0;
+            };
+
+            std::string result;
+            for (const auto& [name, bytes] : subsystems) {
+                result += fmt::format("       {:<22} {:>12}  {:>10.1f} B/particle\n", name, format_bytes(bytes),
+                                      per_particle(bytes));
+            }
+            const size_t rss = current_rss();
+            result += fmt::format("       {:<22} {:>12}  {:>10.1f} B/particle\n", "total", format_bytes(total()),
+                                  per_particle(total()));
+            result += fmt::format("       {:<22} {:>12} (untracked: {})\n", "resident set size", format_bytes(rss),
+                                  format_bytes(rss > total() ? rss - total() : 0));
+            result += fmt::format("       {:<22} {:>12}", "peak resident set size", format_bytes(peak_rss()));
+            return result;
+        }
+    };
+}  // namespace md::utils
@@ -1,8 +1,10 @@
 #include <algorithm>
 #include <string>
+#include <unistd.h>
 #include <vector>
 
 #include "Parse.h"
+#include "core/LiveMetrics.h"
 #include "io/IOStrategy.h"
 
 #define RETURN_PARSE_ERROR(err_msg)                                                \
@@ -19,13 +21,194 @@ namespace md::parse {
             "  ./MolSim -h | --help\n"
             "Arguments:\n"
             "  input_file       XML or TXT file with input parameters important for the simulation.\n"
-            "  output_format    Output format: either 'XYZ' or 'VTK'.\n\n"
+            "  output_format    Output format: 'XYZ', 'XYZ_MULTI' (all frames in one file), 'VTK' or 'TRJ'\n"
+            "                   (compressed trajectory).\n\n"
             "Flags:\n"
             "  -h, --help       Show this help message and exit.\n"
             "  -f               Delete all contents of the output folder before writing.\n"
-            "  -b               Benchmark the simulation (output_format and output_folder optional).");
+            "  -b               Benchmark the simulation (output_format and output_folder optional).\n"
+            "  -s               Stream XML input instead of building the whole document tree (for large inputs).\n"
+            "  -v               Validate XML input against the simulation schema.\n"
+            "  --warmup=<n>     Exclude the first n steps from the benchmark measurement (default: 0).\n"
+            "  --report=<path>  Write the benchmark report to <path>.json and <path>.csv.\n"
+            "  --perf           Read hardware performance counters per phase and thread during the benchmark.\n"
+            "  --imbalance=<n>  Measure busy, lock wait and barrier wait time per thread in the parallel force\n"
+            "                   computation and log the load imbalance every n steps.\n"
+            "  --live[=<name>]  Publish live metrics in the shared memory segment <name> (default:\n"
+            "                   " LIVE_METRICS_PREFIX "<pid>), watch them with ./MolSimMonitor.\n"
+            "  --compact=<n>    Remove dead particles from the particle storage every n steps.\n"
+            "  --cell-order     Repack the particle storage in the order of the grid cells when compacting.\n"
+            "  --curve=<name>   Order the grid cells, cell pairs and particles along a space filling curve:\n"
+            "                   'morton' or 'hilbert' (default: linear). In benchmark mode, the scenario is run\n"
+            "                   again with the linear and the chosen order to report the change of the cache misses.\n"
+            "  --pair-method=<name>\n"
+            "                   Compute the pair forces by the 'linked' cells or the 'direct' sum of all pairs, replaces\n"
+            "                   the pair_method of the input file (default: 'auto', the direct sum for few cells).\n\n"
+            "Scaling sweep (output_format optional):\n"
+            "  --scaling=<mode>       Sweep thread counts and strategies, mode is 'strong' or 'weak' (the scenario is\n"
+            "                         replicated along x proportionally to the thread count).\n"
+            "  --threads=<list>       Comma separated thread counts, the first one is the baseline (default: 1).\n"
+            "  --strategies=<list>    Comma separated strategies: 'none', 'cell_lock', 'spatial_decomposition',\n"
+            "                         'newton3_off' (default: none).\n"
+            "  --repeat=<n>           Number of runs per point (default: 5).\n"
+            "  --report=<path>        Write the results table to <path>.csv (default: scaling).\n\n"
+            "Performance suite (no input file):\n"
+            "  --suite                Run the scenario corpus and compare MUPS/s and phase times with the baselines of\n"
+            "                         this machine, exits with an error if a metric regressed.\n"
+            "  --scenarios=<list>     Comma separated scenarios: 'lj_fluid_3d', 'gas_2d', 'nanoflow', 'membrane',\n"
+            "                         'rayleigh_taylor' (default: all).\n"
+            "  --sizes=<list>         Comma separated sizes: 'S', 'M', 'L' (default: all).\n"
+            "  --strategy=<name>      Parallelization strategy as for --strategies (default: none).\n"
+            "  --threads=<n>          Number of threads (default: OpenMP default).\n"
+            "  --repeat=<n>           Number of runs per scenario, the medians are compared (default: 3).\n"
+            "  --baseline=<path>      Baseline file (default: " SUITE_BASELINE_DIR "/<host name>.csv).\n"
+            "  --threshold=<percent>  Allowed slowdown of a metric before it counts as regression (default: 10).\n"
+            "  --record               Store the results as baselines instead of comparing them.\n"
+            "  --report=<path>        Write the results to <path>.csv (default: suite).");
     }
 
+    namespace {
+        /**
+         * @brief Splits a comma separated list.
+         * @param list The list.
+         * @return The elements of the list.
+         */
+        std::vector<std::string> split_list(const std::string& list) {
+            std::vector<std::string> elements;
+            size_t start = 0;
+            while (start <= list.size()) {
+                const size_t end = std::min(list.find(',', start), list.size());
+                elements.push_back(list.substr(start, end - start));
+                start = end + 1;
+            }
+            return elements;
+        }
+
+        /**
+         * @brief Parses the name of a parallelization strategy.
+         * @param name 'none', 'cell_lock', 'spatial_decomposition' or 'newton3_off'.
+         * @return The strategy, -1 if the name is invalid.
+         */
+        int parse_strategy(const std::string& name) {
+            if (name == "none") return 0;
+            if (name == "cell_lock") return 1;
+            if (name == "spatial_decomposition") return 2;
+            if (name == "newton3_off") return 3;
+            return -1;
+        }
+
+        /**
+         * @brief Parses the flags of a scaling sweep.
+         * @param mode Value of the --scaling flag.
+         * @param input_file The input file.
+         * @param flag_value Returns the value of a flag, empty if not given.
+         * @param args The ProgramArguments, the sweep configuration is stored in args.scaling.
+         * @return The parse status.
+         */
+        template <typename FlagValue>
+        ParseStatus parse_scaling(const std::string& mode, const std::string& input_file, FlagValue flag_value,
+                                  io::ProgramArguments& args) {
+            core::ScalingOptions options;
+            options.input_file = input_file;
+            options.stream_input = args.stream_input;
+
+            if (mode == "strong") {
+                options.mode = core::ScalingOptions::STRONG;
+            } else if (mode == "weak") {
+                options.mode = core::ScalingOptions::WEAK;
+            } else {
+                RETURN_PARSE_ERROR(fmt::format("Invalid scaling mode: {}", mode));
+            }
+
+            try {
+                if (const std::string threads = flag_value("--threads"); !threads.empty()) {
+                    options.threads.clear();
+                    for (const auto& element : split_list(threads)) {
+                        const int count = std::stoi(element);
+                        if (count <= 0) throw std::invalid_argument("non-positive thread count");
+                        options.threads.push_back(count);
+                    }
+                }
+                if (const std::string repeat = flag_value("--repeat"); !repeat.empty()) {
+                    options.repetitions = std::stoul(repeat);
+                }
+            } catch (const std::exception&) {
+                RETURN_PARSE_ERROR(fmt::format("Invalid thread counts or repetitions: {} {}", flag_value("--threads"),
+                                               flag_value("--repeat")));
+            }
+
+            if (const std::string strategies = flag_value("--strategies"); !strategies.empty()) {
+                options.strategies.clear();
+                for (const auto& element : split_list(strategies)) {
+                    const int strategy = parse_strategy(element);
+                    if (strategy < 0) {
+                        RETURN_PARSE_ERROR(fmt::format("Invalid parallelization strategy: {}", element));
+                    }
+                    options.strategies.push_back(strategy);
+                }
+            }
+
+            if (const std::string report = flag_value("--report"); !report.empty()) {
+                options.report = report;
+            }
+
+            args.scaling = std::move(options);
+            return OK;
+        }
+
+        /**
+         * @brief Parses the flags of the performance suite.
+         * @param flag_exists Returns whether a flag is given.
+         * @param flag_value Returns the value of a flag, empty if not given.
+         * @param args The ProgramArguments, the suite configuration is stored in args.suite.
+         * @return The parse status.
+         */
+        template <typename FlagExists, typename FlagValue>
+        ParseStatus parse_suite(FlagExists flag_exists, FlagValue flag_value, io::ProgramArguments& args) {
+            core::SuiteOptions options;
+            options.record = flag_exists("--record");
+            options.baseline = flag_value("--baseline");
+
+            if (const std::string scenarios = flag_value("--scenarios"); !scenarios.empty()) {
+                options.scenarios = split_list(scenarios);
+            }
+            if (const std::string sizes = flag_value("--sizes"); !sizes.empty()) {
+                options.sizes = split_list(sizes);
+            }
+            if (const std::string strategy = flag_value("--strategy"); !strategy.empty()) {
+                options.strategy = parse_strategy(strategy);
+                if (options.strategy < 0) {
+                    RETURN_PARSE_ERROR(fmt::format("Invalid parallelization strategy: {}", strategy));
+                }
+            }
+
+            try {
+                if (const std::string threads = flag_value("--threads"); !threads.empty()) {
+                    options.threads = std::stoi(threads);
+                    if (options.threads <= 0) throw std::invalid_argument("non-positive thread count");
+                }
+                if (const std::string repeat = flag_value("--repeat"); !repeat.empty()) {
+                    options.repetitions = std::stoul(repeat);
+                }
+                if (const std::string threshold = flag_value("--threshold"); !threshold.empty()) {
+                    options.threshold = std::stod(threshold) / 100;
+                    if (options.threshold < 0) throw std::invalid_argument("negative threshold");
+                }
+            } catch (const std::exception&) {
+                RETURN_PARSE_ERROR(fmt::format("Invalid thread count, repetitions or threshold: {} {} {}",
+                                               flag_value("--threads"), flag_value("--repeat"),
+                                               flag_value("--threshold")));
+            }
+
+            if (const std::string report = flag_value("--report"); !report.empty()) {
+                options.report = report;
+            }
+
+            args.suite = std::move(options);
+            return OK;
+        }
+    }  // namespace
+
     ParseStatus parse_args(int argc, char** argv, io::ProgramArguments& args) {
         SPDLOG_INFO("Start parsing arguments.");
         std::vector<std::string> arguments(argv, argv + argc);
@@ -41,12 +224,23 @@ namespace md::parse {
             return std::find(flags.begin(), flags.end(), option) != flags.end();
         };
 
+        auto flag_value = [&](const std::string& option) -> std::string {
+            const auto it = std::find_if(flags.begin(), flags.end(),
+                                         [&](const std::string& flag) { return flag.starts_with(option + "="); });
+            return it == flags.end() ? "" : it->substr(option.size() + 1);
+        };
+
         // Check for help flag
         if (flag_exists("-h") || flag_exists("--help")) {
             displayHelp();
             return EXIT;
         }
 
+        // the performance suite builds its own scenarios and needs no input file
+        if (flag_exists("--suite")) {
+            return parse_suite(flag_exists, flag_value, args);
+        }
+
         // check number of arguments
         // if -b set, expecting at least 2 arguments (filename, xml file)
         // else expecting 3 arguments (filename, xml file, output_format)
@@ -55,20 +249,90 @@ namespace md::parse {
                 fmt::format("Not enough arguments provided. Received {} arguments", parameters.size()));
         }
 
+        args.stream_input = flag_exists("-s");
+        args.validate_input = flag_exists("-v");
+
+        if (const std::string mode = flag_value("--scaling"); !mode.empty()) {
+            return parse_scaling(mode, parameters[1], flag_value, args);
+        }
+
+        if (const std::string curve = flag_value("--curve"); !curve.empty()) {
+            if (curve == "morton") {
+                args.cell_order = env::CellOrder::MORTON;
+            } else if (curve == "hilbert") {
+                args.cell_order = env::CellOrder::HILBERT;
+            } else if (curve != "linear") {
+                RETURN_PARSE_ERROR(fmt::format("Invalid space filling curve: {}", curve));
+            }
+        }
+
+        const std::string pair_method = flag_value("--pair-method");
+        if (!pair_method.empty() && pair_method != "auto" && pair_method != "linked" && pair_method != "direct") {
+            RETURN_PARSE_ERROR(fmt::format("Invalid pair force method: {}", pair_method));
+        }
+
+        args.input_file = arguments[1];
         io::read_file(arguments[1], args);
 
+        if (pair_method == "auto") {
+            args.pair_method = env::PairMethod::AUTO;
+        } else if (pair_method == "linked") {
+            args.pair_method = env::PairMethod::LINKED_CELLS;
+        } else if (pair_method == "direct") {
+            args.pair_method = env::PairMethod::DIRECT_SUM;
+        }
+
         args.benchmark = flag_exists("-b");
         args.override = flag_exists("-f");
 
+        if (const std::string freq = flag_value("--imbalance"); !freq.empty()) {
+            try {
+                args.load_report_freq = std::stoul(freq);
+            } catch (const std::exception&) {
+                RETURN_PARSE_ERROR(fmt::format("Invalid load imbalance report frequency: {}", freq));
+            }
+        }
+
+        if (flag_exists("--live")) {
+            args.live_metrics = core::live_metrics_name(getpid());
+        } else if (const std::string name = flag_value("--live"); !name.empty()) {
+            args.live_metrics = name.starts_with('/') ? name : "/" + name;
+        }
+
+        if (const std::string freq = flag_value("--compact"); !freq.empty()) {
+            try {
+                args.compact_freq = std::stoul(freq);
+            } catch (const std::exception&) {
+                RETURN_PARSE_ERROR(fmt::format("Invalid compaction frequency: {}", freq));
+            }
+        }
+        args.compact_cell_order = flag_exists("--cell-order");
+
         if (args.benchmark) {
+            args.benchmark_report = flag_value("--report");
+            args.benchmark_counters = flag_exists("--perf");
+            if (const std::string warmup = flag_value("--warmup"); !warmup.empty()) {
+                try {
+                    args.benchmark_warmup = std::stoul(warmup);
+                } catch (const std::exception&) {
+                    RETURN_PARSE_ERROR(fmt::format("Invalid number of warm-up steps: {}", warmup));
+                }
+            }
             args.output_format = io::OutputFormat::XYZ;
             return OK;
         }
 
-        if (parameters[2] != "XYZ" && parameters[2] != "VTK") {
+        if (parameters[2] == "XYZ") {
+            args.output_format = io::OutputFormat::XYZ;
+        } else if (parameters[2] == "XYZ_MULTI") {
+            args.output_format = io::OutputFormat::XYZ_MULTI;
+        } else if (parameters[2] == "VTK") {
+            args.output_format = io::OutputFormat::VTK;
+        } else if (parameters[2] == "TRJ") {
+            args.output_format = io::OutputFormat::TRJ;
+        } else {
             RETURN_PARSE_ERROR(fmt::format("Invalid file output format: {}", parameters[2]));
         }
-        args.output_format = parameters[2] == "XYZ" ? io::OutputFormat::XYZ : io::OutputFormat::VTK;
 
         SPDLOG_INFO("Arguments successfully parsed.");
         io::log_arguments(args);
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/**
+ * @brief Keys of grid indices along space filling curves. Sorting cells by their key places cells that are close in
+ * space close in the order, which keeps neighboring cells and their particles close in memory.
+ */
+namespace md::utils {
+    namespace curve_impl {
+        /**
+         * @brief Spreads the lower 21 bits of a value so that two zero bits follow each bit.
+         */
+        constexpr uint64_t spread_bits(uint64_t x) {
+            x &= 0x1fffff;
+            x = (x | x << 32) & 0x1f00000000ffff;
+            x = (x | x << 16) & 0x1f0000ff0000ff;
+            x = (x | x << 8) & 0x100f00f00f00f00f;
+            x = (x | x << 4) & 0x10c30c30c30c30c3;
+            x = (x | x << 2) & 0x1249249249249249;
+            return x;
+        }
+    }  // namespace curve_impl
+
+    /**
+     * @brief Returns the position of a grid index along the Morton (Z-order) curve.
+     * @param idx The grid index, each component below 2^21.
+     * @return The key, the bits of the components are interleaved.
+     */
+    constexpr uint64_t morton_key(const std::array<uint32_t, 3>& idx) {
+        return curve_impl::spread_bits(idx[0]) << 2 | curve_impl::spread_bits(idx[1]) << 1 |
+               curve_impl::spread_bits(idx[2]);
+    }
+
+    /**
+     * @brief Returns the position of a grid index along the Hilbert curve (J. Skilling, "Programming the Hilbert
+     * curve", 2004). Unlike the Morton curve, consecutive keys are always neighboring cells.
+     * @param idx The grid index, each component below 2^bits.
+     * @param dims The number of dimensions, 2 (the third component is ignored) or 3.
+     * @param bits The number of bits per component, at most 21.
+     * @return The key.
+     */
+    constexpr uint64_t hilbert_key(std::array<uint32_t, 3> idx, const int dims, const int bits) {
+        if (bits <= 0) return 0;
+        const uint32_t top = 1u << (bits - 1);
+
+        // inverse undo of the rotations and reflections
+        for (uint32_t q = top; q > 1; q >>= 1) {
+            const uint32_t p = q - 1;
+            for (int i = 0; i < dims; i++) {
+                if (idx[i] & q) {
+                    idx[0] ^= p;
+                } else {
+                    const uint32_t t = (idx[0] ^ idx[i]) & p;
+                    idx[0] ^= t;
+                    idx[i] ^= t;
+                }
+            }
+        }
+
+        // gray encode
+        for (int i = 1; i < dims; i++) idx[i] ^= idx[i - 1];
+        uint32_t t = 0;
+        for (uint32_t q = top; q > 1; q >>= 1) {
+            if (idx[dims - 1] & q) t ^= q - 1;
+        }
+        for (int i = 0; i < dims; i++) idx[i] ^= t;
+
+        // the transposed key holds one bit of each component per level, most significant level first
+        uint64_t key = 0;
+        for (int b = bits - 1; b >= 0; b--) {
+            for (int i = 0; i < dims; i++) key = key << 1 | ((idx[i] >> b) & 1);
+        }
+        return key;
+    }
+}  // namespace md::utils
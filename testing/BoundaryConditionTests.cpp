@@ -93,8 +93,8 @@ TEST(BoundaryConditionsTest, simple_periodic_test) {
     simulator.simulate(0, 0.001, 0.001); // single iteration
 
     EXPECT_NEAR(env[0].position[0], 9.999, 0.000001);
-    EXPECT_NEAR(env[1].force[0], -0.332783025, 0.000001);
-    EXPECT_NEAR(env[2].force[0], 0.332783025, 0.000001);
+    EXPECT_NEAR(env[1].force[0], -0.181640625, 0.000001);
+    EXPECT_NEAR(env[2].force[0], 0.181640625, 0.000001);
 }
 
 // tests if the repulsive force condition works correctly
@@ -209,4 +209,61 @@ TEST(BoundaryConditionsTest, periodi_condition_edge_case) {
     EXPECT_NEAR(env.operator[](0).position[0], 0.005, 1e5);
     EXPECT_NEAR(env.operator[](0).position[0], 0.01, 1e5);
 
-}
\ No newline at end of file
+}
+
+// tests the boundary pass over the boundary cells and the outside particles
+TEST(BoundaryConditionsTest, boundary_pass_test) {
+    md::env::Environment env;
+    md::env::Boundary boundary;
+    boundary.set_boundary_rule(md::env::BoundaryRule::OUTFLOW);
+    boundary.set_boundary_rule(md::env::BoundaryRule::REPULSIVE_FORCE, md::env::BoundaryNormal::BOTTOM);
+    env.add_particle({5, 0.5, 0}, {0, 0, 0}, 1, 0);
+    env.add_particle({0.5, 5, 0}, {0, 0, 0}, 1, 0);
+    env.add_particle({9.5, 5, 0}, {0, 0, 0}, 1, 0);
+    setUp(env, boundary, false);
+
+    // two particles leave through outflow faces
+    for (const size_t id : {1, 2}) {
+        env[id].update_position({id == 1 ? -1.0 : 1.0, 0, 0});
+        env[id].update_grid();
+    }
+    env.apply_boundary();
+
+    EXPECT_EQ(env[0].state, md::env::Particle::ALIVE);
+    EXPECT_EQ(env[0].force[0], 0);
+    EXPECT_NEAR(env[0].force[1], 390144, 0.000001);
+    EXPECT_EQ(env[1].state, md::env::Particle::DEAD);
+    EXPECT_EQ(env[2].state, md::env::Particle::DEAD);
+    EXPECT_EQ(env.size(md::env::Particle::ALIVE), 1);
+    EXPECT_EQ(env.size(md::env::Particle::DEAD), 2);
+}
+
+// tests if a particle that is outside across several periodic faces is wrapped back along all of them
+TEST(BoundaryConditionsTest, periodic_corner_pass_test) {
+    md::env::Environment env;
+    md::env::Boundary boundary;
+    boundary.set_boundary_rule(md::env::BoundaryRule::PERIODIC);
+    boundary.origin = {0, 0, 0};
+    boundary.extent = {3, 3, 3};
+    env.set_grid_constant(1);
+    env.set_boundary(boundary);
+    env.add_particle({2.5, 2.5, 2.5}, {0, 0, 0}, 1, 0);
+    env.build();
+
+    // the first pass only wraps the particle along the face it crossed first
+    env[0].update_position({1, 1, 1});
+    env[0].update_grid();
+    env.apply_boundary();
+
+    // in the next step the particle starts outside, the remaining faces are derived from its position
+    env[0].update_position({0, 0, 0});
+    env[0].update_grid();
+    env.apply_boundary();
+
+    EXPECT_EQ(env[0].state, md::env::Particle::ALIVE);
+    EXPECT_NEAR(env[0].position[0], 0.5, 1e-12);
+    EXPECT_NEAR(env[0].position[1], 0.5, 1e-12);
+    EXPECT_NEAR(env[0].position[2], 0.5, 1e-12);
+    auto outside = env.particles(md::env::GridCell::OUTSIDE);
+    EXPECT_EQ(std::ranges::distance(outside), 0);
+}
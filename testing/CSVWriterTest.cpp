@@ -49,4 +49,26 @@ TEST(CSVWriterTest, WriteData) {
     EXPECT_EQ(line, "d,4.4,5.5,6.6");
     file.close();
     std::remove("statistics.csv");  
-}
\ No newline at end of file
+}
+TEST(CSVWriterTest, CustomPath) {
+    {
+        md::io::CSVWriter writer(2, "custom_statistics.csv");
+        std::vector<double> velocities = {0.5, 0.25};
+        std::vector<double> densities = {1e-7, 3};
+        writer.writeData(velocities, densities, 0.125);
+    }
+    std::ifstream file("custom_statistics.csv");
+    ASSERT_TRUE(file.is_open());
+
+    std::string line;
+    std::getline(file, line);
+    EXPECT_EQ(line, "time&vel&dens/bins,1,2");
+    std::getline(file, line);
+    EXPECT_EQ(line, "0.125,");
+    std::getline(file, line);
+    EXPECT_EQ(line, "v,0.5,0.25");
+    std::getline(file, line);
+    EXPECT_EQ(line, "d,1e-07,3");
+    file.close();
+    std::remove("custom_statistics.csv");
+}
@@ -176,4 +176,217 @@ TEST(EnvironmentTest,add_membrane_test){
     EXPECT_TRUE(env[1].force[0] == 0);
     EXPECT_TRUE(env[1].force[1] == 0);
     EXPECT_TRUE(env[1].force[2] == 0);
-}
\ No newline at end of file
+}
+// test whether replicating a scenario copies the particles along the x-axis and scales the boundary
+TEST(EnvironmentTest, replicate_test) {
+    md::env::Boundary boundary;
+    boundary.extent = {4, 4, 4};
+    boundary.origin = {CENTER_BOUNDARY_ORIGIN, 0, 0};
+
+    md::env::Environment env;
+    env.add_particle({-1, 1, 1}, {1, 0, 0}, 2, 1);
+    env.add_particle({1, 2, 3}, {0, 0, 0}, 3, 0, md::env::Particle::STATIONARY);
+    env.set_force(md::env::InverseSquare(1e-6, 1), 0);
+    env.set_force(md::env::InverseSquare(1e-6, 1), 1);
+    env.set_boundary(boundary);
+    env.set_grid_constant(1);
+    env.replicate(3);
+    env.build();
+
+    ASSERT_EQ(env.size(md::env::Particle::ALIVE), 3);
+    EXPECT_EQ(env.size(md::env::Particle::STATIONARY), 3);
+
+    EXPECT_EQ(env.origin()[0], -2);
+    EXPECT_EQ(env.extent()[0], 12);
+    EXPECT_EQ(env.extent()[1], 4);
+
+    for (size_t k = 0; k < 3; ++k) {
+        EXPECT_EQ(env[2 * k].position[0], -1 + 4.0 * k);
+        EXPECT_EQ(env[2 * k].position[1], 1);
+        EXPECT_EQ(env[2 * k].velocity[0], 1);
+        EXPECT_EQ(env[2 * k].mass, 2);
+        EXPECT_EQ(env[2 * k].type, 1);
+        EXPECT_EQ(env[2 * k + 1].position[0], 1 + 4.0 * k);
+        EXPECT_EQ(env[2 * k + 1].state, md::env::Particle::STATIONARY);
+        EXPECT_EQ(env[2 * k + 1].id, 2 * k + 1);
+    }
+}
+
+// test whether replicating a scenario without a boundary along the x-axis is rejected
+TEST(EnvironmentTest, replicate_unbounded_test) {
+    md::env::Environment env;
+    env.add_particle({1, 1, 1}, {}, 1, 0);
+    env.set_force(md::env::InverseSquare(1, 5), 0);
+    EXPECT_THROW(env.replicate(2), std::invalid_argument);
+    EXPECT_EQ(env.size(), 1);
+}
+
+// test whether the memory accounting covers the particles, the grid and the forces
+TEST(EnvironmentTest, memory_usage_test) {
+    md::env::Boundary boundary;
+    boundary.extent = {10, 10, 10};
+    boundary.origin = {0, 0, 0};
+
+    md::env::Environment env;
+    env.add_cuboid({1, 1, 1}, {}, {4, 4, 4}, 1, 1);
+    env.add_membrane({1, 1, 6}, {}, {3, 3, 1}, 1, 1, 300, 2.2);
+    env.set_force(md::env::LennardJones(1, 1, 2.5), 0);
+    env.set_boundary(boundary);
+    env.build();
+
+    const md::utils::MemoryUsage usage = env.memory_usage();
+    size_t total = 0;
+    for (const auto& [name, bytes] : usage.subsystems) {
+        // blocks are only built for the spatial decomposition
+        if (name != "block cell pairs") {
+            EXPECT_GT(bytes, 0) << name;
+        }
+        total += bytes;
+        if (name == "particles") {
+            EXPECT_GE(bytes, 73 * sizeof(md::env::Particle));
+        }
+    }
+    EXPECT_EQ(usage.subsystems.size(), 9);
+    EXPECT_EQ(usage.total(), total);
+    EXPECT_GT(md::utils::peak_rss(), 0);
+    EXPECT_EQ(md::utils::format_bytes(1536), "1.50 KiB");
+}
+
+// test whether the index lists follow particles that change their cell or die
+TEST(EnvironmentTest, particle_lists_test) {
+    md::env::Boundary boundary;
+    boundary.extent = {10, 10, 10};
+    boundary.origin = {0, 0, 0};
+
+    md::env::Environment env;
+    env.add_particle({5, 5, 5}, {0, 0, 0}, 1, 0);
+    env.add_particle({0.5, 5, 5}, {0, 0, 0}, 1, 0, md::env::Particle::STATIONARY);
+    env.add_particle({0.2, 5, 5}, {0, 0, 0}, 1, 0);
+    env.set_force(md::env::InverseSquare(1e-6, 1), 0);
+    env.set_boundary(boundary);
+    env.set_grid_constant(1);
+    env.build();
+
+    auto count = [](auto&& range) { return std::ranges::distance(range); };
+    using md::env::GridCell;
+    using md::env::Particle;
+    EXPECT_EQ(count(env.particles()), 2);
+    EXPECT_EQ(count(env.particles(GridCell::BOUNDARY | GridCell::OUTSIDE, Particle::ALIVE | Particle::STATIONARY)), 2);
+    EXPECT_EQ(count(env.particles(GridCell::OUTSIDE)), 0);
+
+    env[2].update_position({-0.5, 0, 0});
+    env[2].update_grid();
+    EXPECT_EQ(count(env.particles()), 1);
+    EXPECT_EQ(count(env.particles(GridCell::OUTSIDE)), 1);
+
+    env.apply_boundary(env[2]);
+    EXPECT_EQ(env[2].state, Particle::DEAD);
+    EXPECT_EQ(env.size(Particle::ALIVE), 1);
+    EXPECT_EQ(env.size(Particle::DEAD), 1);
+    EXPECT_EQ(env.size(Particle::ALIVE | Particle::STATIONARY), 2);
+    EXPECT_EQ(count(env.particles(GridCell::OUTSIDE)), 0);
+    EXPECT_EQ(count(env.particles(GridCell::INSIDE | GridCell::OUTSIDE, Particle::DEAD)), 1);
+    ASSERT_EQ(env.particle_ids(Particle::ALIVE).size(), 1);
+    EXPECT_EQ(env.particle_ids(Particle::ALIVE)[0], 0);
+}
+
+// test whether compaction removes the dead particles and keeps the ids of the others
+TEST(EnvironmentTest, compact_test) {
+    md::env::Boundary boundary;
+    boundary.extent = {10, 10, 10};
+    boundary.origin = {0, 0, 0};
+
+    md::env::Environment env;
+    for (int i = 0; i < 6; i++) {
+        env.add_particle({0.5 + i, 5, 5}, {0, 0, 0}, 1, 0);
+    }
+    env.set_force(md::env::InverseSquare(1e-6, 1), 0);
+    env.set_boundary(boundary);
+    env.set_grid_constant(1);
+    env.build();
+
+    using md::env::Particle;
+    env[1].set_state(Particle::DEAD);
+    env[4].set_state(Particle::DEAD);
+
+    EXPECT_EQ(env.compact(true), 2);
+    EXPECT_EQ(env.compact(), 0);
+    EXPECT_EQ(env.removed_count(), 2);
+    EXPECT_EQ(env.size(Particle::ALIVE), 4);
+    EXPECT_EQ(env.size(Particle::DEAD), 0);
+    EXPECT_FALSE(env.contains(1));
+    EXPECT_FALSE(env.contains(4));
+    EXPECT_FALSE(env.contains(6));
+
+    // the remaining particles are found by their ids and in their cells
+    for (const size_t id : {0, 2, 3, 5}) {
+        ASSERT_TRUE(env.contains(id));
+        EXPECT_EQ(env[id].id, id);
+        EXPECT_EQ(env[id].position[0], 0.5 + static_cast<double>(id));
+    }
+    size_t in_cells = 0;
+    for (const auto& pair : env.linked_cells()) {
+        if (pair.empty() || pair.cell1.id == pair.cell2.id) continue;
+        for (const auto [p1, p2] : pair.particles()) {
+            EXPECT_EQ(p1->state, Particle::ALIVE);
+            EXPECT_EQ(p2->state, Particle::ALIVE);
+            in_cells++;
+        }
+    }
+    EXPECT_EQ(in_cells, 1);  // only the neighboring particles 2 and 3 are left
+
+    // particles can still die after the compaction
+    env[5].update_position({5, 0, 0});
+    env[5].update_grid();
+    env.apply_boundary(env[5]);
+    EXPECT_EQ(env.size(Particle::DEAD), 1);
+    EXPECT_EQ(env.compact(), 1);
+    EXPECT_EQ(env.removed_count(), 3);
+    EXPECT_EQ(std::ranges::distance(env.particles()), 3);
+}
+
+TEST(EnvironmentTest, insert_after_build_test) {
+    md::env::Boundary boundary;
+    boundary.extent = {10, 10, 10};
+    boundary.origin = {0, 0, 0};
+
+    md::env::Environment env;
+    env.add_particle({0.5, 5, 5}, {0, 0, 0}, 1, 0);
+    env.set_force(md::env::InverseSquare(1e-6, 1), 0);
+    env.set_boundary(boundary);
+    env.set_grid_constant(1);
+    env.build();
+
+    using md::env::Particle;
+    // the storage is reallocated several times, the particles stay in their cells
+    std::vector<md::env::ParticleCreateInfo> infos;
+    for (int i = 1; i < 10; i++) infos.emplace_back(md::vec3{0.5 + i, 5, 5}, md::vec3{}, 1, 0);
+    EXPECT_EQ(env.add_particles(infos), 1);
+    EXPECT_EQ(env.add_particle({9.5, 0.5, 0.5}, {}, 1, 0), 10);
+    EXPECT_EQ(env.id_count(), 11);
+    EXPECT_EQ(env.size(Particle::ALIVE), 11);
+    EXPECT_EQ(std::ranges::distance(env.particles(md::env::GridCell::BOUNDARY)), 3);
+
+    size_t in_cells = 0;
+    for (const auto& pair : env.linked_cells()) {
+        if (pair.empty() || pair.cell1.id == pair.cell2.id) continue;
+        for (const auto [p1, p2] : pair.particles()) {
+            EXPECT_EQ(std::abs(p1->position[0] - p2->position[0]), 1);
+            in_cells++;
+        }
+    }
+    EXPECT_EQ(in_cells, 9);  // neighbors along the row, the corner particle has none
+
+    EXPECT_TRUE(env.occupied({4.6, 5.4, 5}, 0.5));
+    EXPECT_FALSE(env.occupied({4, 3, 5}, 1.5));
+    EXPECT_TRUE(env.occupied({9, 1, 1}, 1));
+
+    // inserted particles move through the grid and can be removed like the others
+    env[10].update_position({0, 0, -1});
+    env[10].update_grid();
+    env.apply_boundary(env[10]);
+    EXPECT_EQ(env.compact(), 1);
+    EXPECT_EQ(env.size(Particle::ALIVE), 10);
+    EXPECT_EQ(env.add_particle({5, 5, 5.5}, {}, 1, 0), 11);
+    EXPECT_EQ(env[11].position[2], 5.5);
+}
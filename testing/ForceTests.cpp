@@ -166,3 +166,56 @@ TEST(ForceTest, pulling_force_test2) {
     }
 }
 
+
+// check that pairs of two stationary particles are skipped, while pairs with one stationary particle are not
+TEST(ForceTest, stationary_pair_test) {
+    md::env::Environment env;
+    md::env::Boundary boundary;
+    boundary.extent = {10, 10, 10};
+    boundary.origin = {0, 0, 0};
+    env.set_boundary(boundary);
+    env.add_particle({1, 1, 1}, {0, 0, 0}, 1, 0, md::env::Particle::STATIONARY);
+    env.add_particle({2, 1, 1}, {0, 0, 0}, 1, 0, md::env::Particle::STATIONARY);
+    env.add_particle({1, 2, 1}, {0, 0, 0}, 1, 0);
+    env.set_grid_constant(10);
+    env.set_force(md::env::LennardJones(1.0, 1.0, 5), 0);
+    env.build();
+
+    const auto& cell_pair = env.linked_cells().front();
+    const md::vec3 stationary = env.force(env[0], env[1], cell_pair);
+    const md::vec3 mixed = env.force(env[0], env[2], cell_pair);
+
+    EXPECT_EQ(stationary, (md::vec3{0, 0, 0}));
+    EXPECT_NEAR(mixed[1], 24, 1e-9);
+}
+
+// tests if bonds act independent of the linked cells, across periodic boundaries and with exclusions
+TEST(ForceTest, bonded_force_test) {
+    md::env::Environment env;
+    env.add_particle({2, 5, 5}, {}, 1);
+    env.add_particle({8, 5, 5}, {}, 1);
+    env.add_particle({9, 5, 5}, {}, 1);
+    env.add_particle({0.5, 10, 10}, {}, 1);
+    env.add_particle({19.5, 10, 10}, {}, 1);
+    env.set_force(md::env::LennardJones(1, 1, 2.5), 0);
+
+    md::env::Boundary boundary;
+    boundary.extent = {20, 20, 20};
+    boundary.origin = {0, 0, 0};
+    boundary.set_boundary_rule(md::env::BoundaryRule::PERIODIC);
+    env.set_boundary(boundary);
+
+    env.add_bond(0, 1, 10, 5);        // stretched by 1, far apart
+    env.exclude(1, 2);                // Lennard-Jones excluded
+    env.add_bond(3, 4, 10, 2, true);  // compressed by 1 across the periodic boundary, Lennard-Jones excluded
+    env.build();
+    EXPECT_EQ(env.bond_count(), 3);
+
+    md::Integrator::StoermerVerlet simulator(env);
+    simulator.simulate(0, 0.001, 0.001, 0, 10);  // no movement in the first step
+
+    const std::vector<md::vec3> expected = {{10, 0, 0}, {-10, 0, 0}, {0, 0, 0}, {10, 0, 0}, {-10, 0, 0}};
+    for (size_t i = 0; i < expected.size(); i++) {
+        for (int k = 0; k < 3; k++) EXPECT_NEAR(env[i].force[k], expected[i][k], 1e-12) << i;
+    }
+}
@@ -6,8 +6,12 @@
 #include "../src/env/Force.h"
 #include "../src/effects/ConstantForce.h"
 #include "../src/io/IOStrategy.h"
+#include "../src/io/Output/OutputBuffer.h"
+#include "../src/io/Output/TrajectoryWriter.h"
+#include "../src/io/Output/XYZWriter.h"
 #include "../src/io/input/txt/TXTFileReader.h"
 #include "../src/io/input/xml/XMLFileReader.h"
+#include "../src/io/input/xml/XMLStreamReader.h"
 
 using namespace md;
 
@@ -238,6 +242,60 @@ TEST(IOTest, read_cuboid_xml_file_test) {
     EXPECT_EQ(args.env[65].type, 1);
 }
 
+// tests if the streaming xml reader yields the same arguments, boundary and thermostat as the tree reader.
+TEST(IOTest, stream_arguments_xml_file_test) {
+    io::ProgramArguments args;
+    io::read_file_xml_stream("../../testing/test_input_files/xml/InputTest6.xml", args, true);
+
+    EXPECT_EQ(args.output_baseName, "output");
+    EXPECT_EQ(args.duration, 20);
+    EXPECT_EQ(args.dt, 0.0005);
+    EXPECT_EQ(args.cutoff_radius, 2.5);
+    EXPECT_EQ(args.write_freq, 100);
+    EXPECT_EQ(args.parallel_strategy, 2);
+
+    EXPECT_EQ(args.boundary.extent[0], 100);
+    EXPECT_EQ(args.boundary.boundary_rules()[2], env::BoundaryRule::REPULSIVE_FORCE);
+    EXPECT_EQ(env_friend.get_grid_constant(args.env), 2.5);
+
+    EXPECT_EQ(env_friend.get_init_temp(args.thermostat), 40);
+    EXPECT_EQ(env_friend.get_target_temp(args.thermostat), 50);
+    EXPECT_EQ(env_friend.get_max_temp_change(args.thermostat), 4);
+    EXPECT_EQ(args.temp_adj_freq, 100);
+}
+
+// tests if the streaming xml reader adds particles and cuboids in the same order as the tree reader.
+TEST(IOTest, stream_cuboid_xml_file_test) {
+    io::ProgramArguments tree_args;
+    io::read_file_xml("../../testing/test_input_files/xml/InputTest3.xml", tree_args);
+    io::ProgramArguments stream_args;
+    io::read_file_xml_stream("../../testing/test_input_files/xml/InputTest3.xml", stream_args);
+
+    EXPECT_EQ(stream_args.env.size(env::Particle::ALIVE), 60);
+    EXPECT_EQ(stream_args.env.size(env::Particle::STATIONARY), 6);
+    for (size_t i = 0; i < 66; ++i) {
+        EXPECT_EQ(stream_args.env[i].position, tree_args.env[i].position);
+        EXPECT_EQ(stream_args.env[i].mass, tree_args.env[i].mass);
+        EXPECT_EQ(stream_args.env[i].type, tree_args.env[i].type);
+        EXPECT_EQ(stream_args.env[i].state, tree_args.env[i].state);
+    }
+}
+
+// tests if the streaming xml reader infers the dimension of a cuboid (-1) like the tree reader.
+TEST(IOTest, stream_infer_dimension_xml_file_test) {
+    io::ProgramArguments tree_args;
+    io::read_file_xml("../../testing/test_input_files/xml/InputTest9.xml", tree_args);
+    io::ProgramArguments stream_args;
+    io::read_file_xml_stream("../../testing/test_input_files/xml/InputTest9.xml", stream_args);
+
+    EXPECT_EQ(tree_args.env.size(), 12);
+    EXPECT_EQ(stream_args.env.size(), 12);
+    for (size_t i = 0; i < 12; ++i) {
+        EXPECT_EQ(stream_args.env[i].position, tree_args.env[i].position);
+        EXPECT_EQ(stream_args.env[i].velocity, tree_args.env[i].velocity);
+    }
+}
+
 // tests if sphere info is read correctly from a xml file.
 TEST(IOTest, read_sphere_xml_file_test) {
     io::ProgramArguments args;
@@ -281,6 +339,12 @@ TEST(IOTest, read_membrane_xml_file_test) {
     io::read_file_xml("../../testing/test_input_files/xml/InputTest5.xml", args);
 
     EXPECT_EQ(args.env.size(), 100);
+    EXPECT_EQ(args.respa_substeps, 4);
+    EXPECT_EQ(args.pair_method, env::PairMethod::LINKED_CELLS);
+    io::ProgramArguments stream_args;
+    io::read_file_xml_stream("../../testing/test_input_files/xml/InputTest5.xml", stream_args);
+    EXPECT_EQ(stream_args.respa_substeps, 4);
+    EXPECT_EQ(stream_args.pair_method, env::PairMethod::LINKED_CELLS);
 
     vec3 exp_position = {1, 2, 3};
     vec3 exp_velocity = {4, 5, 6};
@@ -396,6 +460,34 @@ TEST(IOTest, read_particle_txt_file_test) {
     EXPECT_EQ(state, 0);
 }
 
+// tests if a particle section large enough to be parsed in several chunks keeps the particle order.
+TEST(IOTest, read_large_particle_section_txt_file_test) {
+    const std::string file_name = "large_particle_section_test.txt";
+    constexpr int n_particles = 20000;
+    {
+        std::ofstream file(file_name);
+        file << "particles:\n";
+        for (int i = 0; i < n_particles; ++i) {
+            if (i % 1000 == 0) file << "# comment line " << i << "\n\n";
+            file << i % 40 << " " << 0.5 * (i / 40 % 40) << " " << 0.25 * (i / 1600) << "    1 2 3    "
+                 << 1 + i % 3 << " " << i % 2 << " 1\n";
+        }
+        file << "environment:\n0 0 0   40 40 40   2.5   0 0 0 0 0 0\n";
+    }
+
+    io::ProgramArguments args;
+    io::read_file_txt(file_name, args);
+    std::filesystem::remove(file_name);
+
+    EXPECT_EQ(args.env.size(env::Particle::ALIVE | env::Particle::STATIONARY), n_particles);
+    for (int i = 0; i < n_particles; ++i) {
+        vec3 exp_position = {static_cast<double>(i % 40), 0.5 * (i / 40 % 40), 0.25 * (i / 1600)};
+        ASSERT_EQ(args.env[i].position, exp_position);
+        EXPECT_EQ(args.env[i].mass, 1 + i % 3);
+        EXPECT_EQ(args.env[i].type, i % 2);
+    }
+}
+
 // tests if cuboid info is read correctly from a txt file.
 TEST(IOTest, read_cuboid_txt_file_test) {
     io::ProgramArguments args;
@@ -489,4 +581,269 @@ TEST(IOTest, read_membrane_txt_file_test) {
     EXPECT_EQ(args.env[99].velocity, exp_velocity);
     EXPECT_EQ(args.env[99].mass, 1);
     EXPECT_EQ(args.env[99].type, 0);
-}
\ No newline at end of file
+}
+
+
+/// -----------------------------------------
+/// Output filter tests
+/// -----------------------------------------
+
+// tests if the output filters are read correctly from a xml file.
+TEST(IOTest, read_output_filter_xml_file_test) {
+    for (const bool stream : {false, true}) {
+        io::ProgramArguments args;
+        if (stream) {
+            io::read_file_xml_stream("../../testing/test_input_files/xml/InputTest8.xml", args, true);
+        } else {
+            io::read_file_xml("../../testing/test_input_files/xml/InputTest8.xml", args);
+        }
+
+        EXPECT_EQ(args.output_filter.regions.size(), 2);
+        EXPECT_EQ(args.output_filter.types, std::vector<int>({1, 3}));
+        EXPECT_EQ(args.output_filter.stride, 2);
+        EXPECT_EQ(args.output_filter.fields, io::OutputFilter::POSITION | io::OutputFilter::VELOCITY);
+    }
+}
+
+// tests if region, type and stride filters select the expected particles.
+TEST(IOTest, output_filter_select_test) {
+    env::Environment env;
+    for (int i = 0; i < 10; ++i) {
+        env.add_particle({i + 0.5, 0.5, 0.5}, {}, 1, i % 2);
+    }
+    env.set_grid_constant(1);
+    env.build();
+
+    auto ids = [&](const io::OutputFilter& filter) {
+        std::vector<size_t> result;
+        for (const auto* p : filter.select(env)) result.push_back(p->id);
+        return result;
+    };
+
+    io::OutputFilter filter;
+    EXPECT_EQ(ids(filter).size(), 10);
+
+    filter.regions.push_back(env::MarkBox({0, 0, 0}, {3, 1, 1}));
+    filter.regions.push_back(env::MarkBox({7, 0, 0}, {10, 1, 1}));
+    EXPECT_EQ(ids(filter), std::vector<size_t>({0, 1, 2, 7, 8, 9}));
+
+    filter.types = {1};
+    EXPECT_EQ(ids(filter), std::vector<size_t>({1, 7, 9}));
+
+    filter.stride = 2;
+    EXPECT_EQ(ids(filter), std::vector<size_t>({1, 9}));
+
+    EXPECT_EQ(io::OutputFilter::parse_fields(" mass\ttype "), io::OutputFilter::MASS | io::OutputFilter::TYPE);
+    EXPECT_THROW(io::OutputFilter::parse_fields("colour"), std::invalid_argument);
+    EXPECT_THROW(io::OutputFilter::parse_fields(""), std::invalid_argument);
+}
+
+// tests if the selection stays in id order when particles die and change their cells, so that the strided subset
+// and the particle order of a trajectory keyframe can be reused.
+TEST(IOTest, output_filter_order_test) {
+    env::Boundary boundary;
+    boundary.origin = {0, 0, 0};
+    boundary.extent = {8, 8, 1};
+
+    env::Environment env;
+    for (int i = 0; i < 62; ++i) {
+        env.add_particle({i % 8 + 0.5, i / 8 + 0.5, 0.5}, {}, 1, 0);
+    }
+    env.set_boundary(boundary);
+    env.set_grid_constant(1);
+    env.set_cell_order(env::CellOrder::HILBERT);
+    env.build();
+
+    io::OutputFilter filter;
+    filter.stride = 3;
+    auto ids = [&] {
+        std::vector<size_t> result;
+        for (const auto* p : filter.select(env)) result.push_back(p->id);
+        return result;
+    };
+    std::vector<size_t> expected;
+    for (size_t id = 0; id < 61; id += 3) expected.push_back(id);
+    EXPECT_EQ(ids(), expected);
+
+    {
+        io::TrajectoryWriter writer("output_filter_order_test", true, filter, 1e-3, 100);
+        writer.plot_particles(env, 0);
+        for (int frame = 1; frame < 5; ++frame) {
+            if (frame == 1) {
+                // not selected, and the last one in id order
+                env[61].state = env::Particle::DEAD;
+                env[61].update_grid();
+            }
+            for (auto& p : env.particles()) {
+                p.update_position({0, frame % 2 ? 0.7 : -0.7, 0});
+                p.update_grid();
+            }
+            EXPECT_EQ(ids(), expected);
+            writer.plot_particles(env, frame);
+        }
+    }
+
+    io::TrajectoryReader reader(std::string(OUTPUT_DIR) + "/output_filter_order_test" + TRAJECTORY_EXTENSION);
+    ASSERT_EQ(reader.frame_count(), 5);
+    EXPECT_TRUE(reader.is_keyframe(0));
+    for (size_t frame = 1; frame < 5; ++frame) EXPECT_FALSE(reader.is_keyframe(frame));
+}
+
+
+/// -----------------------------------------
+/// XYZ output tests
+/// -----------------------------------------
+
+// tests if all frames are appended to a single file in multi-frame mode.
+TEST(IOTest, write_multi_frame_xyz_test) {
+    env::Environment env;
+    env.add_particle({0.5, 1.5, 2.5}, {}, 1, 0);
+    env.add_particle({1.25, 0, 3}, {}, 1, 0);
+    env.set_grid_constant(1);
+    env.build();
+
+    {
+        io::XYZWriter writer("multi_frame_test", true, {}, true);
+        for (int iteration = 0; iteration < 3; ++iteration) {
+            writer.plot_particles(env, iteration);
+        }
+    }
+
+    std::ifstream file(std::string(OUTPUT_DIR) + "/multi_frame_test.xyz");
+    ASSERT_TRUE(file.is_open());
+    std::string line;
+    for (int frame = 0; frame < 3; ++frame) {
+        std::getline(file, line);
+        EXPECT_EQ(line, "2");
+        std::getline(file, line);
+        EXPECT_TRUE(line.ends_with("Iteration " + std::to_string(frame)));
+        std::getline(file, line);
+        EXPECT_EQ(line, "Ar 0.5 1.5 2.5");
+        std::getline(file, line);
+        EXPECT_EQ(line, "Ar 1.25 0 3");
+    }
+    EXPECT_FALSE(std::getline(file, line));
+}
+
+// tests if numbers longer than the reserved bytes are written completely, also at the end of the buffer.
+TEST(IOTest, output_buffer_precision_test) {
+    const std::string file_name = "output_buffer_test.txt";
+    std::string expected;
+    {
+        io::OutputBuffer out(64);
+        ASSERT_TRUE(out.open(file_name));
+        for (const int digits : {6, 17, 40, 120}) {
+            out.set_precision(digits);
+            for (const double value : {1.0 / 3, -2.5e-300, 1e300, 123456.789}) {
+                out << value << ' ';
+                char chars[512];
+                const auto [ptr, ec] = std::to_chars(chars, chars + sizeof(chars), value, std::chars_format::general, digits);
+                expected.append(chars, ptr);
+                expected += ' ';
+            }
+        }
+    }
+
+    std::ifstream file(file_name);
+    const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(content, expected);
+    std::remove(file_name.c_str());
+}
+
+/// -----------------------------------------
+/// Trajectory tests
+/// -----------------------------------------
+
+// tests if a compressed trajectory can be read back frame by frame in arbitrary order.
+TEST(IOTest, trajectory_round_trip_test) {
+    env::Boundary boundary;
+    boundary.origin = {0, 0, 0};
+    boundary.extent = {20, 20, 20};
+
+    env::Environment env;
+    for (int i = 0; i < 500; ++i) {
+        env.add_particle({1 + i % 10 * 1.7, 1 + i / 10 % 10 * 1.7, 1 + i / 100 * 1.7}, {}, 1, 0);
+    }
+    env.set_boundary(boundary);
+    env.set_grid_constant(2.5);
+    env.build();
+
+    constexpr double precision = 1e-3;
+    constexpr int n_frames = 25;
+    std::vector<std::vector<vec3>> expected;
+    {
+        io::TrajectoryWriter writer("trajectory_test", true, {}, precision, 4);
+        for (int frame = 0; frame < n_frames; ++frame) {
+            if (frame == 10) {
+                env[42].state = env::Particle::DEAD;
+                env[42].update_grid();
+            }
+            std::vector<vec3> positions(500);
+            for (auto& p : env.particles(env::GridCell::INSIDE, env::Particle::ALIVE)) {
+                p.update_position({0.01 * std::sin(frame + p.id), 0.02, -0.013 * (p.id % 3)});
+                p.update_grid();
+                positions[p.id] = p.position;
+            }
+            expected.push_back(positions);
+            writer.plot_particles(env, frame * 10);
+        }
+    }
+
+    io::TrajectoryReader reader(std::string(OUTPUT_DIR) + "/trajectory_test" + TRAJECTORY_EXTENSION);
+    ASSERT_EQ(reader.frame_count(), n_frames);
+    EXPECT_EQ(reader.precision(), precision);
+
+    for (const int frame : {17, 3, 24, 0, 10, 9, 11, 5}) {
+        const auto result = reader.read_frame(frame);
+        EXPECT_EQ(result.iteration, frame * 10);
+        EXPECT_EQ(reader.iteration(frame), frame * 10);
+        ASSERT_EQ(result.ids.size(), frame < 10 ? 500 : 499);
+        ASSERT_EQ(result.positions.size(), result.ids.size());
+        for (size_t i = 0; i < result.ids.size(); ++i) {
+            if (frame >= 10) {
+                EXPECT_NE(result.ids[i], 42);
+            }
+            for (int d = 0; d < 3; ++d) {
+                EXPECT_NEAR(result.positions[i][d], expected[frame][result.ids[i]][d], precision / 2 + 1e-12);
+            }
+        }
+    }
+}
+
+// tests if the trajectory keeps its precision without a boundary and for particles leaving the grid of a keyframe.
+TEST(IOTest, trajectory_unbounded_test) {
+    env::Environment env;
+    for (int i = 0; i < 50; ++i) {
+        env.add_particle({300 + i * 13.1, 1e4 + i * 0.7, 0.5}, {}, 1, 0);
+    }
+    env.build();
+
+    constexpr double precision = 1e-3;
+    constexpr int n_frames = 12;
+    std::vector<std::vector<vec3>> expected;
+    {
+        io::TrajectoryWriter writer("trajectory_unbounded_test", true, {}, precision, 100);
+        for (int frame = 0; frame < n_frames; ++frame) {
+            std::vector<vec3> positions(50);
+            for (auto& p : env.particles()) {
+                // particle 7 leaves the grid of the first keyframe after a few frames
+                p.update_position({p.id == 7 ? 300.0 * frame : 0.01 * frame, 0.02 * std::sin(frame + p.id), 0});
+                positions[p.id] = p.position;
+            }
+            expected.push_back(positions);
+            writer.plot_particles(env, frame);
+        }
+    }
+
+    io::TrajectoryReader reader(std::string(OUTPUT_DIR) + "/trajectory_unbounded_test" + TRAJECTORY_EXTENSION);
+    ASSERT_EQ(reader.frame_count(), n_frames);
+    for (int frame = 0; frame < n_frames; ++frame) {
+        const auto result = reader.read_frame(frame);
+        ASSERT_EQ(result.ids.size(), 50);
+        for (size_t i = 0; i < result.ids.size(); ++i) {
+            for (int d = 0; d < 3; ++d) {
+                EXPECT_NEAR(result.positions[i][d], expected[frame][result.ids[i]][d], precision / 2 + 1e-9);
+            }
+        }
+    }
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <set>
+
 #include "core/StoermerVerlet/StoermerVerlet.h"
 #include "../src/env/Environment.h"
 #include "../src/env/ParticleGrid.h"
@@ -76,6 +78,26 @@ TEST(LinkedCellsTest, grid_pair_test) {
     }
 }
 
+// tests if the boundary cells are collected per face
+TEST(LinkedCellsTest, boundary_cells_test) {
+    // the grid is a single layer of 5x5 cells, hence every cell is at the front and back face
+    EXPECT_EQ(grid.boundary_cells().size(), 25);
+    EXPECT_EQ(grid.boundary_cells(md::env::Boundary::FRONT).size(), 25);
+    EXPECT_EQ(grid.boundary_cells(md::env::Boundary::BACK).size(), 25);
+    for (const auto face : {md::env::Boundary::LEFT, md::env::Boundary::RIGHT, md::env::Boundary::TOP,
+                            md::env::Boundary::BOTTOM}) {
+        EXPECT_EQ(grid.boundary_cells(face).size(), 5);
+    }
+
+    const auto& corner = grid.get_cell({0, 4, 0});
+    ASSERT_EQ(corner.faces.size(), 4);
+    EXPECT_EQ(corner.faces[0], md::env::Boundary::LEFT);
+    EXPECT_EQ(corner.faces[1], md::env::Boundary::TOP);
+    EXPECT_EQ(corner.faces[2], md::env::Boundary::FRONT);
+    EXPECT_EQ(corner.faces[3], md::env::Boundary::BACK);
+    EXPECT_TRUE(grid.get_cell({-1, -1, -1}).faces.empty());
+}
+
 struct SymmetricPairHasher {  // symmetric pair hasher
     template <typename T1, typename T2>
     std::size_t operator()(const std::pair<T1, T2>& key) const {
@@ -85,3 +107,103 @@ struct SymmetricPairHasher {  // symmetric pair hasher
     }
 };
 
+// tests if the cells, the cell pairs and the particles follow the space filling curves
+TEST(LinkedCellsTest, cell_order_test) {
+    auto build = [](md::env::Environment& env, const md::env::CellOrder order) {
+        md::env::Boundary box;
+        box.origin = {0, 0, 0};
+        box.extent = {8, 8, 8};
+        box.set_boundary_rule(md::env::BoundaryRule::PERIODIC);
+        env.set_boundary(box);
+        env.add_cuboid({0.5, 0.5, 0.5}, {}, {8, 8, 8}, 1, 1, 0, 0);
+        env.set_force(md::env::LennardJones(1, 1, 2), 0);
+        env.set_cell_order(order);
+        env.build();
+    };
+    auto pair_set = [](md::env::Environment& env) {
+        std::set<std::pair<md::int3, md::int3>> pairs;
+        for (const auto& pair : env.linked_cells()) pairs.emplace(pair.cell1.idx, pair.cell2.idx);
+        return pairs;
+    };
+
+    md::env::Environment linear;
+    build(linear, md::env::CellOrder::LINEAR);
+    const auto linear_pairs = pair_set(linear);
+
+    for (const auto order : {md::env::CellOrder::MORTON, md::env::CellOrder::HILBERT}) {
+        md::env::Environment env;
+        build(env, order);
+        EXPECT_EQ(pair_set(env), linear_pairs);
+
+        // the pairs are grouped by their first cell, whose ids ascend along the curve
+        const auto& pairs = env.linked_cells();
+        for (size_t i = 1; i < pairs.size(); i++) {
+            EXPECT_LE(pairs[i - 1].cell1.id, pairs[i].cell1.id);
+        }
+
+        // the 4x4x4 cells are a full cube, hence consecutive cells of the Hilbert curve are neighbors
+        const auto indices = env.linked_cells().front().cell1.idx;
+        EXPECT_EQ(indices, (md::int3{0, 0, 0}));
+        int previous_id = -1;
+        const md::env::GridCell* previous = nullptr;
+        for (const auto& pair : pairs) {
+            if (pair.cell1.id == previous_id) continue;
+            if (previous && order == md::env::CellOrder::HILBERT) {
+                int distance = 0;
+                for (int k = 0; k < 3; k++) distance += std::abs(pair.cell1.idx[k] - previous->idx[k]);
+                EXPECT_EQ(distance, 1);
+            }
+            previous = &pair.cell1;
+            previous_id = pair.cell1.id;
+        }
+
+        // the particles are stored cell by cell
+        int last_cell = -1;
+        const md::env::Particle* last = nullptr;
+        for (const auto& pair : pairs) {
+            if (pair.cell1.id == last_cell) continue;
+            last_cell = pair.cell1.id;
+            for (const md::env::Particle* particle : pair.cell1.particles) {
+                if (last) {
+                    EXPECT_LT(last, particle);
+                }
+            }
+            for (const md::env::Particle* particle : pair.cell1.particles) {
+                if (!last || particle > last) last = particle;
+            }
+        }
+    }
+}
+
+// tests if 2D cells are only linked within their plane, also across a periodic z boundary
+TEST(LinkedCellsTest, stencil_2d_test) {
+    auto build = [](md::env::Environment& env, const md::env::Dimension dimension) {
+        md::env::Boundary box;
+        box.origin = {0, 0, 0};
+        box.extent = {9, 9, 1};
+        box.set_boundary_rule(md::env::BoundaryRule::PERIODIC);
+        env.set_boundary(box);
+        env.add_cuboid({0.5, 0.5, 0.5}, {}, {9, 9, 1}, 1, 1, 0, 0, dimension);
+        env.set_force(md::env::LennardJones(1, 1, 3), 0);
+        env.set_dimension(dimension);
+        env.build();
+    };
+
+    // 3x3 cells, each linked to itself and to 4 of its 8 neighbors
+    md::env::Environment env_2d;
+    build(env_2d, md::env::Dimension::TWO);
+    EXPECT_EQ(env_2d.dim(), 2);
+    EXPECT_EQ(env_2d.linked_cells().size(), 9 * 5);
+
+    std::set<std::pair<int, int>> pairs;
+    for (const auto& pair : env_2d.linked_cells()) {
+        EXPECT_EQ(pair.periodicity & md::env::CellPair::PERIODIC_Z, 0);
+        pairs.emplace(std::min(pair.cell1.id, pair.cell2.id), std::max(pair.cell1.id, pair.cell2.id));
+    }
+    EXPECT_EQ(pairs.size(), 9 * 5);
+
+    // the 3D stencil links the cells across the periodic z boundary as well
+    md::env::Environment env_3d;
+    build(env_3d, md::env::Dimension::THREE);
+    EXPECT_GT(env_3d.linked_cells().size(), 9 * 5);
+}
@@ -2,6 +2,7 @@
 
 #include "../src/core/StoermerVerlet/StoermerVerlet.h"
 #include "../src/core/StoermerVerlet/StoermerVerletCellLock.h"
+#include "../src/core/StoermerVerlet/StoermerVerletNewton3Off.h"
 #include "../src/core/StoermerVerlet/StoermerVerletSpatialDecomp.h"
 #include "../src/env/Boundary.h"
 #include "../src/env/Environment.h"
@@ -10,7 +11,7 @@
 
 using namespace md;
 
-void setup(env::Environment &env, bool build_blocks) {
+void setup(env::Environment &env, bool build_blocks, env::CellOrder order = env::CellOrder::LINEAR) {
     env::Boundary boundary;
     boundary.set_boundary_rule(env::BoundaryRule::PERIODIC);
     boundary.extent = {10, 10, 10};
@@ -21,6 +22,7 @@ void setup(env::Environment &env, bool build_blocks) {
     env.add_cuboid({0.5, 4.5, 0.5}, {0, -2, 0}, {9, 4, 9}, 1, 1, 0, 1, env::Dimension::THREE, env::Particle::ALIVE);
     env.set_force(env::LennardJones(1, 1.2, 2.5), 1);
 
+    env.set_cell_order(order);
     env.build(build_blocks);
 }
 
@@ -183,4 +185,150 @@ TEST(ParallelizationTest, spatial_decomposition_test) {
         EXPECT_NEAR(env_without_2[i].velocity[1], env_spatial[i].velocity[1], 1e-10);
         EXPECT_NEAR(env_without_2[i].velocity[2], env_spatial[i].velocity[2], 1e-10);
     }
-}
\ No newline at end of file
+}
+
+// tests if the force and velocity calculations are correct without Newton's third law.
+TEST(ParallelizationTest, newton3_off_test) {
+    env::Environment env_without_3;
+    env::Environment env_newton3_off;
+
+    setup(env_without_3, false);
+    setup(env_newton3_off, false);
+
+    // every cell pair appears in the shells of both of its cells, the self pairs once
+    size_t shell_pairs = 0;
+    for (const auto &shell: env_newton3_off.cell_shells()) {
+        for (const auto &pair: shell) shell_pairs += pair.cell1.id == pair.cell2.id ? 2 : 1;
+    }
+    EXPECT_EQ(shell_pairs, 2 * env_newton3_off.linked_cells().size());
+
+    Integrator::StoermerVerlet simulator_without_3(env_without_3);
+    Integrator::StoermerVerletNewton3Off simulator_newton3_off(env_newton3_off);
+
+    simulator_without_3.simulate(0, 0.05, 0.0005);
+    simulator_newton3_off.simulate(0, 0.05, 0.0005);
+
+    for (size_t i = 0; i < env_without_3.size(); i++) {
+        EXPECT_NEAR(env_without_3[i].force[0], env_newton3_off[i].force[0], 1e-10);
+        EXPECT_NEAR(env_without_3[i].force[1], env_newton3_off[i].force[1], 1e-10);
+        EXPECT_NEAR(env_without_3[i].force[2], env_newton3_off[i].force[2], 1e-10);
+    }
+
+    for (size_t i = 0; i < env_without_3.size(); i++) {
+        EXPECT_NEAR(env_without_3[i].velocity[0], env_newton3_off[i].velocity[0], 1e-10);
+        EXPECT_NEAR(env_without_3[i].velocity[1], env_newton3_off[i].velocity[1], 1e-10);
+        EXPECT_NEAR(env_without_3[i].velocity[2], env_newton3_off[i].velocity[2], 1e-10);
+    }
+}
+
+// tests if the load monitor accounts the time of every thread without changing the results
+TEST(ParallelizationTest, load_monitor_test) {
+    env::Environment env_cell_lock;
+    env::Environment env_spatial;
+
+    setup(env_cell_lock, false);
+    setup(env_spatial, true);
+
+    Integrator::StoermerVerletCellLock simulator_cell_lock(env_cell_lock);
+    Integrator::StoermerVerletSpatialDecomp simulator_spatial(env_spatial);
+    simulator_cell_lock.monitor_load(10);
+    simulator_spatial.monitor_load(10);
+
+    simulator_cell_lock.simulate(0, 0.01, 0.0005);
+    simulator_spatial.simulate(0, 0.01, 0.0005);
+
+    for (size_t i = 0; i < env_cell_lock.size(); i++) {
+        EXPECT_NEAR(env_cell_lock[i].force[0], env_spatial[i].force[0], 1e-10);
+        EXPECT_NEAR(env_cell_lock[i].velocity[1], env_spatial[i].velocity[1], 1e-10);
+    }
+
+    core::LoadMonitor monitor;
+    monitor.begin_region();
+#pragma omp parallel
+    {
+        monitor.thread_done(core::LoadMonitor::clock::now() - std::chrono::milliseconds(2),
+                            std::chrono::milliseconds(1));
+    }
+    monitor.end_region(1);
+
+    double busy = 0;
+    for (const auto& times : monitor.thread_times()) {
+        busy += times.busy;
+        EXPECT_GE(times.barrier_wait, 0);
+    }
+    EXPECT_GT(busy, 0);
+    EXPECT_NEAR(monitor.thread_times()[0].lock_wait, 1e-3, 1e-9);
+    EXPECT_EQ(monitor.block_set_waits().size(), 2);
+    EXPECT_GE(monitor.imbalance(), 1);
+    monitor.reset();
+    EXPECT_EQ(monitor.imbalance(), 1);
+    EXPECT_NEAR(monitor.thread_times()[0].lock_wait, 1e-3, 1e-9);
+}
+
+// tests if ordering the cells along space filling curves leaves the results of the parallel strategies unchanged
+TEST(ParallelizationTest, cell_order_test) {
+    env::Environment env_linear;
+    env::Environment env_cell_lock;
+    env::Environment env_spatial;
+
+    setup(env_linear, false);
+    setup(env_cell_lock, false, env::CellOrder::MORTON);
+    setup(env_spatial, true, env::CellOrder::HILBERT);
+
+    Integrator::StoermerVerlet simulator_linear(env_linear);
+    Integrator::StoermerVerletCellLock simulator_cell_lock(env_cell_lock);
+    Integrator::StoermerVerletSpatialDecomp simulator_spatial(env_spatial);
+
+    simulator_linear.simulate(0, 0.05, 0.0005);
+    simulator_cell_lock.simulate(0, 0.05, 0.0005);
+    simulator_spatial.simulate(0, 0.05, 0.0005);
+
+    for (size_t i = 0; i < env_linear.size(); i++) {
+        for (int k = 0; k < 3; k++) {
+            EXPECT_NEAR(env_linear[i].force[k], env_cell_lock[i].force[k], 1e-10);
+            EXPECT_NEAR(env_linear[i].force[k], env_spatial[i].force[k], 1e-10);
+            EXPECT_NEAR(env_linear[i].velocity[k], env_cell_lock[i].velocity[k], 1e-10);
+            EXPECT_NEAR(env_linear[i].velocity[k], env_spatial[i].velocity[k], 1e-10);
+        }
+    }
+}
+
+// tests if the bonded forces of a membrane are equal for all parallel strategies
+TEST(ParallelizationTest, bonded_force_test) {
+    auto membrane = [](env::Environment &env, bool build_blocks) {
+        env::Boundary boundary;
+        boundary.set_boundary_rule(env::BoundaryRule::PERIODIC);
+        boundary.extent = {12, 12, 12};
+        env.set_boundary(boundary);
+        env.add_membrane({0.5, 0.5, 6}, {0, 0, 1}, {10, 10, 1}, 1.1, 1, 300, 4, 0, true);
+        env.set_force(env::LennardJones(1, 1, 1.2), 0);
+        env.build(build_blocks);
+    };
+
+    env::Environment env_sequential;
+    env::Environment env_cell_lock;
+    env::Environment env_spatial;
+    membrane(env_sequential, false);
+    membrane(env_cell_lock, false);
+    membrane(env_spatial, true);
+    EXPECT_EQ(env_sequential.bond_count(), 2 * 10 * 9 + 2 * 9 * 9);
+
+    const std::vector<env::ConstantForce> forces = {env::ConstantForce({0, 0, 1}, 20, env::MarkBox({3.5, 4.5, 5}, {5.2, 5.2, 7}))};
+
+    Integrator::StoermerVerlet simulator_sequential(env_sequential, nullptr, nullptr, env::Thermostat(), forces);
+    Integrator::StoermerVerletCellLock simulator_cell_lock(env_cell_lock, nullptr, nullptr, env::Thermostat(), forces);
+    Integrator::StoermerVerletSpatialDecomp simulator_spatial(env_spatial, nullptr, nullptr, env::Thermostat(), forces);
+
+    simulator_sequential.simulate(0, 0.05, 0.0005);
+    simulator_cell_lock.simulate(0, 0.05, 0.0005);
+    simulator_spatial.simulate(0, 0.05, 0.0005);
+
+    for (size_t i = 0; i < env_sequential.size(); i++) {
+        for (int k = 0; k < 3; k++) {
+            EXPECT_NEAR(env_sequential[i].position[k], env_cell_lock[i].position[k], 1e-10);
+            EXPECT_NEAR(env_sequential[i].position[k], env_spatial[i].position[k], 1e-10);
+            EXPECT_NEAR(env_sequential[i].velocity[k], env_cell_lock[i].velocity[k], 1e-10);
+            EXPECT_NEAR(env_sequential[i].velocity[k], env_spatial[i].velocity[k], 1e-10);
+        }
+    }
+}
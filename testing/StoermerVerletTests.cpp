@@ -1,9 +1,16 @@
 #include <gtest/gtest.h>
 
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <unistd.h>
+
 #include "../src/core/IntegratorBase.h"
+#include "core/PerformanceBaseline.h"
 #include "core/StoermerVerlet/StoermerVerlet.h"
 #include "../src/env/Environment.h"
 #include "../src/env/Force.h"
+#include "utils/ArrayUtils.h"
 
 // Check correctness of updated values after performing a single simulation step
 TEST(StoermerVerletTest, stoermer_verlet_test) {
@@ -123,3 +130,418 @@ TEST(StoermerVerletTest, stoermer_verlet_orbit_test_linked_cells) {
     EXPECT_NEAR(p.velocity[1], 0, 1e-3);
     EXPECT_EQ(p.velocity[2], 0);
 }
+
+// Check the percentiles and the warm-up exclusion of the step profiler
+TEST(StoermerVerletTest, step_profiler_test) {
+    using namespace std::chrono_literals;
+    md::core::StepProfiler profiler(2);
+
+    for (int i = 1; i <= 102; ++i) {
+        profiler.record_phase(md::core::Phase::PAIR_FORCES, i * 1ms);
+        profiler.end_step(i * 1ms, 10, 5);
+    }
+
+    EXPECT_EQ(profiler.measured_steps(), 100);
+    EXPECT_EQ(profiler.pair_candidates(), 500);
+
+    const auto step = profiler.step_summary();
+    EXPECT_NEAR(step.p50, 52, 1e-9);
+    EXPECT_NEAR(step.p95, 97, 1e-9);
+    EXPECT_NEAR(step.p99, 101, 1e-9);
+    EXPECT_NEAR(step.max, 102, 1e-9);
+    EXPECT_NEAR(profiler.phase_summary(md::core::Phase::PAIR_FORCES).total, step.total, 1e-9);
+    EXPECT_EQ(profiler.phase_summary(md::core::Phase::KICK).total, 0);
+
+    // 1000 updates in 5.25 s
+    EXPECT_NEAR(profiler.mups(), 1000 / 5.25 / 1e6, 1e-12);
+}
+
+// Check that a benchmark run writes a report covering all measured steps
+TEST(StoermerVerletTest, benchmark_report_test) {
+    md::env::Environment env;
+    md::env::Boundary boundary;
+    boundary.extent = {10, 10, 10};
+    boundary.origin = {0, 0, 0};
+    boundary.set_boundary_rule(md::env::BoundaryRule::OUTFLOW);
+    env.set_boundary(boundary);
+    env.add_particle({1, 1, 1}, {0, 0, 0}, 1, 0);
+    env.add_particle({2, 1, 1}, {0, 0, 0}, 1, 0);
+    env.add_particle({1, 2, 1}, {0, 0, 0}, 1, 0);
+    env.set_grid_constant(10);
+    env.set_force(md::env::InverseSquare(1e-6, 10), 0);
+    env.build();
+
+    const std::string report = (std::filesystem::temp_directory_path() / "benchmark_report_test").string();
+    md::Integrator::StoermerVerlet simulator(env);
+    simulator.benchmark(0, 1.5, 0.125, NEVER, 4, report);
+
+    std::ifstream json(report + ".json");
+    ASSERT_TRUE(json.is_open());
+    const std::string content((std::istreambuf_iterator<char>(json)), std::istreambuf_iterator<char>());
+    EXPECT_NE(content.find("\"measured_steps\": 8"), std::string::npos);
+    EXPECT_NE(content.find("\"pair_candidates\": 24"), std::string::npos);
+    EXPECT_NE(content.find("\"pair_forces\""), std::string::npos);
+
+    std::ifstream csv(report + ".csv");
+    ASSERT_TRUE(csv.is_open());
+    size_t lines = 0;
+    for (std::string line; std::getline(csv, line);) lines++;
+    EXPECT_EQ(lines, 2 + md::core::N_PHASES);
+
+    std::filesystem::remove(report + ".json");
+    std::filesystem::remove(report + ".csv");
+}
+
+// Check that hardware counters are reported, whether or not the system provides them
+TEST(StoermerVerletTest, benchmark_counters_report_test) {
+    md::env::Environment env;
+    md::env::Boundary boundary;
+    boundary.extent = {10, 10, 10};
+    boundary.origin = {0, 0, 0};
+    env.set_boundary(boundary);
+    env.add_particle({1, 1, 1}, {0, 0, 0}, 1, 0);
+    env.add_particle({2, 1, 1}, {0, 0, 0}, 1, 0);
+    env.set_grid_constant(10);
+    env.set_force(md::env::InverseSquare(1e-6, 10), 0);
+    env.build();
+
+    const std::string report = (std::filesystem::temp_directory_path() / "benchmark_counters_test").string();
+    md::Integrator::StoermerVerlet simulator(env);
+    simulator.benchmark(0, 0.5, 0.125, NEVER, 0, report, true);
+
+    std::ifstream json(report + ".json");
+    ASSERT_TRUE(json.is_open());
+    const std::string content((std::istreambuf_iterator<char>(json)), std::istreambuf_iterator<char>());
+    EXPECT_NE(content.find("\"counters\""), std::string::npos);
+    EXPECT_NE(content.find("\"ipc\""), std::string::npos);
+
+    std::ifstream csv(report + "_counters.csv");
+    ASSERT_TRUE(csv.is_open());
+    std::string header;
+    std::getline(csv, header);
+    EXPECT_EQ(header.rfind("phase,thread,cycles,instructions", 0), 0);
+
+    for (const auto* suffix : {".json", ".csv", "_counters.csv"}) std::filesystem::remove(report + suffix);
+}
+
+// Check that baselines survive a round trip and that only slowdowns beyond the threshold are regressions
+TEST(StoermerVerletTest, performance_baseline_test) {
+    using md::core::Phase;
+    md::core::ScenarioResult baseline;
+    baseline.scenario = "lj_fluid_3d";
+    baseline.size = "S";
+    baseline.threads = 4;
+    baseline.particles = 1728;
+    baseline.steps = 360;
+    baseline.mups = 2.5;
+    baseline.step_ms = 1;
+    baseline.phase_ms[static_cast<size_t>(Phase::PAIR_FORCES)] = 0.8;
+    baseline.phase_ms[static_cast<size_t>(Phase::DRIFT)] = 0.15;
+    baseline.phase_ms[static_cast<size_t>(Phase::THERMOSTAT)] = 0.005;
+
+    const std::string file = (std::filesystem::temp_directory_path() / "performance_baseline_test.csv").string();
+    md::core::write_baselines({baseline}, file);
+    const auto baselines = md::core::read_baselines(file);
+    std::filesystem::remove(file);
+    ASSERT_EQ(baselines.size(), 1);
+    EXPECT_EQ(md::core::baseline_key(baselines[0]), "lj_fluid_3d/S/0/4");
+    EXPECT_EQ(baselines[0].particles, 1728);
+    EXPECT_DOUBLE_EQ(baselines[0].mups, 2.5);
+    EXPECT_DOUBLE_EQ(baselines[0].phase_ms[static_cast<size_t>(Phase::PAIR_FORCES)], 0.8);
+
+    // within the threshold, the thermostat is below 1% of the step and ignored
+    md::core::ScenarioResult result = baseline;
+    result.mups = 2.3;
+    result.phase_ms[static_cast<size_t>(Phase::PAIR_FORCES)] = 0.85;
+    result.phase_ms[static_cast<size_t>(Phase::THERMOSTAT)] = 0.05;
+    EXPECT_TRUE(md::core::find_regressions(result, baselines[0], 0.1).empty());
+
+    result.mups = 2;
+    result.phase_ms[static_cast<size_t>(Phase::PAIR_FORCES)] = 1;
+    const auto regressions = md::core::find_regressions(result, baselines[0], 0.1);
+    ASSERT_EQ(regressions.size(), 2);
+    EXPECT_EQ(regressions[0].metric, "mups");
+    EXPECT_NEAR(regressions[0].change, -0.2, 1e-12);
+    EXPECT_EQ(regressions[1].metric, "pair_forces");
+    EXPECT_NEAR(regressions[1].change, 0.25, 1e-12);
+
+    // a missing file gives no baselines
+    EXPECT_TRUE(md::core::read_baselines(file).empty());
+}
+
+// Check that the live metrics of a run can be read from the shared memory segment until the simulator is destroyed
+TEST(StoermerVerletTest, live_metrics_test) {
+    md::env::Environment env;
+    md::env::Boundary boundary;
+    boundary.extent = {10, 10, 10};
+    boundary.origin = {0, 0, 0};
+    env.set_boundary(boundary);
+    env.add_particle({1, 1, 1}, {1, 0, 0}, 1, 0);
+    env.add_particle({2, 1, 1}, {0, 0, 0}, 1, 0);
+    env.add_particle({5, 5, 5}, {0, 0, 0}, 1, 0, md::env::Particle::STATIONARY);
+    env.set_grid_constant(10);
+    env.set_force(md::env::InverseSquare(1e-6, 10), 0);
+    env.build();
+
+    const std::string name = md::core::live_metrics_name(getpid()) + ".test";
+    {
+        md::Integrator::StoermerVerlet simulator(env);
+        ASSERT_TRUE(simulator.enable_live_metrics(name));
+        simulator.timed_run(0, 1, 0.125);
+
+        const md::core::LiveMetricsReader reader(name);
+        ASSERT_TRUE(reader.is_open());
+        EXPECT_EQ(reader.phase_name(static_cast<size_t>(md::core::Phase::PAIR_FORCES)), "pair_forces");
+
+        md::core::LiveMetricsData data;
+        ASSERT_TRUE(reader.read(data));
+        EXPECT_EQ(data.pid, getpid());
+        EXPECT_EQ(data.finished, 1);
+        EXPECT_EQ(data.step, 8);
+        EXPECT_EQ(data.total_steps, 8);
+        EXPECT_DOUBLE_EQ(data.time, 1);
+        EXPECT_EQ(data.alive, 2);
+        EXPECT_EQ(data.stationary, 1);
+        EXPECT_EQ(data.dead, 0);
+        EXPECT_GT(data.temperature, 0);
+    }
+    EXPECT_FALSE(md::core::LiveMetricsReader(name).is_open());
+}
+
+// Check that periodic compaction removes particles leaving through an outflow boundary without changing the others
+TEST(StoermerVerletTest, compaction_test) {
+    auto run = [](md::env::Environment& env, const unsigned int compact_freq) {
+        md::env::Boundary boundary;
+        boundary.extent = {10, 10, 10};
+        boundary.origin = {0, 0, 0};
+        boundary.set_boundary_rule(md::env::BoundaryRule::OUTFLOW);
+        env.set_boundary(boundary);
+        for (int i = 0; i < 5; i++) {
+            env.add_particle({1 + 2.0 * i, 5, i % 2 == 0 ? 5.0 : 7.0}, {i % 2 == 0 ? 0.0 : -5.0, 0, 0}, 1, 0);
+        }
+        env.set_grid_constant(1);
+        env.set_force(md::env::InverseSquare(1e-6, 1), 0);
+        env.build();
+
+        const std::vector gravity = {md::env::Gravity(-1, {0, 1, 0})};
+        md::Integrator::StoermerVerlet simulator(env, nullptr, nullptr, md::env::Thermostat(), gravity);
+        simulator.compact_storage(compact_freq, true);
+        simulator.simulate(0, 2.5, 0.01, 1000);
+    };
+
+    md::env::Environment reference;
+    md::env::Environment compacted;
+    run(reference, 0);
+    run(compacted, 10);
+
+    EXPECT_EQ(reference.size(md::env::Particle::DEAD), 2);
+    EXPECT_EQ(compacted.size(md::env::Particle::DEAD), 0);
+    EXPECT_EQ(compacted.removed_count(), 2);
+    for (const size_t id : {0, 2, 4}) {
+        ASSERT_TRUE(compacted.contains(id));
+        for (int i = 0; i < 3; i++) {
+            EXPECT_DOUBLE_EQ(compacted[id].position[i], reference[id].position[i]);
+            EXPECT_DOUBLE_EQ(compacted[id].velocity[i], reference[id].velocity[i]);
+        }
+    }
+    EXPECT_FALSE(compacted.contains(1));
+    EXPECT_FALSE(compacted.contains(3));
+}
+
+// Check that an inflow source inserts particles at its rate into the running simulation and that they are affected by
+// external forces
+TEST(StoermerVerletTest, inflow_test) {
+    md::env::Boundary boundary;
+    boundary.extent = {20, 20, 20};
+    boundary.origin = {0, 0, 0};
+    boundary.set_boundary_rule(md::env::BoundaryRule::OUTFLOW);
+
+    md::env::Environment env;
+    env.set_boundary(boundary);
+    env.add_particle({10, 10, 10}, {0, 0, 0}, 1, 0);
+    env.set_grid_constant(2);
+    env.set_force(md::env::InverseSquare(1e-6, 2), 0);
+    env.build();
+
+    const std::vector gravity = {md::env::Gravity(-1, {0, 1, 0})};
+    md::Integrator::StoermerVerlet simulator(env, nullptr, nullptr, md::env::Thermostat(), gravity);
+    // 25 particles per time unit during the first time unit, at least 1 apart, moving right
+    simulator.add_inflow(md::env::InflowSource(25, {1, 5, 5}, {2, 10, 10}, {1, 0, 0}, 0, 1, 0, 0, 1.005, 1));
+    simulator.simulate(0, 1.5, 0.01, 1000);
+
+    EXPECT_EQ(env.id_count(), 26);
+    EXPECT_EQ(env.size(md::env::Particle::ALIVE), 26);
+    for (size_t id = 1; id < env.id_count(); id++) {
+        // the particles move in parallel, so they keep their distances
+        EXPECT_GT(env[id].position[0], 1.5);
+        EXPECT_LT(env[id].velocity[1], 0);
+        EXPECT_NEAR(env[id].velocity[0], 1, 1e-3);
+        for (size_t other = 1; other < id; other++) {
+            EXPECT_GE(ArrayUtils::L2Norm(env[id].position - env[other].position), 1 - 1e-3);
+        }
+    }
+    EXPECT_NEAR(env[0].velocity[1], -1.5, 0.02);
+}
+
+// tests if r-RESPA matches Störmer-Verlet with the substep size
+TEST(StoermerVerletTest, respa_test) {
+    auto membrane = [](md::env::Environment& env, const double epsilon, const bool exclude_bonded) {
+        md::env::Boundary boundary;
+        boundary.extent = {10, 10, 10};
+        boundary.origin = {0, 0, 0};
+        boundary.set_boundary_rule(md::env::BoundaryRule::OUTFLOW);
+        env.set_boundary(boundary);
+        env.add_membrane({3, 3, 5}, {}, {4, 4, 1}, 1.2, 1, 500, 3, 0, exclude_bonded);
+        env.add_particle({4.8, 4.8, 6.2}, {0, 0, -1}, 1);
+        env.set_force(md::env::LennardJones(epsilon, 1, 2.5), 0);
+        env.build();
+    };
+
+    for (const bool exclude_bonded : {false, true}) {
+        for (const double epsilon : {0.0, 1.0}) {
+            md::env::Environment env_verlet;
+            md::env::Environment env_respa;
+            membrane(env_verlet, epsilon, exclude_bonded);
+            membrane(env_respa, epsilon, exclude_bonded);
+
+            md::Integrator::StoermerVerlet verlet(env_verlet);
+            md::Integrator::StoermerVerlet respa(env_respa);
+            respa.multiple_time_step(4);
+            verlet.simulate(0, 0.2, 0.0005);
+            respa.simulate(0, 0.2, 0.002);
+
+            // without pair forces, both schemes are the same
+            const double tolerance = epsilon == 0 ? 1e-10 : 1e-3;
+            for (size_t i = 0; i < env_verlet.size(); i++) {
+                for (int k = 0; k < 3; k++) {
+                    EXPECT_NEAR(env_verlet[i].position[k], env_respa[i].position[k], tolerance);
+                    EXPECT_NEAR(env_verlet[i].velocity[k], env_respa[i].velocity[k], 10 * tolerance);
+                }
+            }
+        }
+    }
+
+    // the only pair is bonded and excluded, so its Lennard-Jones force cancels in the slow stage and both schemes
+    // are the same again
+    auto dimer = [](md::env::Environment& env) {
+        md::env::Boundary boundary;
+        boundary.extent = {10, 10, 10};
+        boundary.origin = {0, 0, 0};
+        boundary.set_boundary_rule(md::env::BoundaryRule::OUTFLOW);
+        env.set_boundary(boundary);
+        env.add_particle({4.5, 5, 5}, {-1, 0, 0}, 1);
+        env.add_particle({5.5, 5, 5}, {1, 0, 0}, 1);
+        env.add_bond(0, 1, 500, 1, true);
+        env.set_force(md::env::LennardJones(1, 1, 2.5), 0);
+        env.build();
+    };
+    md::env::Environment env_verlet;
+    md::env::Environment env_respa;
+    dimer(env_verlet);
+    dimer(env_respa);
+
+    md::Integrator::StoermerVerlet verlet(env_verlet);
+    md::Integrator::StoermerVerlet respa(env_respa);
+    respa.multiple_time_step(4);
+    verlet.simulate(0, 0.2, 0.0005);
+    respa.simulate(0, 0.2, 0.002);
+
+    for (size_t i = 0; i < env_verlet.size(); i++) {
+        for (int k = 0; k < 3; k++) {
+            EXPECT_NEAR(env_verlet[i].position[k], env_respa[i].position[k], 1e-10);
+            EXPECT_NEAR(env_verlet[i].velocity[k], env_respa[i].velocity[k], 1e-9);
+        }
+    }
+}
+
+// tests if the 2D kernels give the same trajectories as the 3D kernels for a 2D simulation
+TEST(StoermerVerletTest, dimension_test) {
+    auto fluid = [](md::env::Environment& env) {
+        md::env::Boundary boundary;
+        boundary.extent = {12, 12, 1};
+        boundary.origin = {0, 0, 0};
+        boundary.set_boundary_rule(md::env::BoundaryRule::PERIODIC);
+        env.set_boundary(boundary);
+        env.add_cuboid({0.6, 0.6, 0.5}, {0.3, -0.2, 0}, {10, 10, 1}, 1.12, 1, 0, 0, md::env::Dimension::TWO);
+        env.set_force(md::env::LennardJones(1, 1, 3), 0);
+        env.set_dimension(md::env::Dimension::TWO);
+        env.build();
+    };
+
+    md::env::Environment env_2d;
+    md::env::Environment env_3d;
+    fluid(env_2d);
+    fluid(env_3d);
+    EXPECT_EQ(env_2d.dim(), 2);
+
+    md::Integrator::StoermerVerlet<2> simulator_2d(env_2d);
+    md::Integrator::StoermerVerlet simulator_3d(env_3d);
+    simulator_2d.simulate(0, 0.5, 0.0005);
+    simulator_3d.simulate(0, 0.5, 0.0005);
+
+    for (size_t i = 0; i < env_2d.size(); i++) {
+        for (int k = 0; k < 3; k++) {
+            EXPECT_NEAR(env_2d[i].position[k], env_3d[i].position[k], 1e-12);
+            EXPECT_NEAR(env_2d[i].velocity[k], env_3d[i].velocity[k], 1e-12);
+        }
+        EXPECT_EQ(env_2d[i].position[2], 0.5);
+    }
+}
+
+// tests if the direct sum of all pairs gives the same trajectories as the linked cells
+TEST(StoermerVerletTest, direct_sum_test) {
+    auto compare = [](const std::function<void(md::env::Environment&)>& setup, const double tolerance) {
+        md::env::Environment env_cells;
+        md::env::Environment env_direct;
+        md::env::Environment env_direct_parallel;
+        setup(env_cells);
+        setup(env_direct);
+        setup(env_direct_parallel);
+        EXPECT_TRUE(env_direct.direct_sum_suitable());
+
+        md::Integrator::StoermerVerlet simulator_cells(env_cells);
+        md::Integrator::StoermerVerlet simulator_direct(env_direct);
+        md::Integrator::StoermerVerlet simulator_direct_parallel(env_direct_parallel);
+        simulator_direct.direct_sum(false);
+        simulator_direct_parallel.direct_sum(true);
+        simulator_cells.simulate(0, 0.05, 0.0005);
+        simulator_direct.simulate(0, 0.05, 0.0005);
+        simulator_direct_parallel.simulate(0, 0.05, 0.0005);
+
+        for (size_t i = 0; i < env_cells.size(); i++) {
+            for (int k = 0; k < 3; k++) {
+                EXPECT_NEAR(env_cells[i].force[k], env_direct[i].force[k], tolerance);
+                EXPECT_NEAR(env_cells[i].position[k], env_direct[i].position[k], tolerance);
+                EXPECT_NEAR(env_direct[i].force[k], env_direct_parallel[i].force[k], tolerance);
+            }
+        }
+    };
+
+    // more particles than a tile and periodic boundaries, more than twice the cutoff wide
+    compare(
+        [](md::env::Environment& env) {
+            md::env::Boundary boundary;
+            boundary.extent = {9.3, 9.3, 9.3};
+            boundary.origin = {0, 0, 0};
+            boundary.set_boundary_rule(md::env::BoundaryRule::PERIODIC);
+            env.set_boundary(boundary);
+            env.add_cuboid({0.5, 0.5, 0.5}, {0.1, 0, -0.1}, {7, 7, 7}, 1.2, 1, 0, 0);
+            env.add_cuboid({1.1, 1.1, 1.1}, {}, {2, 2, 2}, 1.2, 2, 0, 1);
+            env.set_force(md::env::LennardJones(1, 1, 3), 0);
+            env.set_force(md::env::LennardJones(2, 0.9, 3), 1);
+            env.build();
+        },
+        1e-10);
+
+    // gravity without boundaries, the grid is a single cell
+    compare(
+        [](md::env::Environment& env) {
+            env.add_particle({0, 0, 0}, {0, 0, 0}, 1);
+            env.add_particle({0, 1, 0}, {-1, 0, 0}, 3.0e-6);
+            env.add_particle({0, 5.36, 0}, {-0.425, 0, 0}, 9.55e-4);
+            env.add_particle({34.75, 0, 0}, {0, 0.0296, 0}, 1.0e-14);
+            env.set_force(md::env::InverseSquare(1, 100), 0);
+            env.build();
+        },
+        1e-8);
+}
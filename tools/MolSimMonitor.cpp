@@ -0,0 +1,138 @@
+/**
+ * Companion of MolSim --live: polls the live metrics of a running simulation from shared memory and displays them.
+ *
+ * Usage: ./MolSimMonitor [name|pid] [--interval=<ms>] [--once]
+ */
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <signal.h>
+#include <string>
+#include <thread>
+
+#include "core/LiveMetrics.h"
+
+using namespace md;
+
+namespace {
+    /**
+     * @brief Returns the most recently created live metrics segment, empty if there is none. Shared memory segments
+     * are listed in /dev/shm on Linux only.
+     */
+    std::string find_segment() {
+        namespace fs = std::filesystem;
+        const std::string prefix = std::string(LIVE_METRICS_PREFIX).substr(1);
+
+        std::error_code error;
+        std::string newest;
+        fs::file_time_type newest_time{};
+        for (const auto& entry : fs::directory_iterator("/dev/shm", error)) {
+            const std::string file = entry.path().filename().string();
+            if (!file.starts_with(prefix)) continue;
+            const auto time = entry.last_write_time(error);
+            if (newest.empty() || time > newest_time) {
+                newest = "/" + file;
+                newest_time = time;
+            }
+        }
+        return newest;
+    }
+
+    /**
+     * @brief Prints a snapshot of the metrics.
+     * @param reader The reader of the segment, provides the phase names.
+     * @param data The metrics.
+     */
+    void print(const core::LiveMetricsReader& reader, const core::LiveMetricsData& data) {
+        const double progress = data.total_steps > 0 ? 100.0 * data.step / data.total_steps : 0;
+        double step_ms = 0;
+        for (const double ms : data.phase_ms) step_ms += ms;
+
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "MolSim (pid " << data.pid << ")" << (data.finished ? " finished" : "") << "\n";
+        std::cout << "Step:        " << data.step << " / " << data.total_steps << " (" << std::setprecision(1)
+                  << progress << "%)\n" << std::setprecision(3);
+        std::cout << "Time:        " << data.time << " / " << data.end_time << "\n";
+        std::cout << "Steps/s:     " << data.steps_per_second << "\n";
+        std::cout << "MUPS/s:      " << data.mups << "\n";
+        std::cout << "Temperature: " << data.temperature << "\n";
+        std::cout << "Particles:   " << data.alive << " alive, " << data.stationary << " stationary, " << data.dead
+                  << " dead\n";
+        std::cout << "Last step:   " << step_ms << " ms\n";
+        for (size_t i = 0; i < core::N_PHASES; ++i) {
+            const double share = step_ms > 0 ? 100.0 * data.phase_ms[i] / step_ms : 0;
+            std::cout << "  " << std::left << std::setw(16) << reader.phase_name(i) << std::right << std::setw(10)
+                      << data.phase_ms[i] << " ms " << std::setw(6) << std::setprecision(1) << share << "%\n"
+                      << std::setprecision(3);
+        }
+        std::cout.flush();
+    }
+}  // namespace
+
+int main(const int argc, char* argv[]) {
+    std::string name;
+    int interval_ms = 500;
+    bool once = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            std::cout << "Usage: " << argv[0] << " [name|pid] [--interval=<ms>] [--once]\n"
+                      << "Displays the live metrics of a simulation started with MolSim --live. Without name or pid, "
+                         "the most recent simulation is watched.\n";
+            return 0;
+        }
+        if (arg == "--once") {
+            once = true;
+        } else if (arg.starts_with("--interval=")) {
+            try {
+                interval_ms = std::max(1, std::stoi(arg.substr(11)));
+            } catch (const std::exception&) {
+                std::cerr << "Invalid interval: " << arg.substr(11) << std::endl;
+                return -1;
+            }
+        } else if (!arg.empty() &&
+                   std::all_of(arg.begin(), arg.end(), [](const unsigned char c) { return std::isdigit(c); })) {
+            name = core::live_metrics_name(std::stoll(arg));
+        } else {
+            name = arg.starts_with('/') ? arg : "/" + arg;
+        }
+    }
+
+    if (name.empty()) name = find_segment();
+    if (name.empty()) {
+        std::cerr << "No running simulation found, start MolSim with --live" << std::endl;
+        return -1;
+    }
+
+    // the simulation might still be initializing the segment
+    std::unique_ptr<core::LiveMetricsReader> reader;
+    for (int attempt = 0; attempt < 10; ++attempt) {
+        reader = std::make_unique<core::LiveMetricsReader>(name);
+        if (reader->is_open()) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    if (!reader->is_open()) {
+        std::cerr << "Could not open live metrics segment " << name << std::endl;
+        return -1;
+    }
+
+    core::LiveMetricsData data;
+    while (true) {
+        if (!reader->read(data)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        if (!once) std::cout << "\033[H\033[2J";
+        print(*reader, data);
+
+        // the segment stays mapped after the simulation removed it, so check whether the process is still running
+        if (once || data.finished || kill(static_cast<pid_t>(data.pid), 0) != 0) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+    }
+    return 0;
+}